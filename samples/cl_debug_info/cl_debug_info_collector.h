@@ -9,6 +9,7 @@
 
 #include <string.h>
 
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 #include <map>
@@ -18,6 +19,7 @@
 #include "cl_api_tracer.h"
 #include "cl_utils.h"
 #include "igc_binary_decoder.h"
+#include "line_info_index.h"
 #include "gen_symbols_decoder.h"
 
 #define CL_PROGRAM_DEBUG_INFO_SIZES_INTEL 0x4101
@@ -40,6 +42,7 @@ struct KernelDebugInfo {
   std::vector<Instruction> instruction_list;
   std::vector<LineInfo> line_info_list;
   std::vector<SourceFileInfo> source_info_list;
+  LineInfoIndex line_info_index;
 };
 
 using KernelDebugInfoMap = std::map<std::string, KernelDebugInfo>;
@@ -101,11 +104,8 @@ class ClDebugInfoCollector {
       kernel_debug_info.instruction_list;
     PTI_ASSERT(instruction_list.size() > 0);
 
-    int last_instruction_address = instruction_list.back().offset;
-
-    const std::vector<LineInfo>& line_info =
-      kernel_debug_info.line_info_list;
-    PTI_ASSERT(line_info.size() > 0);
+    const LineInfoIndex& line_info_index = kernel_debug_info.line_info_index;
+    PTI_ASSERT(!line_info_index.IsEmpty());
 
     const std::vector<SourceFileInfo>& source_info_list =
       kernel_debug_info.source_info_list;
@@ -114,27 +114,8 @@ class ClDebugInfoCollector {
     // Print instructions with no corresponding file
     std::cerr << "=== File: Unknown ===" << std::endl;
     for (auto& instruction : instruction_list) {
-      bool found = false;
-
-      for (size_t l = 0; l < line_info.size(); ++l) {
-        int start_address = line_info[l].address;
-        int end_address = (l + 1 < line_info.size()) ?
-                          line_info[l + 1].address :
-                          last_instruction_address;
-
-        if (instruction.offset >= start_address &&
-            instruction.offset < end_address) {
-          found = true;
-          break;
-        }
-      }
-
-      if (!found) {
-        std::cerr << "\t\t[" << "0x" << std::setw(5) <<
-          std::setfill('0') << std::hex << std::uppercase <<
-          instruction.offset << "] " << instruction.text;
-        callback(instruction.offset, callback_data);
-        std::cerr << std::endl;
+      if (line_info_index.LookupAddress(instruction.offset) == nullptr) {
+        PrintInstruction(instruction, callback, callback_data);
       }
     }
 
@@ -143,55 +124,23 @@ class ClDebugInfoCollector {
       std::cerr << "=== File: " << source_info.file_name.c_str() <<
         " ===" << std::endl;
 
-      const std::vector<SourceLine> line_list = source_info.source_line_list;
+      const std::vector<SourceLine>& line_list = source_info.source_line_list;
       PTI_ASSERT(line_list.size() > 0);
 
       // Print instructions with no corresponding source line
-      for (size_t l = 0; l < line_info.size(); ++l) {
-        if (line_info[l].line == 0) {
-          int start_address = line_info[l].address;
-          int end_address = (l + 1 < line_info.size()) ?
-                            line_info[l + 1].address :
-                            last_instruction_address;
-
-          for (auto instruction : instruction_list) {
-            if (instruction.offset >= start_address &&
-                instruction.offset < end_address &&
-                source_info.file_id == line_info[l].file) {
-              std::cerr << "\t\t[" << "0x" << std::setw(5) <<
-                std::setfill('0') << std::hex << std::uppercase <<
-                instruction.offset << "] " << instruction.text;
-              callback(instruction.offset, callback_data);
-              std::cerr << std::endl;
-            }
-          }
-        }
+      for (auto& range : line_info_index.RangesForLine(
+              source_info.file_id, 0)) {
+        PrintInstructions(instruction_list, range, callback, callback_data);
       }
 
       // Print instructions for corresponding source line
-      for (auto line : line_list) {
+      for (auto& line : line_list) {
         std::cerr << "[" << std::setw(5) << std::setfill(' ') << std::dec <<
           line.number << "] " << line.text << std::endl;
 
-        for (size_t l = 0; l < line_info.size(); ++l) {
-          if (line_info[l].line == line.number) {
-            int start_address = line_info[l].address;
-            int end_address = (l + 1 < line_info.size()) ?
-                              line_info[l + 1].address :
-                              last_instruction_address;
-
-            for (auto instruction : instruction_list) {
-              if (instruction.offset >= start_address &&
-                  instruction.offset < end_address &&
-                  source_info.file_id == line_info[l].file) {
-                std::cerr << "\t\t[" << "0x" << std::setw(5) <<
-                  std::setfill('0') << std::hex << std::uppercase <<
-                  instruction.offset << "] " << instruction.text;
-                callback(instruction.offset, callback_data);
-                std::cerr << std::endl;
-              }
-            }
-          }
+        for (auto& range : line_info_index.RangesForLine(
+                source_info.file_id, line.number)) {
+          PrintInstructions(instruction_list, range, callback, callback_data);
         }
       }
     }
@@ -200,6 +149,34 @@ class ClDebugInfoCollector {
   }
 
  private: // Implementation Details
+  static void PrintInstruction(
+      const Instruction& instruction,
+      decltype(InstructionCallback)* callback,
+      void* callback_data) {
+    std::cerr << "\t\t[" << "0x" << std::setw(5) <<
+      std::setfill('0') << std::hex << std::uppercase <<
+      instruction.offset << "] " << instruction.text;
+    callback(instruction.offset, callback_data);
+    std::cerr << std::endl;
+  }
+
+  // Instructions are sorted by offset, so ones in range are contiguous
+  static void PrintInstructions(
+      const std::vector<Instruction>& instruction_list,
+      const AddressRange& range,
+      decltype(InstructionCallback)* callback,
+      void* callback_data) {
+    auto it = std::lower_bound(
+        instruction_list.begin(), instruction_list.end(), range.start,
+        [](const Instruction& instruction, uint64_t address) {
+          return static_cast<uint64_t>(instruction.offset) < address;
+        });
+    for (; it != instruction_list.end() &&
+           static_cast<uint64_t>(it->offset) < range.end; ++it) {
+      PrintInstruction(*it, callback, callback_data);
+    }
+  }
+
   ClDebugInfoCollector(cl_device_id device) : device_(device) {
     PTI_ASSERT(device_ != nullptr);
   }
@@ -226,10 +203,18 @@ class ClDebugInfoCollector {
     PTI_ASSERT(line_info_list.size() > 0);
     PTI_ASSERT(source_info_list.size() > 0);
 
+    PTI_ASSERT(std::is_sorted(
+        instruction_list.begin(), instruction_list.end(),
+        [](const Instruction& left, const Instruction& right) {
+          return left.offset < right.offset;
+        }));
+    LineInfoIndex line_info_index(
+        line_info_list, instruction_list.back().offset);
+
     const std::lock_guard<std::mutex> lock(lock_);
     PTI_ASSERT(kernel_debug_info_map_.count(name) == 0);
-    kernel_debug_info_map_[name] =
-      {instruction_list, line_info_list, source_info_list};
+    kernel_debug_info_map_[name] = {instruction_list, line_info_list,
+                                    source_info_list, line_info_index};
   }
 
   static std::vector<SourceLine> GetSource(cl_kernel kernel) {
@@ -441,9 +426,7 @@ class ClDebugInfoCollector {
       return;
     }
 
-    PTI_ASSERT(binary.size() < (std::numeric_limits<uint32_t>::max)());
-    ElfParser elf_parser(
-        binary.data(), static_cast<uint32_t>(binary.size()));
+    ElfParser elf_parser(binary.data(), binary.size());
     std::vector<uint8_t> igc_binary = elf_parser.GetGenBinary();
     if (igc_binary.size() == 0) {
       std::cerr << "[WARNING] Unable to get GEN binary" << std::endl;
@@ -101,6 +101,24 @@ class ClMetricCollector {
     return cpu_timestamp;
   }
 
+  // Converts the list in place using a single clock snapshot
+  void GetKernelTimestamps(std::vector<uint64_t>& timestamp_list) const {
+    md::TCompletionCode status = md::CC_OK;
+    uint64_t gpu_snap_point = 0, cpu_snap_point = 0;
+
+    const MetricDevice& device = *device_;
+    status = device->GetGpuCpuTimestamps(
+        &gpu_snap_point, &cpu_snap_point, nullptr);
+    PTI_ASSERT(status == md::CC_OK);
+
+#if defined(__gnu_linux__)
+    cpu_snap_point = utils::ConvertClockMonotonicToRaw(cpu_snap_point);
+#endif
+    for (auto& timestamp : timestamp_list) {
+      timestamp = cpu_snap_point - (gpu_snap_point - timestamp);
+    }
+  }
+
   int GetMetricId(const char* name) const {
     PTI_ASSERT(name != nullptr);
     PTI_ASSERT(set_ != nullptr);
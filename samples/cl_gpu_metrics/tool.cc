@@ -4,12 +4,15 @@
 // SPDX-License-Identifier: MIT
 // =============================================================
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <set>
+#include <thread>
 
 #include "cl_metric_collector.h"
 #include "cl_kernel_collector.h"
+#include "interval_join.h"
 
 struct Kernel {
   uint64_t total_time;
@@ -72,6 +75,35 @@ void SetToolEnv() {}
 
 // Internal Tool Functionality ////////////////////////////////////////////////
 
+static void AddKernelMetrics(
+    KernelMap& kernel_map, const ClKernelInterval& kernel,
+    uint32_t sample_count, float eu_active, float eu_stall) {
+  const std::string& name = utils::GetInternedString(kernel.name_id);
+
+  if (sample_count > 0) {
+    eu_active /= sample_count;
+    eu_stall /= sample_count;
+  } else {
+    std::cerr << "[WARNING] No samples found for a kernel instance of " <<
+      name << ", results may be inaccurate" << std::endl;
+  }
+
+  if (kernel_map.count(name) == 0) {
+    kernel_map[name] =
+      {kernel.end - kernel.start, 1, eu_active, eu_stall};
+  } else {
+    Kernel& kernel_info = kernel_map[name];
+    kernel_info.total_time += (kernel.end - kernel.start);
+    kernel_info.eu_active =
+      (kernel_info.eu_active * kernel_info.call_count + eu_active) /
+      (kernel_info.call_count + 1);
+    kernel_info.eu_stall =
+      (kernel_info.eu_stall * kernel_info.call_count + eu_stall) /
+      (kernel_info.call_count + 1);
+    kernel_info.call_count += 1;
+  }
+}
+
 static KernelMap GetKernelMap() {
   PTI_ASSERT(kernel_collector != nullptr);
   PTI_ASSERT(metric_collector != nullptr);
@@ -100,54 +132,41 @@ static KernelMap GetKernelMap() {
   uint32_t report_size = metric_collector->GetReportSize();
   PTI_ASSERT(report_size > 0);
 
-  for (auto& kernel : kernel_interval_list) {
-    uint32_t sample_count = 0;
-    float eu_active = 0.0f, eu_stall = 0.0f;
-
-    const md::TTypedValue_1_0* report = report_list.data();
-    while (report < report_list.data() + report_list.size()) {
-      PTI_ASSERT(report[gpu_timestamp_id].ValueType == md::VALUE_TYPE_UINT64);
-      uint64_t report_timestamp =
-        metric_collector->GetKernelTimestamp(
-            report[gpu_timestamp_id].ValueUInt64);
-
-      if (report_timestamp >= kernel.start && report_timestamp <= kernel.end) {
-        PTI_ASSERT(report[eu_active_id].ValueType == md::VALUE_TYPE_FLOAT);
-        eu_active += report[eu_active_id].ValueFloat;
-        PTI_ASSERT(report[eu_stall_id].ValueType == md::VALUE_TYPE_FLOAT);
-        eu_stall += report[eu_stall_id].ValueFloat;
-        ++sample_count;
-      }
-
-      if (report_timestamp > kernel.end) {
-        break;
-      }
-
-      report += report_size;
-    }
+  size_t report_count = report_list.size() / report_size;
+
+  // Timestamps and prefix sums of metric values, so any kernel gets its
+  // samples aggregated in constant time
+  std::vector<uint64_t> timestamp_list(report_count);
+  std::vector<double> eu_active_sum(report_count + 1, 0.0);
+  std::vector<double> eu_stall_sum(report_count + 1, 0.0);
+  for (size_t i = 0; i < report_count; ++i) {
+    const md::TTypedValue_1_0* report = report_list.data() + i * report_size;
+    PTI_ASSERT(report[gpu_timestamp_id].ValueType == md::VALUE_TYPE_UINT64);
+    timestamp_list[i] = report[gpu_timestamp_id].ValueUInt64;
+    PTI_ASSERT(report[eu_active_id].ValueType == md::VALUE_TYPE_FLOAT);
+    eu_active_sum[i + 1] = eu_active_sum[i] + report[eu_active_id].ValueFloat;
+    PTI_ASSERT(report[eu_stall_id].ValueType == md::VALUE_TYPE_FLOAT);
+    eu_stall_sum[i + 1] = eu_stall_sum[i] + report[eu_stall_id].ValueFloat;
+  }
+  metric_collector->GetKernelTimestamps(timestamp_list);
 
-    if (sample_count > 0) {
-      eu_active /= sample_count;
-      eu_stall /= sample_count;
-    } else {
-      std::cerr << "[WARNING] No samples found for a kernel instance of " <<
-        kernel.name << ", results may be inaccurate" << std::endl;
-    }
+  std::vector<utils::TimeInterval> interval_list;
+  interval_list.reserve(kernel_interval_list.size());
+  for (auto& kernel : kernel_interval_list) {
+    interval_list.push_back({kernel.start, kernel.end});
+  }
 
-    if (kernel_map.count(kernel.name) == 0) {
-      kernel_map[kernel.name] =
-        {kernel.end - kernel.start, 1, eu_active, eu_stall};
-    } else {
-      Kernel& kernel_info = kernel_map[kernel.name];
-      kernel_info.total_time += (kernel.end - kernel.start);
-      kernel_info.eu_active =
-        (kernel_info.eu_active * kernel_info.call_count + eu_active) /
-        (kernel_info.call_count + 1);
-      kernel_info.eu_stall =
-        (kernel_info.eu_stall * kernel_info.call_count + eu_stall) /
-        (kernel_info.call_count + 1);
-      kernel_info.call_count += 1;
-    }
+  std::vector<utils::SampleRange> range_list = utils::JoinIntervals(
+      timestamp_list, interval_list,
+      std::max(std::thread::hardware_concurrency(), 1u));
+  PTI_ASSERT(range_list.size() == kernel_interval_list.size());
+
+  for (size_t i = 0; i < kernel_interval_list.size(); ++i) {
+    const utils::SampleRange& range = range_list[i];
+    AddKernelMetrics(
+        kernel_map, kernel_interval_list[i], range.last - range.first,
+        eu_active_sum[range.last] - eu_active_sum[range.first],
+        eu_stall_sum[range.last] - eu_stall_sum[range.first]);
   }
 
   return kernel_map;
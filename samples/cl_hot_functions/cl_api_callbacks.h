@@ -7,7 +7,7 @@
 #ifndef PTI_SAMPLES_CL_HOT_FUNCTIONS_CL_API_CALLBACKS_H_
 #define PTI_SAMPLES_CL_HOT_FUNCTIONS_CL_API_CALLBACKS_H_
 
-#include <sstream>
+#include "call_logger.h"
 
 static thread_local cl_int current_error = CL_SUCCESS;
 
@@ -148,8 +148,8 @@ static void clGetSupportedImageFormatsOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clGetSupportedImageFormats:";
 
   stream << " context = " << *(params->context);
   stream << " flags = " << *(params->flags);
@@ -159,13 +159,13 @@ static void clGetSupportedImageFormatsOnEnter(
   stream << " numImageFormats = " << *(params->numImageFormats);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetSupportedImageFormatsOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clGetSupportedImageFormats";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -175,7 +175,7 @@ static void clGetSupportedImageFormatsOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetKernelInfoOnEnter(
@@ -185,8 +185,8 @@ static void clGetKernelInfoOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clGetKernelInfo:";
 
   stream << " kernel = " << *(params->kernel);
   stream << " paramName = " << *(params->paramName);
@@ -195,13 +195,13 @@ static void clGetKernelInfoOnEnter(
   stream << " paramValueSizeRet = " << *(params->paramValueSizeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetKernelInfoOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clGetKernelInfo";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -211,7 +211,7 @@ static void clGetKernelInfoOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clCompileProgramOnEnter(
@@ -221,8 +221,8 @@ static void clCompileProgramOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clCompileProgram:";
 
   stream << " program = " << *(params->program);
   stream << " numDevices = " << *(params->numDevices);
@@ -241,13 +241,13 @@ static void clCompileProgramOnEnter(
   stream << " userData = " << *(params->userData);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clCompileProgramOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clCompileProgram";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -257,7 +257,7 @@ static void clCompileProgramOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clSetEventCallbackOnEnter(
@@ -267,8 +267,8 @@ static void clSetEventCallbackOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clSetEventCallback:";
 
   stream << " event = " << *(params->event);
   stream << " commandExecCallbackType = " <<
@@ -277,13 +277,13 @@ static void clSetEventCallbackOnEnter(
   stream << " userData = " << *(params->userData);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clSetEventCallbackOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clSetEventCallback";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -293,7 +293,7 @@ static void clSetEventCallbackOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clUnloadPlatformCompilerOnEnter(
@@ -303,19 +303,19 @@ static void clUnloadPlatformCompilerOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clUnloadPlatformCompiler:";
 
   stream << " platform = " << *(params->platform);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clUnloadPlatformCompilerOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clUnloadPlatformCompiler";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -325,7 +325,7 @@ static void clUnloadPlatformCompilerOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetPlatformIDsOnEnter(
@@ -335,21 +335,21 @@ static void clGetPlatformIDsOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clGetPlatformIDs:";
 
   stream << " numEntries = " << *(params->numEntries);
   stream << " platforms = " << *(params->platforms);
   stream << " numPlatforms = " << *(params->numPlatforms);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetPlatformIDsOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clGetPlatformIDs";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -359,7 +359,7 @@ static void clGetPlatformIDsOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clUnloadCompilerOnEnter(
@@ -369,18 +369,18 @@ static void clUnloadCompilerOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clUnloadCompiler:";
 
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clUnloadCompilerOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clUnloadCompiler";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -390,7 +390,7 @@ static void clUnloadCompilerOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueBarrierWithWaitListOnEnter(
@@ -400,8 +400,8 @@ static void clEnqueueBarrierWithWaitListOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clEnqueueBarrierWithWaitList:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << " numEventsInWaitList = " << *(params->numEventsInWaitList);
@@ -409,13 +409,13 @@ static void clEnqueueBarrierWithWaitListOnEnter(
   stream << " event = " << *(params->event);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueBarrierWithWaitListOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clEnqueueBarrierWithWaitList";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -425,7 +425,7 @@ static void clEnqueueBarrierWithWaitListOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueMapBufferOnEnter(
@@ -435,8 +435,8 @@ static void clEnqueueMapBufferOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clEnqueueMapBuffer:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << " buffer = " << *(params->buffer);
@@ -450,7 +450,7 @@ static void clEnqueueMapBufferOnEnter(
   stream << " errcodeRet = " << *(params->errcodeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 
   if (*(params->errcodeRet) == nullptr) {
     *(params->errcodeRet) = &current_error;
@@ -459,8 +459,8 @@ static void clEnqueueMapBufferOnEnter(
 
 static void clEnqueueMapBufferOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clEnqueueMapBuffer";
   stream << " [" << (end - start) << " ns]";
 
   const cl_params_clEnqueueMapBuffer* params =
@@ -478,7 +478,7 @@ static void clEnqueueMapBufferOnExit(
   stream << " (" << **(params->errcodeRet) << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clCreateImage3DOnEnter(
@@ -488,8 +488,8 @@ static void clCreateImage3DOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clCreateImage3D:";
 
   stream << " context = " << *(params->context);
   stream << " flags = " << *(params->flags);
@@ -503,7 +503,7 @@ static void clCreateImage3DOnEnter(
   stream << " errcodeRet = " << *(params->errcodeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 
   if (*(params->errcodeRet) == nullptr) {
     *(params->errcodeRet) = &current_error;
@@ -512,8 +512,8 @@ static void clCreateImage3DOnEnter(
 
 static void clCreateImage3DOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clCreateImage3D";
   stream << " [" << (end - start) << " ns]";
 
   const cl_params_clCreateImage3D* params =
@@ -531,7 +531,7 @@ static void clCreateImage3DOnExit(
   stream << " (" << **(params->errcodeRet) << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetKernelArgInfoOnEnter(
@@ -541,8 +541,8 @@ static void clGetKernelArgInfoOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clGetKernelArgInfo:";
 
   stream << " kernel = " << *(params->kernel);
   stream << " argIndx = " << *(params->argIndx);
@@ -552,13 +552,13 @@ static void clGetKernelArgInfoOnEnter(
   stream << " paramValueSizeRet = " << *(params->paramValueSizeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetKernelArgInfoOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clGetKernelArgInfo";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -568,7 +568,7 @@ static void clGetKernelArgInfoOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueSVMFreeOnEnter(
@@ -578,8 +578,8 @@ static void clEnqueueSVMFreeOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clEnqueueSVMFree:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << " numSvmPointers = " << *(params->numSvmPointers);
@@ -591,13 +591,13 @@ static void clEnqueueSVMFreeOnEnter(
   stream << " event = " << *(params->event);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueSVMFreeOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clEnqueueSVMFree";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -607,7 +607,7 @@ static void clEnqueueSVMFreeOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueCopyImageToBufferOnEnter(
@@ -617,8 +617,8 @@ static void clEnqueueCopyImageToBufferOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clEnqueueCopyImageToBuffer:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << " srcImage = " << *(params->srcImage);
@@ -631,13 +631,13 @@ static void clEnqueueCopyImageToBufferOnEnter(
   stream << " event = " << *(params->event);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueCopyImageToBufferOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clEnqueueCopyImageToBuffer";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -647,7 +647,7 @@ static void clEnqueueCopyImageToBufferOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetContextInfoOnEnter(
@@ -657,8 +657,8 @@ static void clGetContextInfoOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clGetContextInfo:";
 
   stream << " context = " << *(params->context);
   stream << " paramName = " << *(params->paramName);
@@ -667,13 +667,13 @@ static void clGetContextInfoOnEnter(
   stream << " paramValueSizeRet = " << *(params->paramValueSizeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetContextInfoOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clGetContextInfo";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -683,7 +683,7 @@ static void clGetContextInfoOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clRetainCommandQueueOnEnter(
@@ -693,19 +693,19 @@ static void clRetainCommandQueueOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clRetainCommandQueue:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clRetainCommandQueueOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clRetainCommandQueue";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -715,7 +715,7 @@ static void clRetainCommandQueueOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueWriteImageOnEnter(
@@ -725,8 +725,8 @@ static void clEnqueueWriteImageOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clEnqueueWriteImage:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << " image = " << *(params->image);
@@ -741,13 +741,13 @@ static void clEnqueueWriteImageOnEnter(
   stream << " event = " << *(params->event);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueWriteImageOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clEnqueueWriteImage";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -757,7 +757,7 @@ static void clEnqueueWriteImageOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueWaitForEventsOnEnter(
@@ -767,21 +767,21 @@ static void clEnqueueWaitForEventsOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clEnqueueWaitForEvents:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << " numEvents = " << *(params->numEvents);
   stream << " eventList = " << *(params->eventList);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueWaitForEventsOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clEnqueueWaitForEvents";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -791,7 +791,7 @@ static void clEnqueueWaitForEventsOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueSVMUnmapOnEnter(
@@ -801,8 +801,8 @@ static void clEnqueueSVMUnmapOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clEnqueueSVMUnmap:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << " svmPtr = " << *(params->svmPtr);
@@ -811,13 +811,13 @@ static void clEnqueueSVMUnmapOnEnter(
   stream << " event = " << *(params->event);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueSVMUnmapOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clEnqueueSVMUnmap";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -827,7 +827,7 @@ static void clEnqueueSVMUnmapOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clCreateProgramWithBinaryOnEnter(
@@ -837,8 +837,8 @@ static void clCreateProgramWithBinaryOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clCreateProgramWithBinary:";
 
   stream << " context = " << *(params->context);
   stream << " numDevices = " << *(params->numDevices);
@@ -849,7 +849,7 @@ static void clCreateProgramWithBinaryOnEnter(
   stream << " errcodeRet = " << *(params->errcodeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 
   if (*(params->errcodeRet) == nullptr) {
     *(params->errcodeRet) = &current_error;
@@ -858,8 +858,8 @@ static void clCreateProgramWithBinaryOnEnter(
 
 static void clCreateProgramWithBinaryOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clCreateProgramWithBinary";
   stream << " [" << (end - start) << " ns]";
 
   const cl_params_clCreateProgramWithBinary* params =
@@ -877,7 +877,7 @@ static void clCreateProgramWithBinaryOnExit(
   stream << " (" << **(params->errcodeRet) << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueFillImageOnEnter(
@@ -887,8 +887,8 @@ static void clEnqueueFillImageOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clEnqueueFillImage:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << " image = " << *(params->image);
@@ -900,13 +900,13 @@ static void clEnqueueFillImageOnEnter(
   stream << " event = " << *(params->event);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueFillImageOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clEnqueueFillImage";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -916,7 +916,7 @@ static void clEnqueueFillImageOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clCreateFromGLTexture2DOnEnter(
@@ -926,8 +926,8 @@ static void clCreateFromGLTexture2DOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clCreateFromGLTexture2D:";
 
   stream << " context = " << *(params->context);
   stream << " flags = " << *(params->flags);
@@ -937,7 +937,7 @@ static void clCreateFromGLTexture2DOnEnter(
   stream << " errcodeRet = " << *(params->errcodeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 
   if (*(params->errcodeRet) == nullptr) {
     *(params->errcodeRet) = &current_error;
@@ -946,8 +946,8 @@ static void clCreateFromGLTexture2DOnEnter(
 
 static void clCreateFromGLTexture2DOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clCreateFromGLTexture2D";
   stream << " [" << (end - start) << " ns]";
 
   const cl_params_clCreateFromGLTexture2D* params =
@@ -965,7 +965,7 @@ static void clCreateFromGLTexture2DOnExit(
   stream << " (" << **(params->errcodeRet) << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clSetKernelExecInfoOnEnter(
@@ -975,8 +975,8 @@ static void clSetKernelExecInfoOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clSetKernelExecInfo:";
 
   stream << " kernel = " << *(params->kernel);
   stream << " paramName = " << *(params->paramName);
@@ -984,13 +984,13 @@ static void clSetKernelExecInfoOnEnter(
   stream << " paramValue = " << *(params->paramValue);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clSetKernelExecInfoOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clSetKernelExecInfo";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -1000,7 +1000,7 @@ static void clSetKernelExecInfoOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueReleaseGLObjectsOnEnter(
@@ -1010,8 +1010,8 @@ static void clEnqueueReleaseGLObjectsOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clEnqueueReleaseGLObjects:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << " numObjects = " << *(params->numObjects);
@@ -1021,13 +1021,13 @@ static void clEnqueueReleaseGLObjectsOnEnter(
   stream << " event = " << *(params->event);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueReleaseGLObjectsOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clEnqueueReleaseGLObjects";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -1037,7 +1037,7 @@ static void clEnqueueReleaseGLObjectsOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetDeviceIDsOnEnter(
@@ -1047,8 +1047,8 @@ static void clGetDeviceIDsOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clGetDeviceIDs:";
 
   stream << " platform = " << *(params->platform);
   stream << " deviceType = " << *(params->deviceType);
@@ -1057,13 +1057,13 @@ static void clGetDeviceIDsOnEnter(
   stream << " numDevices = " << *(params->numDevices);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetDeviceIDsOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clGetDeviceIDs";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -1073,7 +1073,7 @@ static void clGetDeviceIDsOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clReleaseMemObjectOnEnter(
@@ -1083,19 +1083,19 @@ static void clReleaseMemObjectOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clReleaseMemObject:";
 
   stream << " memobj = " << *(params->memobj);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clReleaseMemObjectOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clReleaseMemObject";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -1105,7 +1105,7 @@ static void clReleaseMemObjectOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetGLObjectInfoOnEnter(
@@ -1115,21 +1115,21 @@ static void clGetGLObjectInfoOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clGetGLObjectInfo:";
 
   stream << " memobj = " << *(params->memobj);
   stream << " glObjectType = " << *(params->glObjectType);
   stream << " glObjectName = " << *(params->glObjectName);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetGLObjectInfoOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clGetGLObjectInfo";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -1139,7 +1139,7 @@ static void clGetGLObjectInfoOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clCreateFromGLRenderbufferOnEnter(
@@ -1149,8 +1149,8 @@ static void clCreateFromGLRenderbufferOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clCreateFromGLRenderbuffer:";
 
   stream << " context = " << *(params->context);
   stream << " flags = " << *(params->flags);
@@ -1158,7 +1158,7 @@ static void clCreateFromGLRenderbufferOnEnter(
   stream << " errcodeRet = " << *(params->errcodeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 
   if (*(params->errcodeRet) == nullptr) {
     *(params->errcodeRet) = &current_error;
@@ -1167,8 +1167,8 @@ static void clCreateFromGLRenderbufferOnEnter(
 
 static void clCreateFromGLRenderbufferOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clCreateFromGLRenderbuffer";
   stream << " [" << (end - start) << " ns]";
 
   const cl_params_clCreateFromGLRenderbuffer* params =
@@ -1186,7 +1186,7 @@ static void clCreateFromGLRenderbufferOnExit(
   stream << " (" << **(params->errcodeRet) << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clReleaseContextOnEnter(
@@ -1196,19 +1196,19 @@ static void clReleaseContextOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clReleaseContext:";
 
   stream << " context = " << *(params->context);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clReleaseContextOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clReleaseContext";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -1218,7 +1218,7 @@ static void clReleaseContextOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueUnmapMemObjectOnEnter(
@@ -1228,8 +1228,8 @@ static void clEnqueueUnmapMemObjectOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clEnqueueUnmapMemObject:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << " memobj = " << *(params->memobj);
@@ -1239,13 +1239,13 @@ static void clEnqueueUnmapMemObjectOnEnter(
   stream << " event = " << *(params->event);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueUnmapMemObjectOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clEnqueueUnmapMemObject";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -1255,7 +1255,7 @@ static void clEnqueueUnmapMemObjectOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clCreateContextOnEnter(
@@ -1265,8 +1265,8 @@ static void clCreateContextOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clCreateContext:";
 
   stream << " properties = " << *(params->properties);
   stream << " numDevices = " << *(params->numDevices);
@@ -1276,7 +1276,7 @@ static void clCreateContextOnEnter(
   stream << " errcodeRet = " << *(params->errcodeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 
   if (*(params->errcodeRet) == nullptr) {
     *(params->errcodeRet) = &current_error;
@@ -1285,8 +1285,8 @@ static void clCreateContextOnEnter(
 
 static void clCreateContextOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clCreateContext";
   stream << " [" << (end - start) << " ns]";
 
   const cl_params_clCreateContext* params =
@@ -1304,7 +1304,7 @@ static void clCreateContextOnExit(
   stream << " (" << **(params->errcodeRet) << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetHostTimerOnEnter(
@@ -1314,20 +1314,20 @@ static void clGetHostTimerOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clGetHostTimer:";
 
   stream << " device = " << *(params->device);
   stream << " hostTimestamp = " << *(params->hostTimestamp);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetHostTimerOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clGetHostTimer";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -1337,7 +1337,7 @@ static void clGetHostTimerOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetPipeInfoOnEnter(
@@ -1347,8 +1347,8 @@ static void clGetPipeInfoOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clGetPipeInfo:";
 
   stream << " pipe = " << *(params->pipe);
   stream << " paramName = " << *(params->paramName);
@@ -1357,13 +1357,13 @@ static void clGetPipeInfoOnEnter(
   stream << " paramValueSizeRet = " << *(params->paramValueSizeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetPipeInfoOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clGetPipeInfo";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -1373,7 +1373,7 @@ static void clGetPipeInfoOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueAcquireGLObjectsOnEnter(
@@ -1383,8 +1383,8 @@ static void clEnqueueAcquireGLObjectsOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clEnqueueAcquireGLObjects:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << " numObjects = " << *(params->numObjects);
@@ -1394,13 +1394,13 @@ static void clEnqueueAcquireGLObjectsOnEnter(
   stream << " event = " << *(params->event);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueAcquireGLObjectsOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clEnqueueAcquireGLObjects";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -1410,7 +1410,7 @@ static void clEnqueueAcquireGLObjectsOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetKernelWorkGroupInfoOnEnter(
@@ -1420,8 +1420,8 @@ static void clGetKernelWorkGroupInfoOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clGetKernelWorkGroupInfo:";
 
   stream << " kernel = " << *(params->kernel);
   stream << " device = " << *(params->device);
@@ -1431,13 +1431,13 @@ static void clGetKernelWorkGroupInfoOnEnter(
   stream << " paramValueSizeRet = " << *(params->paramValueSizeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetKernelWorkGroupInfoOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clGetKernelWorkGroupInfo";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -1447,7 +1447,7 @@ static void clGetKernelWorkGroupInfoOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clCreateImage2DOnEnter(
@@ -1457,8 +1457,8 @@ static void clCreateImage2DOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clCreateImage2D:";
 
   stream << " context = " << *(params->context);
   stream << " flags = " << *(params->flags);
@@ -1470,7 +1470,7 @@ static void clCreateImage2DOnEnter(
   stream << " errcodeRet = " << *(params->errcodeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 
   if (*(params->errcodeRet) == nullptr) {
     *(params->errcodeRet) = &current_error;
@@ -1479,8 +1479,8 @@ static void clCreateImage2DOnEnter(
 
 static void clCreateImage2DOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clCreateImage2D";
   stream << " [" << (end - start) << " ns]";
 
   const cl_params_clCreateImage2D* params =
@@ -1498,7 +1498,7 @@ static void clCreateImage2DOnExit(
   stream << " (" << **(params->errcodeRet) << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clCreateContextFromTypeOnEnter(
@@ -1508,8 +1508,8 @@ static void clCreateContextFromTypeOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clCreateContextFromType:";
 
   stream << " properties = " << *(params->properties);
   stream << " deviceType = " << *(params->deviceType);
@@ -1518,7 +1518,7 @@ static void clCreateContextFromTypeOnEnter(
   stream << " errcodeRet = " << *(params->errcodeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 
   if (*(params->errcodeRet) == nullptr) {
     *(params->errcodeRet) = &current_error;
@@ -1527,8 +1527,8 @@ static void clCreateContextFromTypeOnEnter(
 
 static void clCreateContextFromTypeOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clCreateContextFromType";
   stream << " [" << (end - start) << " ns]";
 
   const cl_params_clCreateContextFromType* params =
@@ -1546,7 +1546,7 @@ static void clCreateContextFromTypeOnExit(
   stream << " (" << **(params->errcodeRet) << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clRetainProgramOnEnter(
@@ -1556,19 +1556,19 @@ static void clRetainProgramOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clRetainProgram:";
 
   stream << " program = " << *(params->program);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clRetainProgramOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clRetainProgram";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -1578,7 +1578,7 @@ static void clRetainProgramOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clCreateProgramWithSourceOnEnter(
@@ -1588,8 +1588,8 @@ static void clCreateProgramWithSourceOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clCreateProgramWithSource:";
 
   stream << " context = " << *(params->context);
   stream << " count = " << *(params->count);
@@ -1598,7 +1598,7 @@ static void clCreateProgramWithSourceOnEnter(
   stream << " errcodeRet = " << *(params->errcodeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 
   if (*(params->errcodeRet) == nullptr) {
     *(params->errcodeRet) = &current_error;
@@ -1607,8 +1607,8 @@ static void clCreateProgramWithSourceOnEnter(
 
 static void clCreateProgramWithSourceOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clCreateProgramWithSource";
   stream << " [" << (end - start) << " ns]";
 
   const cl_params_clCreateProgramWithSource* params =
@@ -1626,7 +1626,7 @@ static void clCreateProgramWithSourceOnExit(
   stream << " (" << **(params->errcodeRet) << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetMemObjectInfoOnEnter(
@@ -1636,8 +1636,8 @@ static void clGetMemObjectInfoOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clGetMemObjectInfo:";
 
   stream << " memobj = " << *(params->memobj);
   stream << " paramName = " << *(params->paramName);
@@ -1646,13 +1646,13 @@ static void clGetMemObjectInfoOnEnter(
   stream << " paramValueSizeRet = " << *(params->paramValueSizeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetMemObjectInfoOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clGetMemObjectInfo";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -1662,7 +1662,7 @@ static void clGetMemObjectInfoOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clLinkProgramOnEnter(
@@ -1672,8 +1672,8 @@ static void clLinkProgramOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clLinkProgram:";
 
   stream << " context = " << *(params->context);
   stream << " numDevices = " << *(params->numDevices);
@@ -1692,7 +1692,7 @@ static void clLinkProgramOnEnter(
   stream << " errcodeRet = " << *(params->errcodeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 
   if (*(params->errcodeRet) == nullptr) {
     *(params->errcodeRet) = &current_error;
@@ -1701,8 +1701,8 @@ static void clLinkProgramOnEnter(
 
 static void clLinkProgramOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clLinkProgram";
   stream << " [" << (end - start) << " ns]";
 
   const cl_params_clLinkProgram* params =
@@ -1720,7 +1720,7 @@ static void clLinkProgramOnExit(
   stream << " (" << **(params->errcodeRet) << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clCreateSamplerWithPropertiesOnEnter(
@@ -1730,15 +1730,15 @@ static void clCreateSamplerWithPropertiesOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clCreateSamplerWithProperties:";
 
   stream << " context = " << *(params->context);
   stream << " samplerProperties = " << *(params->samplerProperties);
   stream << " errcodeRet = " << *(params->errcodeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 
   if (*(params->errcodeRet) == nullptr) {
     *(params->errcodeRet) = &current_error;
@@ -1747,8 +1747,8 @@ static void clCreateSamplerWithPropertiesOnEnter(
 
 static void clCreateSamplerWithPropertiesOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clCreateSamplerWithProperties";
   stream << " [" << (end - start) << " ns]";
 
   const cl_params_clCreateSamplerWithProperties* params =
@@ -1766,7 +1766,7 @@ static void clCreateSamplerWithPropertiesOnExit(
   stream << " (" << **(params->errcodeRet) << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clRetainSamplerOnEnter(
@@ -1776,19 +1776,19 @@ static void clRetainSamplerOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clRetainSampler:";
 
   stream << " sampler = " << *(params->sampler);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clRetainSamplerOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clRetainSampler";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -1798,7 +1798,7 @@ static void clRetainSamplerOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clCreateFromGLTexture3DOnEnter(
@@ -1808,8 +1808,8 @@ static void clCreateFromGLTexture3DOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clCreateFromGLTexture3D:";
 
   stream << " context = " << *(params->context);
   stream << " flags = " << *(params->flags);
@@ -1819,7 +1819,7 @@ static void clCreateFromGLTexture3DOnEnter(
   stream << " errcodeRet = " << *(params->errcodeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 
   if (*(params->errcodeRet) == nullptr) {
     *(params->errcodeRet) = &current_error;
@@ -1828,8 +1828,8 @@ static void clCreateFromGLTexture3DOnEnter(
 
 static void clCreateFromGLTexture3DOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clCreateFromGLTexture3D";
   stream << " [" << (end - start) << " ns]";
 
   const cl_params_clCreateFromGLTexture3D* params =
@@ -1847,7 +1847,7 @@ static void clCreateFromGLTexture3DOnExit(
   stream << " (" << **(params->errcodeRet) << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueMapImageOnEnter(
@@ -1857,8 +1857,8 @@ static void clEnqueueMapImageOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clEnqueueMapImage:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << " image = " << *(params->image);
@@ -1874,7 +1874,7 @@ static void clEnqueueMapImageOnEnter(
   stream << " errcodeRet = " << *(params->errcodeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 
   if (*(params->errcodeRet) == nullptr) {
     *(params->errcodeRet) = &current_error;
@@ -1883,8 +1883,8 @@ static void clEnqueueMapImageOnEnter(
 
 static void clEnqueueMapImageOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clEnqueueMapImage";
   stream << " [" << (end - start) << " ns]";
 
   const cl_params_clEnqueueMapImage* params =
@@ -1902,7 +1902,7 @@ static void clEnqueueMapImageOnExit(
   stream << " (" << **(params->errcodeRet) << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueWriteBufferOnEnter(
@@ -1912,8 +1912,8 @@ static void clEnqueueWriteBufferOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clEnqueueWriteBuffer:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << " buffer = " << *(params->buffer);
@@ -1926,13 +1926,13 @@ static void clEnqueueWriteBufferOnEnter(
   stream << " event = " << *(params->event);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueWriteBufferOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clEnqueueWriteBuffer";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -1942,7 +1942,7 @@ static void clEnqueueWriteBufferOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueCopyImageOnEnter(
@@ -1952,8 +1952,8 @@ static void clEnqueueCopyImageOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clEnqueueCopyImage:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << " srcImage = " << *(params->srcImage);
@@ -1966,13 +1966,13 @@ static void clEnqueueCopyImageOnEnter(
   stream << " event = " << *(params->event);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueCopyImageOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clEnqueueCopyImage";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -1982,7 +1982,7 @@ static void clEnqueueCopyImageOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetExtensionFunctionAddressOnEnter(
@@ -1992,8 +1992,8 @@ static void clGetExtensionFunctionAddressOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clGetExtensionFunctionAddress:";
 
   if (*(params->funcName) == nullptr) {
     stream << " funcName = " << "0";
@@ -2004,13 +2004,13 @@ static void clGetExtensionFunctionAddressOnEnter(
   }
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetExtensionFunctionAddressOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clGetExtensionFunctionAddress";
   stream << " [" << (end - start) << " ns]";
 
   void** result =
@@ -2019,7 +2019,7 @@ static void clGetExtensionFunctionAddressOnExit(
   stream << " result = " << *result;
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueReadBufferRectOnEnter(
@@ -2029,8 +2029,8 @@ static void clEnqueueReadBufferRectOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clEnqueueReadBufferRect:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << " buffer = " << *(params->buffer);
@@ -2048,13 +2048,13 @@ static void clEnqueueReadBufferRectOnEnter(
   stream << " event = " << *(params->event);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueReadBufferRectOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clEnqueueReadBufferRect";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -2064,7 +2064,7 @@ static void clEnqueueReadBufferRectOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clCreateSubDevicesOnEnter(
@@ -2074,8 +2074,8 @@ static void clCreateSubDevicesOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clCreateSubDevices:";
 
   stream << " inDevice = " << *(params->inDevice);
   stream << " properties = " << *(params->properties);
@@ -2084,13 +2084,13 @@ static void clCreateSubDevicesOnEnter(
   stream << " numDevicesRet = " << *(params->numDevicesRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clCreateSubDevicesOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clCreateSubDevices";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -2100,7 +2100,7 @@ static void clCreateSubDevicesOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetDeviceAndHostTimerOnEnter(
@@ -2110,21 +2110,21 @@ static void clGetDeviceAndHostTimerOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clGetDeviceAndHostTimer:";
 
   stream << " device = " << *(params->device);
   stream << " deviceTimestamp = " << *(params->deviceTimestamp);
   stream << " hostTimestamp = " << *(params->hostTimestamp);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetDeviceAndHostTimerOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clGetDeviceAndHostTimer";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -2134,7 +2134,7 @@ static void clGetDeviceAndHostTimerOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clReleaseSamplerOnEnter(
@@ -2144,19 +2144,19 @@ static void clReleaseSamplerOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clReleaseSampler:";
 
   stream << " sampler = " << *(params->sampler);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clReleaseSamplerOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clReleaseSampler";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -2166,7 +2166,7 @@ static void clReleaseSamplerOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueTaskOnEnter(
@@ -2176,8 +2176,8 @@ static void clEnqueueTaskOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clEnqueueTask:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << " kernel = " << *(params->kernel);
@@ -2186,13 +2186,13 @@ static void clEnqueueTaskOnEnter(
   stream << " event = " << *(params->event);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueTaskOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clEnqueueTask";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -2202,7 +2202,7 @@ static void clEnqueueTaskOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clFinishOnEnter(
@@ -2212,19 +2212,19 @@ static void clFinishOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clFinish:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clFinishOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clFinish";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -2234,7 +2234,7 @@ static void clFinishOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetEventInfoOnEnter(
@@ -2244,8 +2244,8 @@ static void clGetEventInfoOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clGetEventInfo:";
 
   stream << " event = " << *(params->event);
   stream << " paramName = " << *(params->paramName);
@@ -2254,13 +2254,13 @@ static void clGetEventInfoOnEnter(
   stream << " paramValueSizeRet = " << *(params->paramValueSizeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetEventInfoOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clGetEventInfo";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -2270,7 +2270,7 @@ static void clGetEventInfoOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetEventProfilingInfoOnEnter(
@@ -2280,8 +2280,8 @@ static void clGetEventProfilingInfoOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clGetEventProfilingInfo:";
 
   stream << " event = " << *(params->event);
   stream << " paramName = " << *(params->paramName);
@@ -2290,13 +2290,13 @@ static void clGetEventProfilingInfoOnEnter(
   stream << " paramValueSizeRet = " << *(params->paramValueSizeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetEventProfilingInfoOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clGetEventProfilingInfo";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -2306,7 +2306,7 @@ static void clGetEventProfilingInfoOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clSetKernelArgSVMPointerOnEnter(
@@ -2316,21 +2316,21 @@ static void clSetKernelArgSVMPointerOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clSetKernelArgSVMPointer:";
 
   stream << " kernel = " << *(params->kernel);
   stream << " argIndex = " << *(params->argIndex);
   stream << " argValue = " << *(params->argValue);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clSetKernelArgSVMPointerOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clSetKernelArgSVMPointer";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -2340,7 +2340,7 @@ static void clSetKernelArgSVMPointerOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clCreateImageOnEnter(
@@ -2350,8 +2350,8 @@ static void clCreateImageOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clCreateImage:";
 
   stream << " context = " << *(params->context);
   stream << " flags = " << *(params->flags);
@@ -2361,7 +2361,7 @@ static void clCreateImageOnEnter(
   stream << " errcodeRet = " << *(params->errcodeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 
   if (*(params->errcodeRet) == nullptr) {
     *(params->errcodeRet) = &current_error;
@@ -2370,8 +2370,8 @@ static void clCreateImageOnEnter(
 
 static void clCreateImageOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clCreateImage";
   stream << " [" << (end - start) << " ns]";
 
   const cl_params_clCreateImage* params =
@@ -2389,7 +2389,7 @@ static void clCreateImageOnExit(
   stream << " (" << **(params->errcodeRet) << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueSVMMemcpyOnEnter(
@@ -2399,8 +2399,8 @@ static void clEnqueueSVMMemcpyOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clEnqueueSVMMemcpy:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << " blockingCopy = " << *(params->blockingCopy);
@@ -2412,13 +2412,13 @@ static void clEnqueueSVMMemcpyOnEnter(
   stream << " event = " << *(params->event);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueSVMMemcpyOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clEnqueueSVMMemcpy";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -2428,7 +2428,7 @@ static void clEnqueueSVMMemcpyOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clReleaseKernelOnEnter(
@@ -2438,19 +2438,19 @@ static void clReleaseKernelOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clReleaseKernel:";
 
   stream << " kernel = " << *(params->kernel);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clReleaseKernelOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clReleaseKernel";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -2460,7 +2460,7 @@ static void clReleaseKernelOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueNativeKernelOnEnter(
@@ -2470,8 +2470,8 @@ static void clEnqueueNativeKernelOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clEnqueueNativeKernel:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << " userFunc = " << *(params->userFunc);
@@ -2485,13 +2485,13 @@ static void clEnqueueNativeKernelOnEnter(
   stream << " event = " << *(params->event);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueNativeKernelOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clEnqueueNativeKernel";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -2501,7 +2501,7 @@ static void clEnqueueNativeKernelOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clCreateKernelsInProgramOnEnter(
@@ -2511,8 +2511,8 @@ static void clCreateKernelsInProgramOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clCreateKernelsInProgram:";
 
   stream << " program = " << *(params->program);
   stream << " numKernels = " << *(params->numKernels);
@@ -2520,13 +2520,13 @@ static void clCreateKernelsInProgramOnEnter(
   stream << " numKernelsRet = " << *(params->numKernelsRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clCreateKernelsInProgramOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clCreateKernelsInProgram";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -2536,7 +2536,7 @@ static void clCreateKernelsInProgramOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clSetCommandQueuePropertyOnEnter(
@@ -2546,8 +2546,8 @@ static void clSetCommandQueuePropertyOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clSetCommandQueueProperty:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << " properties = " << *(params->properties);
@@ -2555,13 +2555,13 @@ static void clSetCommandQueuePropertyOnEnter(
   stream << " oldProperties = " << *(params->oldProperties);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clSetCommandQueuePropertyOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clSetCommandQueueProperty";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -2571,7 +2571,7 @@ static void clSetCommandQueuePropertyOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetDeviceInfoOnEnter(
@@ -2581,8 +2581,8 @@ static void clGetDeviceInfoOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clGetDeviceInfo:";
 
   stream << " device = " << *(params->device);
   stream << " paramName = " << *(params->paramName);
@@ -2591,13 +2591,13 @@ static void clGetDeviceInfoOnEnter(
   stream << " paramValueSizeRet = " << *(params->paramValueSizeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetDeviceInfoOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clGetDeviceInfo";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -2607,7 +2607,7 @@ static void clGetDeviceInfoOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueNDRangeKernelOnEnter(
@@ -2617,8 +2617,8 @@ static void clEnqueueNDRangeKernelOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clEnqueueNDRangeKernel:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << " kernel = " << *(params->kernel);
@@ -2631,13 +2631,13 @@ static void clEnqueueNDRangeKernelOnEnter(
   stream << " event = " << *(params->event);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueNDRangeKernelOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clEnqueueNDRangeKernel";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -2647,7 +2647,7 @@ static void clEnqueueNDRangeKernelOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clReleaseProgramOnEnter(
@@ -2657,19 +2657,19 @@ static void clReleaseProgramOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clReleaseProgram:";
 
   stream << " program = " << *(params->program);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clReleaseProgramOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clReleaseProgram";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -2679,7 +2679,7 @@ static void clReleaseProgramOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clCreateFromGLBufferOnEnter(
@@ -2689,8 +2689,8 @@ static void clCreateFromGLBufferOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clCreateFromGLBuffer:";
 
   stream << " context = " << *(params->context);
   stream << " flags = " << *(params->flags);
@@ -2698,7 +2698,7 @@ static void clCreateFromGLBufferOnEnter(
   stream << " errcodeRet = " << *(params->errcodeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 
   if (*(params->errcodeRet) == nullptr) {
     *(params->errcodeRet) = &current_error;
@@ -2707,8 +2707,8 @@ static void clCreateFromGLBufferOnEnter(
 
 static void clCreateFromGLBufferOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clCreateFromGLBuffer";
   stream << " [" << (end - start) << " ns]";
 
   const cl_params_clCreateFromGLBuffer* params =
@@ -2726,7 +2726,7 @@ static void clCreateFromGLBufferOnExit(
   stream << " (" << **(params->errcodeRet) << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetGLTextureInfoOnEnter(
@@ -2736,8 +2736,8 @@ static void clGetGLTextureInfoOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clGetGLTextureInfo:";
 
   stream << " memobj = " << *(params->memobj);
   stream << " paramName = " << *(params->paramName);
@@ -2746,13 +2746,13 @@ static void clGetGLTextureInfoOnEnter(
   stream << " paramValueSizeRet = " << *(params->paramValueSizeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetGLTextureInfoOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clGetGLTextureInfo";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -2762,7 +2762,7 @@ static void clGetGLTextureInfoOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clSetDefaultDeviceCommandQueueOnEnter(
@@ -2772,21 +2772,21 @@ static void clSetDefaultDeviceCommandQueueOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clSetDefaultDeviceCommandQueue:";
 
   stream << " context = " << *(params->context);
   stream << " device = " << *(params->device);
   stream << " commandQueue = " << *(params->commandQueue);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clSetDefaultDeviceCommandQueueOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clSetDefaultDeviceCommandQueue";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -2796,7 +2796,7 @@ static void clSetDefaultDeviceCommandQueueOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clCreatePipeOnEnter(
@@ -2806,8 +2806,8 @@ static void clCreatePipeOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clCreatePipe:";
 
   stream << " context = " << *(params->context);
   stream << " flags = " << *(params->flags);
@@ -2817,7 +2817,7 @@ static void clCreatePipeOnEnter(
   stream << " errcodeRet = " << *(params->errcodeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 
   if (*(params->errcodeRet) == nullptr) {
     *(params->errcodeRet) = &current_error;
@@ -2826,8 +2826,8 @@ static void clCreatePipeOnEnter(
 
 static void clCreatePipeOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clCreatePipe";
   stream << " [" << (end - start) << " ns]";
 
   const cl_params_clCreatePipe* params =
@@ -2845,7 +2845,7 @@ static void clCreatePipeOnExit(
   stream << " (" << **(params->errcodeRet) << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetPlatformInfoOnEnter(
@@ -2855,8 +2855,8 @@ static void clGetPlatformInfoOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clGetPlatformInfo:";
 
   stream << " platform = " << *(params->platform);
   stream << " paramName = " << *(params->paramName);
@@ -2865,13 +2865,13 @@ static void clGetPlatformInfoOnEnter(
   stream << " paramValueSizeRet = " << *(params->paramValueSizeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetPlatformInfoOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clGetPlatformInfo";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -2881,7 +2881,7 @@ static void clGetPlatformInfoOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueReadBufferOnEnter(
@@ -2891,8 +2891,8 @@ static void clEnqueueReadBufferOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clEnqueueReadBuffer:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << " buffer = " << *(params->buffer);
@@ -2905,13 +2905,13 @@ static void clEnqueueReadBufferOnEnter(
   stream << " event = " << *(params->event);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueReadBufferOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clEnqueueReadBuffer";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -2921,7 +2921,7 @@ static void clEnqueueReadBufferOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clSetMemObjectDestructorCallbackOnEnter(
@@ -2931,21 +2931,21 @@ static void clSetMemObjectDestructorCallbackOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clSetMemObjectDestructorCallback:";
 
   stream << " memobj = " << *(params->memobj);
   stream << " funcNotify = " << *(params->funcNotify);
   stream << " userData = " << *(params->userData);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clSetMemObjectDestructorCallbackOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clSetMemObjectDestructorCallback";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -2955,7 +2955,7 @@ static void clSetMemObjectDestructorCallbackOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetKernelSubGroupInfoOnEnter(
@@ -2965,8 +2965,8 @@ static void clGetKernelSubGroupInfoOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clGetKernelSubGroupInfo:";
 
   stream << " kernel = " << *(params->kernel);
   stream << " device = " << *(params->device);
@@ -2978,13 +2978,13 @@ static void clGetKernelSubGroupInfoOnEnter(
   stream << " paramValueSizeRet = " << *(params->paramValueSizeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetKernelSubGroupInfoOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clGetKernelSubGroupInfo";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -2994,7 +2994,7 @@ static void clGetKernelSubGroupInfoOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueCopyBufferRectOnEnter(
@@ -3004,8 +3004,8 @@ static void clEnqueueCopyBufferRectOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clEnqueueCopyBufferRect:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << " srcBuffer = " << *(params->srcBuffer);
@@ -3022,13 +3022,13 @@ static void clEnqueueCopyBufferRectOnEnter(
   stream << " event = " << *(params->event);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueCopyBufferRectOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clEnqueueCopyBufferRect";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -3038,7 +3038,7 @@ static void clEnqueueCopyBufferRectOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clWaitForEventsOnEnter(
@@ -3048,20 +3048,20 @@ static void clWaitForEventsOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clWaitForEvents:";
 
   stream << " numEvents = " << *(params->numEvents);
   stream << " eventList = " << *(params->eventList);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clWaitForEventsOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clWaitForEvents";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -3071,7 +3071,7 @@ static void clWaitForEventsOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueSVMMigrateMemOnEnter(
@@ -3081,8 +3081,8 @@ static void clEnqueueSVMMigrateMemOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clEnqueueSVMMigrateMem:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << " numSvmPointers = " << *(params->numSvmPointers);
@@ -3094,13 +3094,13 @@ static void clEnqueueSVMMigrateMemOnEnter(
   stream << " event = " << *(params->event);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueSVMMigrateMemOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clEnqueueSVMMigrateMem";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -3110,7 +3110,7 @@ static void clEnqueueSVMMigrateMemOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clRetainKernelOnEnter(
@@ -3120,19 +3120,19 @@ static void clRetainKernelOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clRetainKernel:";
 
   stream << " kernel = " << *(params->kernel);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clRetainKernelOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clRetainKernel";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -3142,7 +3142,7 @@ static void clRetainKernelOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clCreateCommandQueueWithPropertiesOnEnter(
@@ -3152,8 +3152,8 @@ static void clCreateCommandQueueWithPropertiesOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clCreateCommandQueueWithProperties:";
 
   stream << " context = " << *(params->context);
   stream << " device = " << *(params->device);
@@ -3161,7 +3161,7 @@ static void clCreateCommandQueueWithPropertiesOnEnter(
   stream << " errcodeRet = " << *(params->errcodeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 
   if (*(params->errcodeRet) == nullptr) {
     *(params->errcodeRet) = &current_error;
@@ -3170,8 +3170,8 @@ static void clCreateCommandQueueWithPropertiesOnEnter(
 
 static void clCreateCommandQueueWithPropertiesOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clCreateCommandQueueWithProperties";
   stream << " [" << (end - start) << " ns]";
 
   const cl_params_clCreateCommandQueueWithProperties* params =
@@ -3189,7 +3189,7 @@ static void clCreateCommandQueueWithPropertiesOnExit(
   stream << " (" << **(params->errcodeRet) << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clCreateProgramWithBuiltInKernelsOnEnter(
@@ -3199,8 +3199,8 @@ static void clCreateProgramWithBuiltInKernelsOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clCreateProgramWithBuiltInKernels:";
 
   stream << " context = " << *(params->context);
   stream << " numDevices = " << *(params->numDevices);
@@ -3215,7 +3215,7 @@ static void clCreateProgramWithBuiltInKernelsOnEnter(
   stream << " errcodeRet = " << *(params->errcodeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 
   if (*(params->errcodeRet) == nullptr) {
     *(params->errcodeRet) = &current_error;
@@ -3224,8 +3224,8 @@ static void clCreateProgramWithBuiltInKernelsOnEnter(
 
 static void clCreateProgramWithBuiltInKernelsOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clCreateProgramWithBuiltInKernels";
   stream << " [" << (end - start) << " ns]";
 
   const cl_params_clCreateProgramWithBuiltInKernels* params =
@@ -3243,7 +3243,7 @@ static void clCreateProgramWithBuiltInKernelsOnExit(
   stream << " (" << **(params->errcodeRet) << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clCreateBufferOnEnter(
@@ -3253,8 +3253,8 @@ static void clCreateBufferOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clCreateBuffer:";
 
   stream << " context = " << *(params->context);
   stream << " flags = " << *(params->flags);
@@ -3263,7 +3263,7 @@ static void clCreateBufferOnEnter(
   stream << " errcodeRet = " << *(params->errcodeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 
   if (*(params->errcodeRet) == nullptr) {
     *(params->errcodeRet) = &current_error;
@@ -3272,8 +3272,8 @@ static void clCreateBufferOnEnter(
 
 static void clCreateBufferOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clCreateBuffer";
   stream << " [" << (end - start) << " ns]";
 
   const cl_params_clCreateBuffer* params =
@@ -3291,7 +3291,7 @@ static void clCreateBufferOnExit(
   stream << " (" << **(params->errcodeRet) << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetProgramBuildInfoOnEnter(
@@ -3301,8 +3301,8 @@ static void clGetProgramBuildInfoOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clGetProgramBuildInfo:";
 
   stream << " program = " << *(params->program);
   stream << " device = " << *(params->device);
@@ -3312,13 +3312,13 @@ static void clGetProgramBuildInfoOnEnter(
   stream << " paramValueSizeRet = " << *(params->paramValueSizeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetProgramBuildInfoOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clGetProgramBuildInfo";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -3328,7 +3328,7 @@ static void clGetProgramBuildInfoOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueFillBufferOnEnter(
@@ -3338,8 +3338,8 @@ static void clEnqueueFillBufferOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clEnqueueFillBuffer:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << " buffer = " << *(params->buffer);
@@ -3352,13 +3352,13 @@ static void clEnqueueFillBufferOnEnter(
   stream << " event = " << *(params->event);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueFillBufferOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clEnqueueFillBuffer";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -3368,7 +3368,7 @@ static void clEnqueueFillBufferOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueReadImageOnEnter(
@@ -3378,8 +3378,8 @@ static void clEnqueueReadImageOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clEnqueueReadImage:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << " image = " << *(params->image);
@@ -3394,13 +3394,13 @@ static void clEnqueueReadImageOnEnter(
   stream << " event = " << *(params->event);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueReadImageOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clEnqueueReadImage";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -3410,7 +3410,7 @@ static void clEnqueueReadImageOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueWriteBufferRectOnEnter(
@@ -3420,8 +3420,8 @@ static void clEnqueueWriteBufferRectOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clEnqueueWriteBufferRect:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << " buffer = " << *(params->buffer);
@@ -3439,13 +3439,13 @@ static void clEnqueueWriteBufferRectOnEnter(
   stream << " event = " << *(params->event);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueWriteBufferRectOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clEnqueueWriteBufferRect";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -3455,7 +3455,7 @@ static void clEnqueueWriteBufferRectOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueCopyBufferToImageOnEnter(
@@ -3465,8 +3465,8 @@ static void clEnqueueCopyBufferToImageOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clEnqueueCopyBufferToImage:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << " srcBuffer = " << *(params->srcBuffer);
@@ -3479,13 +3479,13 @@ static void clEnqueueCopyBufferToImageOnEnter(
   stream << " event = " << *(params->event);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueCopyBufferToImageOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clEnqueueCopyBufferToImage";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -3495,7 +3495,7 @@ static void clEnqueueCopyBufferToImageOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetExtensionFunctionAddressForPlatformOnEnter(
@@ -3506,8 +3506,8 @@ static void clGetExtensionFunctionAddressForPlatformOnEnter(
           data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clGetExtensionFunctionAddressForPlatform:";
 
   stream << " platform = " << *(params->platform);
   if (*(params->funcName) == nullptr) {
@@ -3519,13 +3519,13 @@ static void clGetExtensionFunctionAddressForPlatformOnEnter(
   }
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetExtensionFunctionAddressForPlatformOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clGetExtensionFunctionAddressForPlatform";
   stream << " [" << (end - start) << " ns]";
 
   void** result =
@@ -3534,7 +3534,7 @@ static void clGetExtensionFunctionAddressForPlatformOnExit(
   stream << " result = " << *result;
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clSetKernelArgOnEnter(
@@ -3544,8 +3544,8 @@ static void clSetKernelArgOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clSetKernelArg:";
 
   stream << " kernel = " << *(params->kernel);
   stream << " argIndex = " << *(params->argIndex);
@@ -3553,13 +3553,13 @@ static void clSetKernelArgOnEnter(
   stream << " argValue = " << *(params->argValue);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clSetKernelArgOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clSetKernelArg";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -3569,7 +3569,7 @@ static void clSetKernelArgOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clReleaseDeviceOnEnter(
@@ -3579,19 +3579,19 @@ static void clReleaseDeviceOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clReleaseDevice:";
 
   stream << " device = " << *(params->device);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clReleaseDeviceOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clReleaseDevice";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -3601,7 +3601,7 @@ static void clReleaseDeviceOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clCreateSubBufferOnEnter(
@@ -3611,8 +3611,8 @@ static void clCreateSubBufferOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clCreateSubBuffer:";
 
   stream << " buffer = " << *(params->buffer);
   stream << " flags = " << *(params->flags);
@@ -3621,7 +3621,7 @@ static void clCreateSubBufferOnEnter(
   stream << " errcodeRet = " << *(params->errcodeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 
   if (*(params->errcodeRet) == nullptr) {
     *(params->errcodeRet) = &current_error;
@@ -3630,8 +3630,8 @@ static void clCreateSubBufferOnEnter(
 
 static void clCreateSubBufferOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clCreateSubBuffer";
   stream << " [" << (end - start) << " ns]";
 
   const cl_params_clCreateSubBuffer* params =
@@ -3649,7 +3649,7 @@ static void clCreateSubBufferOnExit(
   stream << " (" << **(params->errcodeRet) << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueMigrateMemObjectsOnEnter(
@@ -3659,8 +3659,8 @@ static void clEnqueueMigrateMemObjectsOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clEnqueueMigrateMemObjects:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << " numMemObjects = " << *(params->numMemObjects);
@@ -3671,13 +3671,13 @@ static void clEnqueueMigrateMemObjectsOnEnter(
   stream << " event = " << *(params->event);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueMigrateMemObjectsOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clEnqueueMigrateMemObjects";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -3687,7 +3687,7 @@ static void clEnqueueMigrateMemObjectsOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clCreateCommandQueueOnEnter(
@@ -3697,8 +3697,8 @@ static void clCreateCommandQueueOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clCreateCommandQueue:";
 
   stream << " context = " << *(params->context);
   stream << " device = " << *(params->device);
@@ -3706,7 +3706,7 @@ static void clCreateCommandQueueOnEnter(
   stream << " errcodeRet = " << *(params->errcodeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 
   if (*(params->errcodeRet) == nullptr) {
     *(params->errcodeRet) = &current_error;
@@ -3715,8 +3715,8 @@ static void clCreateCommandQueueOnEnter(
 
 static void clCreateCommandQueueOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clCreateCommandQueue";
   stream << " [" << (end - start) << " ns]";
 
   const cl_params_clCreateCommandQueue* params =
@@ -3734,7 +3734,7 @@ static void clCreateCommandQueueOnExit(
   stream << " (" << **(params->errcodeRet) << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueSVMMemFillOnEnter(
@@ -3744,8 +3744,8 @@ static void clEnqueueSVMMemFillOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clEnqueueSVMMemFill:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << " svmPtr = " << *(params->svmPtr);
@@ -3757,13 +3757,13 @@ static void clEnqueueSVMMemFillOnEnter(
   stream << " event = " << *(params->event);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueSVMMemFillOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clEnqueueSVMMemFill";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -3773,7 +3773,7 @@ static void clEnqueueSVMMemFillOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clReleaseCommandQueueOnEnter(
@@ -3783,19 +3783,19 @@ static void clReleaseCommandQueueOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clReleaseCommandQueue:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clReleaseCommandQueueOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clReleaseCommandQueue";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -3805,7 +3805,7 @@ static void clReleaseCommandQueueOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueCopyBufferOnEnter(
@@ -3815,8 +3815,8 @@ static void clEnqueueCopyBufferOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clEnqueueCopyBuffer:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << " srcBuffer = " << *(params->srcBuffer);
@@ -3829,13 +3829,13 @@ static void clEnqueueCopyBufferOnEnter(
   stream << " event = " << *(params->event);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueCopyBufferOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clEnqueueCopyBuffer";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -3845,7 +3845,7 @@ static void clEnqueueCopyBufferOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetCommandQueueInfoOnEnter(
@@ -3855,8 +3855,8 @@ static void clGetCommandQueueInfoOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clGetCommandQueueInfo:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << " paramName = " << *(params->paramName);
@@ -3865,13 +3865,13 @@ static void clGetCommandQueueInfoOnEnter(
   stream << " paramValueSizeRet = " << *(params->paramValueSizeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetCommandQueueInfoOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clGetCommandQueueInfo";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -3881,7 +3881,7 @@ static void clGetCommandQueueInfoOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clBuildProgramOnEnter(
@@ -3891,8 +3891,8 @@ static void clBuildProgramOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clBuildProgram:";
 
   stream << " program = " << *(params->program);
   stream << " numDevices = " << *(params->numDevices);
@@ -3908,13 +3908,13 @@ static void clBuildProgramOnEnter(
   stream << " userData = " << *(params->userData);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clBuildProgramOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clBuildProgram";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -3924,7 +3924,7 @@ static void clBuildProgramOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clRetainContextOnEnter(
@@ -3934,19 +3934,19 @@ static void clRetainContextOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clRetainContext:";
 
   stream << " context = " << *(params->context);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clRetainContextOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clRetainContext";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -3956,7 +3956,7 @@ static void clRetainContextOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueBarrierOnEnter(
@@ -3966,19 +3966,19 @@ static void clEnqueueBarrierOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clEnqueueBarrier:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueBarrierOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clEnqueueBarrier";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -3988,7 +3988,7 @@ static void clEnqueueBarrierOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clRetainDeviceOnEnter(
@@ -3998,19 +3998,19 @@ static void clRetainDeviceOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clRetainDevice:";
 
   stream << " device = " << *(params->device);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clRetainDeviceOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clRetainDevice";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -4020,7 +4020,7 @@ static void clRetainDeviceOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueSVMMapOnEnter(
@@ -4030,8 +4030,8 @@ static void clEnqueueSVMMapOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clEnqueueSVMMap:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << " blockingMap = " << *(params->blockingMap);
@@ -4043,13 +4043,13 @@ static void clEnqueueSVMMapOnEnter(
   stream << " event = " << *(params->event);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueSVMMapOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clEnqueueSVMMap";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -4059,7 +4059,7 @@ static void clEnqueueSVMMapOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clRetainMemObjectOnEnter(
@@ -4069,19 +4069,19 @@ static void clRetainMemObjectOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clRetainMemObject:";
 
   stream << " memobj = " << *(params->memobj);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clRetainMemObjectOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clRetainMemObject";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -4091,7 +4091,7 @@ static void clRetainMemObjectOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clSetUserEventStatusOnEnter(
@@ -4101,20 +4101,20 @@ static void clSetUserEventStatusOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clSetUserEventStatus:";
 
   stream << " event = " << *(params->event);
   stream << " executionStatus = " << *(params->executionStatus);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clSetUserEventStatusOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clSetUserEventStatus";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -4124,7 +4124,7 @@ static void clSetUserEventStatusOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clCreateUserEventOnEnter(
@@ -4134,14 +4134,14 @@ static void clCreateUserEventOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clCreateUserEvent:";
 
   stream << " context = " << *(params->context);
   stream << " errcodeRet = " << *(params->errcodeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 
   if (*(params->errcodeRet) == nullptr) {
     *(params->errcodeRet) = &current_error;
@@ -4150,8 +4150,8 @@ static void clCreateUserEventOnEnter(
 
 static void clCreateUserEventOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clCreateUserEvent";
   stream << " [" << (end - start) << " ns]";
 
   const cl_params_clCreateUserEvent* params =
@@ -4169,7 +4169,7 @@ static void clCreateUserEventOnExit(
   stream << " (" << **(params->errcodeRet) << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetSamplerInfoOnEnter(
@@ -4179,8 +4179,8 @@ static void clGetSamplerInfoOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clGetSamplerInfo:";
 
   stream << " sampler = " << *(params->sampler);
   stream << " paramName = " << *(params->paramName);
@@ -4189,13 +4189,13 @@ static void clGetSamplerInfoOnEnter(
   stream << " paramValueSizeRet = " << *(params->paramValueSizeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetSamplerInfoOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clGetSamplerInfo";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -4205,7 +4205,7 @@ static void clGetSamplerInfoOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueMarkerOnEnter(
@@ -4215,20 +4215,20 @@ static void clEnqueueMarkerOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clEnqueueMarker:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << " event = " << *(params->event);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueMarkerOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clEnqueueMarker";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -4238,7 +4238,7 @@ static void clEnqueueMarkerOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clCreateKernelOnEnter(
@@ -4248,8 +4248,8 @@ static void clCreateKernelOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clCreateKernel:";
 
   stream << " program = " << *(params->program);
   if (*(params->kernelName) == nullptr) {
@@ -4262,7 +4262,7 @@ static void clCreateKernelOnEnter(
   stream << " errcodeRet = " << *(params->errcodeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 
   if (*(params->errcodeRet) == nullptr) {
     *(params->errcodeRet) = &current_error;
@@ -4271,8 +4271,8 @@ static void clCreateKernelOnEnter(
 
 static void clCreateKernelOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clCreateKernel";
   stream << " [" << (end - start) << " ns]";
 
   const cl_params_clCreateKernel* params =
@@ -4290,7 +4290,7 @@ static void clCreateKernelOnExit(
   stream << " (" << **(params->errcodeRet) << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetProgramInfoOnEnter(
@@ -4300,8 +4300,8 @@ static void clGetProgramInfoOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clGetProgramInfo:";
 
   stream << " program = " << *(params->program);
   stream << " paramName = " << *(params->paramName);
@@ -4310,13 +4310,13 @@ static void clGetProgramInfoOnEnter(
   stream << " paramValueSizeRet = " << *(params->paramValueSizeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetProgramInfoOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clGetProgramInfo";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -4326,7 +4326,7 @@ static void clGetProgramInfoOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clSVMAllocOnEnter(
@@ -4336,8 +4336,8 @@ static void clSVMAllocOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clSVMAlloc:";
 
   stream << " context = " << *(params->context);
   stream << " flags = " << *(params->flags);
@@ -4345,13 +4345,13 @@ static void clSVMAllocOnEnter(
   stream << " alignment = " << *(params->alignment);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clSVMAllocOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clSVMAlloc";
   stream << " [" << (end - start) << " ns]";
 
   void ** result =
@@ -4361,7 +4361,7 @@ static void clSVMAllocOnExit(
   stream << " result = " << *result;
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clRetainEventOnEnter(
@@ -4371,19 +4371,19 @@ static void clRetainEventOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clRetainEvent:";
 
   stream << " event = " << *(params->event);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clRetainEventOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clRetainEvent";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -4393,7 +4393,7 @@ static void clRetainEventOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clCloneKernelOnEnter(
@@ -4403,14 +4403,14 @@ static void clCloneKernelOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clCloneKernel:";
 
   stream << " sourceKernel = " << *(params->sourceKernel);
   stream << " errcodeRet = " << *(params->errcodeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 
   if (*(params->errcodeRet) == nullptr) {
     *(params->errcodeRet) = &current_error;
@@ -4419,8 +4419,8 @@ static void clCloneKernelOnEnter(
 
 static void clCloneKernelOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clCloneKernel";
   stream << " [" << (end - start) << " ns]";
 
   const cl_params_clCloneKernel* params =
@@ -4438,7 +4438,7 @@ static void clCloneKernelOnExit(
   stream << " (" << **(params->errcodeRet) << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetImageInfoOnEnter(
@@ -4448,8 +4448,8 @@ static void clGetImageInfoOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clGetImageInfo:";
 
   stream << " image = " << *(params->image);
   stream << " paramName = " << *(params->paramName);
@@ -4458,13 +4458,13 @@ static void clGetImageInfoOnEnter(
   stream << " paramValueSizeRet = " << *(params->paramValueSizeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clGetImageInfoOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clGetImageInfo";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -4474,7 +4474,7 @@ static void clGetImageInfoOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clFlushOnEnter(
@@ -4484,19 +4484,19 @@ static void clFlushOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clFlush:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clFlushOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clFlush";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -4506,7 +4506,7 @@ static void clFlushOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueMarkerWithWaitListOnEnter(
@@ -4516,8 +4516,8 @@ static void clEnqueueMarkerWithWaitListOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clEnqueueMarkerWithWaitList:";
 
   stream << " commandQueue = " << *(params->commandQueue);
   stream << " numEventsInWaitList = " << *(params->numEventsInWaitList);
@@ -4525,13 +4525,13 @@ static void clEnqueueMarkerWithWaitListOnEnter(
   stream << " event = " << *(params->event);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clEnqueueMarkerWithWaitListOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clEnqueueMarkerWithWaitList";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -4541,7 +4541,7 @@ static void clEnqueueMarkerWithWaitListOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clCreateProgramWithILOnEnter(
@@ -4551,8 +4551,8 @@ static void clCreateProgramWithILOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clCreateProgramWithIL:";
 
   stream << " context = " << *(params->context);
   stream << " il = " << *(params->il);
@@ -4560,7 +4560,7 @@ static void clCreateProgramWithILOnEnter(
   stream << " errcodeRet = " << *(params->errcodeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 
   if (*(params->errcodeRet) == nullptr) {
     *(params->errcodeRet) = &current_error;
@@ -4569,8 +4569,8 @@ static void clCreateProgramWithILOnEnter(
 
 static void clCreateProgramWithILOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clCreateProgramWithIL";
   stream << " [" << (end - start) << " ns]";
 
   const cl_params_clCreateProgramWithIL* params =
@@ -4588,7 +4588,7 @@ static void clCreateProgramWithILOnExit(
   stream << " (" << **(params->errcodeRet) << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clCreateSamplerOnEnter(
@@ -4598,8 +4598,8 @@ static void clCreateSamplerOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clCreateSampler:";
 
   stream << " context = " << *(params->context);
   stream << " normalizedCoords = " << *(params->normalizedCoords);
@@ -4608,7 +4608,7 @@ static void clCreateSamplerOnEnter(
   stream << " errcodeRet = " << *(params->errcodeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 
   if (*(params->errcodeRet) == nullptr) {
     *(params->errcodeRet) = &current_error;
@@ -4617,8 +4617,8 @@ static void clCreateSamplerOnEnter(
 
 static void clCreateSamplerOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clCreateSampler";
   stream << " [" << (end - start) << " ns]";
 
   const cl_params_clCreateSampler* params =
@@ -4636,7 +4636,7 @@ static void clCreateSamplerOnExit(
   stream << " (" << **(params->errcodeRet) << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clCreateFromGLTextureOnEnter(
@@ -4646,8 +4646,8 @@ static void clCreateFromGLTextureOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clCreateFromGLTexture:";
 
   stream << " context = " << *(params->context);
   stream << " flags = " << *(params->flags);
@@ -4657,7 +4657,7 @@ static void clCreateFromGLTextureOnEnter(
   stream << " errcodeRet = " << *(params->errcodeRet);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 
   if (*(params->errcodeRet) == nullptr) {
     *(params->errcodeRet) = &current_error;
@@ -4666,8 +4666,8 @@ static void clCreateFromGLTextureOnEnter(
 
 static void clCreateFromGLTextureOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clCreateFromGLTexture";
   stream << " [" << (end - start) << " ns]";
 
   const cl_params_clCreateFromGLTexture* params =
@@ -4685,7 +4685,7 @@ static void clCreateFromGLTextureOnExit(
   stream << " (" << **(params->errcodeRet) << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clSVMFreeOnEnter(
@@ -4695,25 +4695,25 @@ static void clSVMFreeOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clSVMFree:";
 
   stream << " context = " << *(params->context);
   stream << " svmPointer = " << *(params->svmPointer);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clSVMFreeOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clSVMFree";
   stream << " [" << (end - start) << " ns]";
 
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clReleaseEventOnEnter(
@@ -4723,19 +4723,19 @@ static void clReleaseEventOnEnter(
         data->functionParams);
   PTI_ASSERT(params != nullptr);
 
-  std::stringstream stream;
-  stream << ">>>> [" << start << "] " << data->functionName << ":";
+  utils::CallRecord stream;
+  stream << ">>>> [" << start << "] clReleaseEvent:";
 
   stream << " event = " << *(params->event);
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
 }
 
 static void clReleaseEventOnExit(
     cl_callback_data* data, uint64_t start, uint64_t end) {
-  std::stringstream stream;
-  stream << "<<<< [" << end << "] " << data->functionName;
+  utils::CallRecord stream;
+  stream << "<<<< [" << end << "] clReleaseEvent";
   stream << " [" << (end - start) << " ns]";
 
   cl_int* error = reinterpret_cast<cl_int*>(data->functionReturnValue);
@@ -4745,7 +4745,251 @@ static void clReleaseEventOnExit(
   stream << " (" << *error << ")";
   stream << std::endl;
 
-  std::cerr << stream.str();
+  stream.Submit();
+}
+
+static const char* GetFunctionName(cl_function_id function) {
+  switch (function) {
+    case CL_FUNCTION_clBuildProgram:
+      return "clBuildProgram";
+    case CL_FUNCTION_clCloneKernel:
+      return "clCloneKernel";
+    case CL_FUNCTION_clCompileProgram:
+      return "clCompileProgram";
+    case CL_FUNCTION_clCreateBuffer:
+      return "clCreateBuffer";
+    case CL_FUNCTION_clCreateCommandQueue:
+      return "clCreateCommandQueue";
+    case CL_FUNCTION_clCreateCommandQueueWithProperties:
+      return "clCreateCommandQueueWithProperties";
+    case CL_FUNCTION_clCreateContext:
+      return "clCreateContext";
+    case CL_FUNCTION_clCreateContextFromType:
+      return "clCreateContextFromType";
+    case CL_FUNCTION_clCreateFromGLBuffer:
+      return "clCreateFromGLBuffer";
+    case CL_FUNCTION_clCreateFromGLRenderbuffer:
+      return "clCreateFromGLRenderbuffer";
+    case CL_FUNCTION_clCreateFromGLTexture:
+      return "clCreateFromGLTexture";
+    case CL_FUNCTION_clCreateFromGLTexture2D:
+      return "clCreateFromGLTexture2D";
+    case CL_FUNCTION_clCreateFromGLTexture3D:
+      return "clCreateFromGLTexture3D";
+    case CL_FUNCTION_clCreateImage:
+      return "clCreateImage";
+    case CL_FUNCTION_clCreateImage2D:
+      return "clCreateImage2D";
+    case CL_FUNCTION_clCreateImage3D:
+      return "clCreateImage3D";
+    case CL_FUNCTION_clCreateKernel:
+      return "clCreateKernel";
+    case CL_FUNCTION_clCreateKernelsInProgram:
+      return "clCreateKernelsInProgram";
+    case CL_FUNCTION_clCreatePipe:
+      return "clCreatePipe";
+    case CL_FUNCTION_clCreateProgramWithBinary:
+      return "clCreateProgramWithBinary";
+    case CL_FUNCTION_clCreateProgramWithBuiltInKernels:
+      return "clCreateProgramWithBuiltInKernels";
+    case CL_FUNCTION_clCreateProgramWithIL:
+      return "clCreateProgramWithIL";
+    case CL_FUNCTION_clCreateProgramWithSource:
+      return "clCreateProgramWithSource";
+    case CL_FUNCTION_clCreateSampler:
+      return "clCreateSampler";
+    case CL_FUNCTION_clCreateSamplerWithProperties:
+      return "clCreateSamplerWithProperties";
+    case CL_FUNCTION_clCreateSubBuffer:
+      return "clCreateSubBuffer";
+    case CL_FUNCTION_clCreateSubDevices:
+      return "clCreateSubDevices";
+    case CL_FUNCTION_clCreateUserEvent:
+      return "clCreateUserEvent";
+    case CL_FUNCTION_clEnqueueAcquireGLObjects:
+      return "clEnqueueAcquireGLObjects";
+    case CL_FUNCTION_clEnqueueBarrier:
+      return "clEnqueueBarrier";
+    case CL_FUNCTION_clEnqueueBarrierWithWaitList:
+      return "clEnqueueBarrierWithWaitList";
+    case CL_FUNCTION_clEnqueueCopyBuffer:
+      return "clEnqueueCopyBuffer";
+    case CL_FUNCTION_clEnqueueCopyBufferRect:
+      return "clEnqueueCopyBufferRect";
+    case CL_FUNCTION_clEnqueueCopyBufferToImage:
+      return "clEnqueueCopyBufferToImage";
+    case CL_FUNCTION_clEnqueueCopyImage:
+      return "clEnqueueCopyImage";
+    case CL_FUNCTION_clEnqueueCopyImageToBuffer:
+      return "clEnqueueCopyImageToBuffer";
+    case CL_FUNCTION_clEnqueueFillBuffer:
+      return "clEnqueueFillBuffer";
+    case CL_FUNCTION_clEnqueueFillImage:
+      return "clEnqueueFillImage";
+    case CL_FUNCTION_clEnqueueMapBuffer:
+      return "clEnqueueMapBuffer";
+    case CL_FUNCTION_clEnqueueMapImage:
+      return "clEnqueueMapImage";
+    case CL_FUNCTION_clEnqueueMarker:
+      return "clEnqueueMarker";
+    case CL_FUNCTION_clEnqueueMarkerWithWaitList:
+      return "clEnqueueMarkerWithWaitList";
+    case CL_FUNCTION_clEnqueueMigrateMemObjects:
+      return "clEnqueueMigrateMemObjects";
+    case CL_FUNCTION_clEnqueueNDRangeKernel:
+      return "clEnqueueNDRangeKernel";
+    case CL_FUNCTION_clEnqueueNativeKernel:
+      return "clEnqueueNativeKernel";
+    case CL_FUNCTION_clEnqueueReadBuffer:
+      return "clEnqueueReadBuffer";
+    case CL_FUNCTION_clEnqueueReadBufferRect:
+      return "clEnqueueReadBufferRect";
+    case CL_FUNCTION_clEnqueueReadImage:
+      return "clEnqueueReadImage";
+    case CL_FUNCTION_clEnqueueReleaseGLObjects:
+      return "clEnqueueReleaseGLObjects";
+    case CL_FUNCTION_clEnqueueSVMFree:
+      return "clEnqueueSVMFree";
+    case CL_FUNCTION_clEnqueueSVMMap:
+      return "clEnqueueSVMMap";
+    case CL_FUNCTION_clEnqueueSVMMemFill:
+      return "clEnqueueSVMMemFill";
+    case CL_FUNCTION_clEnqueueSVMMemcpy:
+      return "clEnqueueSVMMemcpy";
+    case CL_FUNCTION_clEnqueueSVMMigrateMem:
+      return "clEnqueueSVMMigrateMem";
+    case CL_FUNCTION_clEnqueueSVMUnmap:
+      return "clEnqueueSVMUnmap";
+    case CL_FUNCTION_clEnqueueTask:
+      return "clEnqueueTask";
+    case CL_FUNCTION_clEnqueueUnmapMemObject:
+      return "clEnqueueUnmapMemObject";
+    case CL_FUNCTION_clEnqueueWaitForEvents:
+      return "clEnqueueWaitForEvents";
+    case CL_FUNCTION_clEnqueueWriteBuffer:
+      return "clEnqueueWriteBuffer";
+    case CL_FUNCTION_clEnqueueWriteBufferRect:
+      return "clEnqueueWriteBufferRect";
+    case CL_FUNCTION_clEnqueueWriteImage:
+      return "clEnqueueWriteImage";
+    case CL_FUNCTION_clFinish:
+      return "clFinish";
+    case CL_FUNCTION_clFlush:
+      return "clFlush";
+    case CL_FUNCTION_clGetCommandQueueInfo:
+      return "clGetCommandQueueInfo";
+    case CL_FUNCTION_clGetContextInfo:
+      return "clGetContextInfo";
+    case CL_FUNCTION_clGetDeviceAndHostTimer:
+      return "clGetDeviceAndHostTimer";
+    case CL_FUNCTION_clGetDeviceIDs:
+      return "clGetDeviceIDs";
+    case CL_FUNCTION_clGetDeviceInfo:
+      return "clGetDeviceInfo";
+    case CL_FUNCTION_clGetEventInfo:
+      return "clGetEventInfo";
+    case CL_FUNCTION_clGetEventProfilingInfo:
+      return "clGetEventProfilingInfo";
+    case CL_FUNCTION_clGetExtensionFunctionAddress:
+      return "clGetExtensionFunctionAddress";
+    case CL_FUNCTION_clGetExtensionFunctionAddressForPlatform:
+      return "clGetExtensionFunctionAddressForPlatform";
+    case CL_FUNCTION_clGetGLObjectInfo:
+      return "clGetGLObjectInfo";
+    case CL_FUNCTION_clGetGLTextureInfo:
+      return "clGetGLTextureInfo";
+    case CL_FUNCTION_clGetHostTimer:
+      return "clGetHostTimer";
+    case CL_FUNCTION_clGetImageInfo:
+      return "clGetImageInfo";
+    case CL_FUNCTION_clGetKernelArgInfo:
+      return "clGetKernelArgInfo";
+    case CL_FUNCTION_clGetKernelInfo:
+      return "clGetKernelInfo";
+    case CL_FUNCTION_clGetKernelSubGroupInfo:
+      return "clGetKernelSubGroupInfo";
+    case CL_FUNCTION_clGetKernelWorkGroupInfo:
+      return "clGetKernelWorkGroupInfo";
+    case CL_FUNCTION_clGetMemObjectInfo:
+      return "clGetMemObjectInfo";
+    case CL_FUNCTION_clGetPipeInfo:
+      return "clGetPipeInfo";
+    case CL_FUNCTION_clGetPlatformIDs:
+      return "clGetPlatformIDs";
+    case CL_FUNCTION_clGetPlatformInfo:
+      return "clGetPlatformInfo";
+    case CL_FUNCTION_clGetProgramBuildInfo:
+      return "clGetProgramBuildInfo";
+    case CL_FUNCTION_clGetProgramInfo:
+      return "clGetProgramInfo";
+    case CL_FUNCTION_clGetSamplerInfo:
+      return "clGetSamplerInfo";
+    case CL_FUNCTION_clGetSupportedImageFormats:
+      return "clGetSupportedImageFormats";
+    case CL_FUNCTION_clLinkProgram:
+      return "clLinkProgram";
+    case CL_FUNCTION_clReleaseCommandQueue:
+      return "clReleaseCommandQueue";
+    case CL_FUNCTION_clReleaseContext:
+      return "clReleaseContext";
+    case CL_FUNCTION_clReleaseDevice:
+      return "clReleaseDevice";
+    case CL_FUNCTION_clReleaseEvent:
+      return "clReleaseEvent";
+    case CL_FUNCTION_clReleaseKernel:
+      return "clReleaseKernel";
+    case CL_FUNCTION_clReleaseMemObject:
+      return "clReleaseMemObject";
+    case CL_FUNCTION_clReleaseProgram:
+      return "clReleaseProgram";
+    case CL_FUNCTION_clReleaseSampler:
+      return "clReleaseSampler";
+    case CL_FUNCTION_clRetainCommandQueue:
+      return "clRetainCommandQueue";
+    case CL_FUNCTION_clRetainContext:
+      return "clRetainContext";
+    case CL_FUNCTION_clRetainDevice:
+      return "clRetainDevice";
+    case CL_FUNCTION_clRetainEvent:
+      return "clRetainEvent";
+    case CL_FUNCTION_clRetainKernel:
+      return "clRetainKernel";
+    case CL_FUNCTION_clRetainMemObject:
+      return "clRetainMemObject";
+    case CL_FUNCTION_clRetainProgram:
+      return "clRetainProgram";
+    case CL_FUNCTION_clRetainSampler:
+      return "clRetainSampler";
+    case CL_FUNCTION_clSVMAlloc:
+      return "clSVMAlloc";
+    case CL_FUNCTION_clSVMFree:
+      return "clSVMFree";
+    case CL_FUNCTION_clSetCommandQueueProperty:
+      return "clSetCommandQueueProperty";
+    case CL_FUNCTION_clSetDefaultDeviceCommandQueue:
+      return "clSetDefaultDeviceCommandQueue";
+    case CL_FUNCTION_clSetEventCallback:
+      return "clSetEventCallback";
+    case CL_FUNCTION_clSetKernelArg:
+      return "clSetKernelArg";
+    case CL_FUNCTION_clSetKernelArgSVMPointer:
+      return "clSetKernelArgSVMPointer";
+    case CL_FUNCTION_clSetKernelExecInfo:
+      return "clSetKernelExecInfo";
+    case CL_FUNCTION_clSetMemObjectDestructorCallback:
+      return "clSetMemObjectDestructorCallback";
+    case CL_FUNCTION_clSetUserEventStatus:
+      return "clSetUserEventStatus";
+    case CL_FUNCTION_clUnloadCompiler:
+      return "clUnloadCompiler";
+    case CL_FUNCTION_clUnloadPlatformCompiler:
+      return "clUnloadPlatformCompiler";
+    case CL_FUNCTION_clWaitForEvents:
+      return "clWaitForEvents";
+    default:
+      break;
+  }
+  return "UNKNOWN";
 }
 
 static void OnEnterFunction(
@@ -11,11 +11,12 @@
 #include <iomanip>
 #include <iostream>
 #include <map>
-#include <mutex>
 #include <set>
 
 #include "cl_api_tracer.h"
 #include "cl_utils.h"
+#include "function_info_table.h"
+#include "timestamp.h"
 #include "trace_guard.h"
 
 #include "cl_api_callbacks.h"
@@ -88,10 +89,16 @@ class ClApiCollector {
     PTI_ASSERT(tracer_ != nullptr);
     bool disabled = tracer_->Disable();
     PTI_ASSERT(disabled);
+
+    if (call_tracing_) {
+      utils::GetCallLogger().Flush();
+    }
   }
 
-  const ClFunctionInfoMap& GetFunctionInfoMap() const {
-    return function_info_map_;
+  ClFunctionInfoMap GetFunctionInfoMap() const {
+    return function_info_table_.GetFunctionInfoMap([](uint32_t id) {
+      return GetFunctionName(static_cast<cl_function_id>(id));
+    });
   }
 
   ClApiCollector(const ClApiCollector& copy) = delete;
@@ -163,26 +170,11 @@ class ClApiCollector {
   }
 
   uint64_t GetTimestamp() const {
-    std::chrono::duration<uint64_t, std::nano> timestamp =
-      std::chrono::steady_clock::now() - base_time_;
-    return timestamp.count();
+    return utils::GetTimestamp(base_time_);
   }
 
-  void AddFunctionTime(const std::string& name, uint64_t time) {
-    const std::lock_guard<std::mutex> lock(lock_);
-    if (function_info_map_.count(name) == 0) {
-      function_info_map_[name] = {time, time, time, 1};
-    } else {
-      ClFunction& function = function_info_map_[name];
-      function.total_time += time;
-      if (time < function.min_time) {
-        function.min_time = time;
-      }
-      if (time > function.max_time) {
-        function.max_time = time;
-      }
-      ++function.call_count;
-    }
+  void AddFunctionTime(cl_function_id function, uint64_t time) {
+    function_info_table_.AddFunctionTime(function, time);
   }
 
  private: // Callbacks
@@ -210,8 +202,7 @@ class ClApiCollector {
 
       uint64_t& start_time = *reinterpret_cast<uint64_t*>(
           callback_data->correlationData);
-      collector->AddFunctionTime(
-        callback_data->functionName, end_time - start_time);
+      collector->AddFunctionTime(function, end_time - start_time);
 
       if (collector->call_tracing_) {
         OnExitFunction(function, callback_data, start_time, end_time);
@@ -234,8 +225,7 @@ class ClApiCollector {
   OnClFunctionFinishCallback callback_ = nullptr;
   void* callback_data_ = nullptr;
 
-  std::mutex lock_;
-  ClFunctionInfoMap function_info_map_;
+  utils::FunctionInfoTable<ClFunction, CL_FUNCTION_COUNT> function_info_table_;
 
   static const uint32_t kFunctionLength = 10;
   static const uint32_t kCallsLength = 12;
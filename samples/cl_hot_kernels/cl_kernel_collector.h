@@ -7,14 +7,20 @@
 #ifndef PTI_SAMPLES_CL_HOT_KERNELS_CL_KERNEL_COLLECTOR_H_
 #define PTI_SAMPLES_CL_HOT_KERNELS_CL_KERNEL_COLLECTOR_H_
 
+#include <condition_variable>
 #include <list>
 #include <map>
 #include <mutex>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "cl_api_tracer.h"
 #include "cl_utils.h"
+#include "clock_correlator.h"
+#include "kernel_info_accumulator.h"
+#include "string_table.h"
 #include "trace_guard.h"
 
 class ClKernelCollector;
@@ -24,16 +30,38 @@ enum ClKernelType {
   KERNEL_TYPE_TRANSFER
 };
 
+// Way to get profiling data for completed commands
+enum ClHarvestMode {
+  // Completion callback is set for every command
+  HARVEST_MODE_CALLBACK,
+  // Events are kept per queue and read in bulk on clFinish,
+  // clWaitForEvents and clReleaseCommandQueue or by periodic reaper
+  HARVEST_MODE_DEFERRED
+};
+
+// Per-event state, recycled through the collector pool
 struct ClEventData {
   ClKernelCollector* collector;
-  std::string kernel_name;
+  cl_command_queue queue;
+  uint32_t kernel_name_id;
   ClKernelType kernel_type;
   union {
-    cl_kernel kernel;
+    size_t simd_width;
     size_t bytes_transferred;
   };
 };
 
+struct ClPendingEvent {
+  cl_event event;
+  ClEventData data;
+};
+
+// Kernel properties queried once and cached until the kernel is released
+struct ClKernelProps {
+  uint32_t name_id;
+  std::vector< std::pair<cl_device_id, size_t> > simd_width_list;
+};
+
 struct ClKernelInfo {
   uint64_t total_time;
   uint64_t min_time;
@@ -58,17 +86,21 @@ struct ClKernelInfo {
 };
 
 struct ClKernelInterval {
-  std::string name;
+  uint32_t name_id;
   uint64_t start;
   uint64_t end;
 };
 
 using ClKernelInfoMap = std::map<std::string, ClKernelInfo>;
 using ClKernelIntervalList = std::vector<ClKernelInterval>;
+using ClKernelPropsMap = std::map<cl_kernel, ClKernelProps>;
+using ClQueueDeviceMap = std::map<cl_command_queue, cl_device_id>;
+using ClPendingEventMap =
+  std::map<cl_command_queue, std::vector<ClPendingEvent> >;
 using ClKernelTimePoint = std::chrono::time_point<std::chrono::steady_clock>;
 
 typedef void (*OnClKernelFinishCallback)(
-    void* data, void* queue, const std::string& name,
+    void* data, void* queue, uint32_t name_id,
     uint64_t queued, uint64_t submitted,
     uint64_t started, uint64_t ended);
 
@@ -78,12 +110,13 @@ class ClKernelCollector {
       cl_device_id device,
       ClKernelTimePoint base_time = std::chrono::steady_clock::now(),
       OnClKernelFinishCallback callback = nullptr,
-      void* callback_data = nullptr) {
+      void* callback_data = nullptr,
+      ClHarvestMode harvest_mode = HARVEST_MODE_CALLBACK) {
     PTI_ASSERT(device != nullptr);
     TraceGuard guard;
 
     ClKernelCollector* collector = new ClKernelCollector(
-        device, base_time, callback, callback_data);
+        device, base_time, callback, callback_data, harvest_mode);
     PTI_ASSERT(collector != nullptr);
 
     ClApiTracer* tracer = new ClApiTracer(device, Callback, collector);
@@ -102,18 +135,33 @@ class ClKernelCollector {
   }
 
   ~ClKernelCollector() {
+    StopReaper();
     if (tracer_ != nullptr) {
       delete tracer_;
     }
+    for (auto event_data : event_data_pool_) {
+      delete event_data;
+    }
+    delete clock_correlator_;
   }
 
   void DisableTracing() {
     PTI_ASSERT(tracer_ != nullptr);
     bool disabled = tracer_->Disable();
     PTI_ASSERT(disabled);
+
+    if (harvest_mode_ == HARVEST_MODE_DEFERRED) {
+      TraceGuard guard;
+      StopReaper();
+      HarvestEvents(nullptr, true);
+    }
   }
 
   const ClKernelInfoMap& GetKernelInfoMap() const {
+    kernel_info_map_.clear();
+    for (auto& value : kernel_info_accumulator_.GetKernelInfoMap()) {
+      kernel_info_map_[utils::GetInternedString(value.first)] = value.second;
+    }
     return kernel_info_map_;
   }
 
@@ -182,19 +230,25 @@ class ClKernelCollector {
       cl_device_id device,
       ClKernelTimePoint base_time,
       OnClKernelFinishCallback callback,
-      void* callback_data)
+      void* callback_data,
+      ClHarvestMode harvest_mode)
       : base_time_(base_time),
         callback_(callback),
-        callback_data_(callback_data) {
+        callback_data_(callback_data),
+        harvest_mode_(harvest_mode),
+        read_buffer_name_id_(utils::InternString("clEnqueueReadBuffer")),
+        write_buffer_name_id_(utils::InternString("clEnqueueWriteBuffer")) {
     if (callback_ != nullptr) {
       cl_device_type device_type = utils::cl::GetDeviceType(device);
-      if (device_type == CL_DEVICE_TYPE_GPU) {
-        dev_timestamp_ = utils::cl::GetGpuTimestamp();
-      } else {
-        PTI_ASSERT(device_type == CL_DEVICE_TYPE_CPU);
-        dev_timestamp_ = utils::cl::GetCpuTimestamp();
-      }
-      cpu_timestamp_ = std::chrono::steady_clock::now();
+      PTI_ASSERT(device_type == CL_DEVICE_TYPE_GPU ||
+                 device_type == CL_DEVICE_TYPE_CPU);
+      clock_correlator_ = new utils::ClockCorrelator(
+          new utils::cl::DeviceClockSource(device_type), NSEC_IN_SEC);
+      PTI_ASSERT(clock_correlator_ != nullptr);
+    }
+
+    if (harvest_mode_ == HARVEST_MODE_DEFERRED) {
+      reaper_thread_ = std::thread(Reap, this);
     }
   }
 
@@ -206,60 +260,256 @@ class ClKernelCollector {
     set = set && tracer->SetTracingFunction(
         CL_FUNCTION_clCreateCommandQueueWithProperties);
     set = set && tracer->SetTracingFunction(CL_FUNCTION_clCreateCommandQueue);
+    set = set && tracer->SetTracingFunction(CL_FUNCTION_clCreateKernel);
+    set = set && tracer->SetTracingFunction(CL_FUNCTION_clReleaseKernel);
+    set = set && tracer->SetTracingFunction(
+        CL_FUNCTION_clReleaseCommandQueue);
     set = set && tracer->SetTracingFunction(CL_FUNCTION_clEnqueueNDRangeKernel);
     set = set && tracer->SetTracingFunction(CL_FUNCTION_clEnqueueReadBuffer);
     set = set && tracer->SetTracingFunction(CL_FUNCTION_clEnqueueWriteBuffer);
+    if (harvest_mode_ == HARVEST_MODE_DEFERRED) {
+      set = set && tracer->SetTracingFunction(CL_FUNCTION_clFinish);
+      set = set && tracer->SetTracingFunction(CL_FUNCTION_clWaitForEvents);
+    }
     PTI_ASSERT(set);
 
     bool enabled = tracer_->Enable();
     PTI_ASSERT(enabled);
   }
 
-  void AddKernelInfo(
-      std::string name, uint64_t time,
-      size_t simd_width, size_t bytes_transferred) {
-    PTI_ASSERT(!name.empty());
-    if (kernel_info_map_.count(name) == 0) {
-      kernel_info_map_[name] = {
-        time, time, time, 1, simd_width, bytes_transferred};
-    } else {
-      ClKernelInfo& kernel = kernel_info_map_[name];
-      kernel.total_time += time;
-      if (time > kernel.max_time) {
-        kernel.max_time = time;
+  void AddKernelProps(cl_kernel kernel) {
+    PTI_ASSERT(kernel != nullptr);
+    ClKernelProps props{
+        utils::InternString(utils::cl::GetKernelName(kernel)),
+        std::vector< std::pair<cl_device_id, size_t> >()};
+
+    const std::lock_guard<std::mutex> lock(props_lock_);
+    kernel_props_map_.emplace(kernel, std::move(props));
+  }
+
+  void RemoveKernelProps(cl_kernel kernel) {
+    PTI_ASSERT(kernel != nullptr);
+    const std::lock_guard<std::mutex> lock(props_lock_);
+    kernel_props_map_.erase(kernel);
+  }
+
+  void RemoveQueueDevice(cl_command_queue queue) {
+    PTI_ASSERT(queue != nullptr);
+    const std::lock_guard<std::mutex> lock(props_lock_);
+    queue_device_map_.erase(queue);
+  }
+
+  // Returns cached kernel name identifier and SIMD width for the device
+  // the queue belongs to. OpenCL is queried only on the first enqueue of
+  // the kernel (or of the kernel to the new device)
+  void GetKernelProps(cl_kernel kernel, cl_command_queue queue,
+                      uint32_t* name_id, size_t* simd_width) {
+    PTI_ASSERT(kernel != nullptr && queue != nullptr);
+    PTI_ASSERT(name_id != nullptr && simd_width != nullptr);
+
+    std::unique_lock<std::mutex> lock(props_lock_);
+
+    auto queue_it = queue_device_map_.find(queue);
+    if (queue_it == queue_device_map_.end()) {
+      lock.unlock();
+      cl_device_id device = utils::cl::GetDevice(queue);
+      PTI_ASSERT(device != nullptr);
+      lock.lock();
+      queue_it = queue_device_map_.emplace(queue, device).first;
+    }
+    cl_device_id device = queue_it->second;
+
+    auto kernel_it = kernel_props_map_.find(kernel);
+    if (kernel_it == kernel_props_map_.end()) {
+      // Kernel was created with clCreateKernelsInProgram or clCloneKernel
+      lock.unlock();
+      AddKernelProps(kernel);
+      lock.lock();
+      kernel_it = kernel_props_map_.find(kernel);
+      PTI_ASSERT(kernel_it != kernel_props_map_.end());
+    }
+    ClKernelProps& props = kernel_it->second;
+    *name_id = props.name_id;
+
+    for (auto& value : props.simd_width_list) {
+      if (value.first == device) {
+        *simd_width = value.second;
+        return;
       }
-      if (time < kernel.min_time) {
-        kernel.min_time = time;
+    }
+
+    lock.unlock();
+    *simd_width = utils::cl::GetSimdWidth(device, kernel);
+    PTI_ASSERT(*simd_width > 0);
+    lock.lock();
+
+    kernel_it = kernel_props_map_.find(kernel);
+    if (kernel_it != kernel_props_map_.end()) {
+      kernel_it->second.simd_width_list.push_back(
+          std::make_pair(device, *simd_width));
+    }
+  }
+
+  ClEventData* AcquireEventData() {
+    {
+      const std::lock_guard<std::mutex> lock(props_lock_);
+      if (!event_data_pool_.empty()) {
+        ClEventData* event_data = event_data_pool_.back();
+        event_data_pool_.pop_back();
+        return event_data;
       }
-      kernel.call_count += 1;
-      kernel.bytes_transferred += bytes_transferred;
-      PTI_ASSERT(kernel.simd_width == simd_width);
     }
+
+    ClEventData* event_data = new ClEventData;
+    PTI_ASSERT(event_data != nullptr);
+    return event_data;
   }
 
-  void AddKernelInterval(std::string name, uint64_t start, uint64_t end) {
-    PTI_ASSERT(!name.empty());
-    PTI_ASSERT(start < end);
-    kernel_interval_list_.push_back({name, start, end});
+  void ReleaseEventData(ClEventData* event_data) {
+    PTI_ASSERT(event_data != nullptr);
+    const std::lock_guard<std::mutex> lock(props_lock_);
+    event_data_pool_.push_back(event_data);
   }
 
- private: // Callbacks
-  static void CL_CALLBACK EventNotify(
-      cl_event event, cl_int event_status, void* user_data) {
-    PTI_ASSERT(event_status == CL_COMPLETE);
+  // Takes ownership of the retained event
+  void AddEvent(cl_event event, const ClEventData& event_data) {
+    PTI_ASSERT(event != nullptr);
+    PTI_ASSERT(event_data.queue != nullptr);
+
+    if (harvest_mode_ == HARVEST_MODE_DEFERRED) {
+      const std::lock_guard<std::mutex> lock(harvest_lock_);
+      pending_event_map_[event_data.queue].push_back({event, event_data});
+      return;
+    }
+
+    ClEventData* data = AcquireEventData();
+    PTI_ASSERT(data != nullptr);
+    *data = event_data;
+
+    cl_int status = clSetEventCallback(event, CL_COMPLETE, EventNotify, data);
+    PTI_ASSERT(status == CL_SUCCESS);
+  }
+
+  // Processes completed events of the queue (or of all the queues if
+  // queue is nullptr), others are kept for the next harvest unless
+  // wait is requested
+  void HarvestEvents(cl_command_queue queue, bool wait) {
+    std::vector<ClPendingEvent> event_list;
+    {
+      const std::lock_guard<std::mutex> lock(harvest_lock_);
+      if (queue != nullptr) {
+        auto it = pending_event_map_.find(queue);
+        if (it != pending_event_map_.end()) {
+          event_list.swap(it->second);
+        }
+      } else {
+        for (auto& value : pending_event_map_) {
+          event_list.insert(
+              event_list.end(), value.second.begin(), value.second.end());
+          value.second.clear();
+        }
+      }
+    }
+
+    if (event_list.empty()) {
+      return;
+    }
+
+    std::vector<ClPendingEvent> incomplete_list;
+    for (auto& pending_event : event_list) {
+      cl_int event_status = GetEventStatus(pending_event.event);
+      if (event_status > CL_COMPLETE) {
+        if (!wait) {
+          incomplete_list.push_back(pending_event);
+          continue;
+        }
+        clWaitForEvents(1, &pending_event.event);
+        event_status = GetEventStatus(pending_event.event);
+      }
+
+      // Commands terminated with error have no profiling data
+      if (event_status == CL_COMPLETE) {
+        ProcessEvent(pending_event.event, pending_event.data);
+      }
+
+      cl_int status = clReleaseEvent(pending_event.event);
+      PTI_ASSERT(status == CL_SUCCESS);
+    }
+
+    if (!incomplete_list.empty()) {
+      const std::lock_guard<std::mutex> lock(harvest_lock_);
+      for (auto& pending_event : incomplete_list) {
+        pending_event_map_[pending_event.data.queue].push_back(pending_event);
+      }
+    }
+  }
+
+  static cl_int GetEventStatus(cl_event event) {
+    PTI_ASSERT(event != nullptr);
+    cl_int event_status = CL_COMPLETE;
+    cl_int status = clGetEventInfo(
+        event, CL_EVENT_COMMAND_EXECUTION_STATUS,
+        sizeof(cl_int), &event_status, nullptr);
+    PTI_ASSERT(status == CL_SUCCESS);
+    return event_status;
+  }
+
+  void StopReaper() {
+    if (!reaper_thread_.joinable()) {
+      return;
+    }
+
+    {
+      const std::lock_guard<std::mutex> lock(reaper_lock_);
+      reaper_active_ = false;
+    }
+    reaper_condition_.notify_one();
+    reaper_thread_.join();
+  }
+
+  // Harvests events for the applications that rarely synchronize
+  static void Reap(ClKernelCollector* collector) {
+    PTI_ASSERT(collector != nullptr);
     TraceGuard guard;
 
-    PTI_ASSERT(user_data != nullptr);
-    ClEventData* event_data = reinterpret_cast<ClEventData*>(user_data);
+    std::unique_lock<std::mutex> lock(collector->reaper_lock_);
+    while (collector->reaper_active_) {
+      collector->reaper_condition_.wait_for(
+          lock, std::chrono::milliseconds(kReaperPeriod));
+      if (!collector->reaper_active_) {
+        break;
+      }
 
-    ClKernelCollector* collector = event_data->collector;
+      lock.unlock();
+      collector->HarvestEvents(nullptr, false);
+      lock.lock();
+    }
+  }
+
+  void AddKernelInfo(
+      uint32_t name_id, uint64_t time,
+      size_t simd_width, size_t bytes_transferred) {
+    kernel_info_accumulator_.AddKernelInfo(
+        name_id, time, simd_width, bytes_transferred);
+  }
+
+  void AddKernelInterval(uint32_t name_id, uint64_t start, uint64_t end) {
+    PTI_ASSERT(start < end);
+    const std::lock_guard<std::mutex> lock(lock_);
+    kernel_interval_list_.push_back({name_id, start, end});
+  }
+
+ private: // Callbacks
+  static void ProcessEvent(cl_event event, const ClEventData& event_data) {
+    PTI_ASSERT(event != nullptr);
+
+    ClKernelCollector* collector = event_data.collector;
     PTI_ASSERT(collector != nullptr);
 
-    cl_command_queue queue = utils::cl::GetCommandQueue(event);
+    cl_command_queue queue = event_data.queue;
     PTI_ASSERT(queue != nullptr);
 
-    std::string name = event_data->kernel_name;
-    PTI_ASSERT(!name.empty());
+    uint32_t name_id = event_data.kernel_name_id;
 
     cl_ulong started =
       utils::cl::GetEventTimestamp(event, CL_PROFILING_COMMAND_START);
@@ -268,28 +518,20 @@ class ClKernelCollector {
     cl_ulong time = ended - started;
     PTI_ASSERT(time > 0);
 
-    if (event_data->kernel_type == KERNEL_TYPE_USER) {
-      cl_kernel kernel = event_data->kernel;
-
-      cl_device_id device = utils::cl::GetDevice(queue);
-      PTI_ASSERT(device != nullptr);
-
-      size_t simd_width = utils::cl::GetSimdWidth(device, kernel);
+    if (event_data.kernel_type == KERNEL_TYPE_USER) {
+      size_t simd_width = event_data.simd_width;
       PTI_ASSERT(simd_width > 0);
 
-      cl_int status = clReleaseKernel(kernel);
-      PTI_ASSERT(status == CL_SUCCESS);
-
-      collector->AddKernelInfo(name, time, simd_width, 0);
-      collector->AddKernelInterval(name, started, ended);
+      collector->AddKernelInfo(name_id, time, simd_width, 0);
+      collector->AddKernelInterval(name_id, started, ended);
 
     } else {
-      PTI_ASSERT(event_data->kernel_type == KERNEL_TYPE_TRANSFER);
+      PTI_ASSERT(event_data.kernel_type == KERNEL_TYPE_TRANSFER);
 
-      size_t bytes_transferred = event_data->bytes_transferred;
+      size_t bytes_transferred = event_data.bytes_transferred;
       PTI_ASSERT(bytes_transferred > 0);
 
-      collector->AddKernelInfo(name, time, 0, bytes_transferred);
+      collector->AddKernelInfo(name_id, time, 0, bytes_transferred);
     }
 
     if (collector->callback_ != nullptr) {
@@ -300,32 +542,45 @@ class ClKernelCollector {
         utils::cl::GetEventTimestamp(event, CL_PROFILING_COMMAND_SUBMIT);
       PTI_ASSERT(submitted > 0);
 
-      std::chrono::duration<uint64_t, std::nano> time_shift =
-        collector->cpu_timestamp_ - collector->base_time_;
-
-      PTI_ASSERT(collector->dev_timestamp_ < queued);
       PTI_ASSERT(queued < submitted);
       PTI_ASSERT(submitted < started);
       PTI_ASSERT(started < ended);
 
-      uint64_t cpu_queued =
-        (queued - collector->dev_timestamp_) + time_shift.count();
-      uint64_t cpu_submitted =
-        (submitted - collector->dev_timestamp_) + time_shift.count();
-      uint64_t cpu_started =
-        (started - collector->dev_timestamp_) + time_shift.count();
-      uint64_t cpu_ended =
-        (ended - collector->dev_timestamp_) + time_shift.count();
+      uint64_t base_time = std::chrono::duration_cast<
+        std::chrono::nanoseconds>(
+            collector->base_time_.time_since_epoch()).count();
+      uint64_t dev_time[] = {queued, submitted, started, ended};
+      uint64_t cpu_time[4] = {0};
+      PTI_ASSERT(collector->clock_correlator_ != nullptr);
+      collector->clock_correlator_->GetHostTime(dev_time, cpu_time, 4);
+      for (auto& time : cpu_time) {
+        PTI_ASSERT(time > base_time);
+        time -= base_time;
+      }
 
       collector->callback_(
-          collector->callback_data_, queue, name,
-          cpu_queued, cpu_submitted, cpu_started, cpu_ended);
+          collector->callback_data_, queue, name_id,
+          cpu_time[0], cpu_time[1], cpu_time[2], cpu_time[3]);
     }
+  }
+
+  static void CL_CALLBACK EventNotify(
+      cl_event event, cl_int event_status, void* user_data) {
+    PTI_ASSERT(event_status == CL_COMPLETE);
+    TraceGuard guard;
+
+    PTI_ASSERT(user_data != nullptr);
+    ClEventData* event_data = reinterpret_cast<ClEventData*>(user_data);
+
+    ClKernelCollector* collector = event_data->collector;
+    PTI_ASSERT(collector != nullptr);
+
+    collector->ProcessEvent(event, *event_data);
 
     cl_int status = clReleaseEvent(event);
     PTI_ASSERT(status == CL_SUCCESS);
 
-    delete event_data;
+    collector->ReleaseEventData(event_data);
   }
 
   static void OnEnterCreateCommandQueueWithProperties(cl_callback_data* data) {
@@ -362,6 +617,78 @@ class ClKernelCollector {
       static_cast<unsigned long>(CL_QUEUE_PROFILING_ENABLE);
   }
 
+  static void OnExitCreateKernel(
+      cl_callback_data* data, ClKernelCollector* collector) {
+    PTI_ASSERT(data != nullptr);
+
+    cl_kernel* kernel =
+      reinterpret_cast<cl_kernel*>(data->functionReturnValue);
+    if (*kernel != nullptr) {
+      collector->AddKernelProps(*kernel);
+    }
+  }
+
+  static void OnEnterReleaseKernel(
+      cl_callback_data* data, ClKernelCollector* collector) {
+    PTI_ASSERT(data != nullptr);
+
+    const cl_params_clReleaseKernel* params =
+      reinterpret_cast<const cl_params_clReleaseKernel*>(
+          data->functionParams);
+    PTI_ASSERT(params != nullptr);
+
+    // Handle may be reused by the runtime once the kernel is destroyed,
+    // so properties are dropped on any release and queried again if
+    // the kernel is still alive
+    if (*(params->kernel) != nullptr) {
+      collector->RemoveKernelProps(*(params->kernel));
+    }
+  }
+
+  static void OnEnterReleaseCommandQueue(
+      cl_callback_data* data, ClKernelCollector* collector) {
+    PTI_ASSERT(data != nullptr);
+
+    const cl_params_clReleaseCommandQueue* params =
+      reinterpret_cast<const cl_params_clReleaseCommandQueue*>(
+          data->functionParams);
+    PTI_ASSERT(params != nullptr);
+
+    if (*(params->commandQueue) != nullptr) {
+      if (collector->harvest_mode_ == HARVEST_MODE_DEFERRED) {
+        collector->HarvestEvents(*(params->commandQueue), false);
+      }
+      collector->RemoveQueueDevice(*(params->commandQueue));
+    }
+  }
+
+  static void OnExitFinish(
+      cl_callback_data* data, ClKernelCollector* collector) {
+    PTI_ASSERT(data != nullptr);
+
+    const cl_params_clFinish* params =
+      reinterpret_cast<const cl_params_clFinish*>(data->functionParams);
+    PTI_ASSERT(params != nullptr);
+
+    cl_int* return_value =
+      reinterpret_cast<cl_int*>(data->functionReturnValue);
+    if (*return_value == CL_SUCCESS) {
+      collector->HarvestEvents(*(params->commandQueue), false);
+    }
+  }
+
+  static void OnExitWaitForEvents(
+      cl_callback_data* data, ClKernelCollector* collector) {
+    PTI_ASSERT(data != nullptr);
+
+    // Events may belong to any queue
+    cl_int* return_value =
+      reinterpret_cast<cl_int*>(data->functionReturnValue);
+    if (*return_value == CL_SUCCESS) {
+      collector->HarvestEvents(nullptr, false);
+    }
+  }
+
   static void OnEnterEnqueueNDRangeKernel(cl_callback_data* data) {
     PTI_ASSERT(data != nullptr);
 
@@ -396,19 +723,15 @@ class ClKernelCollector {
         PTI_ASSERT(status == CL_SUCCESS);
       }
 
-      ClEventData* event_data = new ClEventData;
-      PTI_ASSERT(event_data != nullptr);
-      cl_kernel kernel = *(params->kernel);
-      event_data->collector = collector;
-      event_data->kernel_name = utils::cl::GetKernelName(kernel);
-      event_data->kernel_type = KERNEL_TYPE_USER;
-      event_data->kernel = kernel;
+      ClEventData event_data{};
+      event_data.collector = collector;
+      event_data.queue = *(params->commandQueue);
+      event_data.kernel_type = KERNEL_TYPE_USER;
+      collector->GetKernelProps(
+          *(params->kernel), *(params->commandQueue),
+          &event_data.kernel_name_id, &event_data.simd_width);
 
-      status = clRetainKernel(kernel);
-      PTI_ASSERT(status == CL_SUCCESS);
-      status = clSetEventCallback(
-          **(params->event), CL_COMPLETE, EventNotify, event_data);
-      PTI_ASSERT(status == CL_SUCCESS);
+      collector->AddEvent(**(params->event), event_data);
     }
   }
 
@@ -446,16 +769,14 @@ class ClKernelCollector {
         PTI_ASSERT(status == CL_SUCCESS);
       }
 
-      ClEventData* event_data = new ClEventData;
-      PTI_ASSERT(event_data != nullptr);
-      event_data->collector = collector;
-      event_data->kernel_name = "clEnqueueReadBuffer";
-      event_data->kernel_type = KERNEL_TYPE_TRANSFER;
-      event_data->bytes_transferred = *(params->cb);
+      ClEventData event_data{};
+      event_data.collector = collector;
+      event_data.queue = *(params->commandQueue);
+      event_data.kernel_name_id = collector->read_buffer_name_id_;
+      event_data.kernel_type = KERNEL_TYPE_TRANSFER;
+      event_data.bytes_transferred = *(params->cb);
 
-      status = clSetEventCallback(
-          **(params->event), CL_COMPLETE, EventNotify, event_data);
-      PTI_ASSERT(status == CL_SUCCESS);
+      collector->AddEvent(**(params->event), event_data);
     }
   }
 
@@ -493,16 +814,14 @@ class ClKernelCollector {
         PTI_ASSERT(status == CL_SUCCESS);
       }
 
-      ClEventData* event_data = new ClEventData;
-      PTI_ASSERT(event_data != nullptr);
-      event_data->collector = collector;
-      event_data->kernel_name = "clEnqueueWriteBuffer";
-      event_data->kernel_type = KERNEL_TYPE_TRANSFER;
-      event_data->bytes_transferred = *(params->cb);
+      ClEventData event_data{};
+      event_data.collector = collector;
+      event_data.queue = *(params->commandQueue);
+      event_data.kernel_name_id = collector->write_buffer_name_id_;
+      event_data.kernel_type = KERNEL_TYPE_TRANSFER;
+      event_data.bytes_transferred = *(params->cb);
 
-      status = clSetEventCallback(
-          **(params->event), CL_COMPLETE, EventNotify, event_data);
-      PTI_ASSERT(status == CL_SUCCESS);
+      collector->AddEvent(**(params->event), event_data);
     }
   }
 
@@ -526,6 +845,26 @@ class ClKernelCollector {
       if (callback_data->site == CL_CALLBACK_SITE_ENTER) {
         OnEnterCreateCommandQueue(callback_data);
       }
+    } else if (function == CL_FUNCTION_clCreateKernel) {
+      if (callback_data->site == CL_CALLBACK_SITE_EXIT) {
+        OnExitCreateKernel(callback_data, collector);
+      }
+    } else if (function == CL_FUNCTION_clReleaseKernel) {
+      if (callback_data->site == CL_CALLBACK_SITE_ENTER) {
+        OnEnterReleaseKernel(callback_data, collector);
+      }
+    } else if (function == CL_FUNCTION_clReleaseCommandQueue) {
+      if (callback_data->site == CL_CALLBACK_SITE_ENTER) {
+        OnEnterReleaseCommandQueue(callback_data, collector);
+      }
+    } else if (function == CL_FUNCTION_clFinish) {
+      if (callback_data->site == CL_CALLBACK_SITE_EXIT) {
+        OnExitFinish(callback_data, collector);
+      }
+    } else if (function == CL_FUNCTION_clWaitForEvents) {
+      if (callback_data->site == CL_CALLBACK_SITE_EXIT) {
+        OnExitWaitForEvents(callback_data, collector);
+      }
     } else if (function == CL_FUNCTION_clEnqueueNDRangeKernel) {
       if (callback_data->site == CL_CALLBACK_SITE_ENTER) {
         OnEnterEnqueueNDRangeKernel(callback_data);
@@ -554,19 +893,39 @@ class ClKernelCollector {
   OnClKernelFinishCallback callback_ = nullptr;
   void* callback_data_ = nullptr;
 
-  ClKernelTimePoint cpu_timestamp_;
-  uint64_t dev_timestamp_ = 0;
+  utils::ClockCorrelator* clock_correlator_ = nullptr;
 
   std::mutex lock_;
-  ClKernelInfoMap kernel_info_map_;
+  utils::KernelInfoAccumulator<uint32_t, ClKernelInfo>
+    kernel_info_accumulator_;
+  mutable ClKernelInfoMap kernel_info_map_;
   ClKernelIntervalList kernel_interval_list_;
 
+  std::mutex props_lock_;
+  ClKernelPropsMap kernel_props_map_;
+  ClQueueDeviceMap queue_device_map_;
+  std::vector<ClEventData*> event_data_pool_;
+
+  ClHarvestMode harvest_mode_ = HARVEST_MODE_CALLBACK;
+  std::mutex harvest_lock_;
+  ClPendingEventMap pending_event_map_;
+
+  std::thread reaper_thread_;
+  std::mutex reaper_lock_;
+  std::condition_variable reaper_condition_;
+  bool reaper_active_ = true;
+
+  uint32_t read_buffer_name_id_ = 0;
+  uint32_t write_buffer_name_id_ = 0;
+
   static const uint32_t kKernelLength = 10;
   static const uint32_t kCallsLength = 12;
   static const uint32_t kSimdLength = 5;
   static const uint32_t kTransferredLength = 20;
   static const uint32_t kTimeLength = 20;
   static const uint32_t kPercentLength = 10;
+
+  static const uint32_t kReaperPeriod = 50; // ms
 };
 
 #endif // PTI_SAMPLES_CL_HOT_KERNELS_CL_KERNEL_COLLECTOR_H_
\ No newline at end of file
@@ -4,6 +4,8 @@
 // SPDX-License-Identifier: MIT
 // =============================================================
 
+#include <string.h>
+
 #include <cstdlib>
 #include <iomanip>
 #include <iostream>
@@ -26,8 +28,12 @@ __declspec(dllexport)
 #endif
 void Usage() {
   std::cout <<
-    "Usage: ./cl_hot_functions[.exe] <application> <args>" <<
+    "Usage: ./cl_hot_kernels[.exe] [options] <application> <args>" <<
     std::endl;
+  std::cout << "Options:" << std::endl;
+  std::cout <<
+    "--deferred [-d]                 Read kernel timings in bulk at " <<
+    "synchronization points" << std::endl;
 }
 
 extern "C"
@@ -35,7 +41,16 @@ extern "C"
 __declspec(dllexport)
 #endif
 int ParseArgs(int argc, char* argv[]) {
-  return 1;
+  int app_index = 1;
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "--deferred") == 0 || strcmp(argv[i], "-d") == 0) {
+      utils::SetEnv("CLHK_Deferred=1");
+      ++app_index;
+    } else {
+      break;
+    }
+  }
+  return app_index;
 }
 
 extern "C"
@@ -128,11 +143,20 @@ void EnableProfiling() {
       std::endl;
   }
 
+  ClHarvestMode harvest_mode = HARVEST_MODE_CALLBACK;
+  if (utils::GetEnv("CLHK_Deferred") == "1") {
+    harvest_mode = HARVEST_MODE_DEFERRED;
+  }
+
+  std::chrono::steady_clock::time_point base_time =
+    std::chrono::steady_clock::now();
   if (cpu_device != nullptr) {
-    cpu_collector = ClKernelCollector::Create(cpu_device);
+    cpu_collector = ClKernelCollector::Create(
+        cpu_device, base_time, nullptr, nullptr, harvest_mode);
   }
   if (gpu_device != nullptr) {
-    gpu_collector = ClKernelCollector::Create(gpu_device);
+    gpu_collector = ClKernelCollector::Create(
+        gpu_device, base_time, nullptr, nullptr, harvest_mode);
   }
 
   start = std::chrono::steady_clock::now();
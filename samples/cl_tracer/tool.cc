@@ -38,6 +38,9 @@ void Usage() {
   std::cout <<
     "--chrome-call-logging           Dump host API calls to JSON file" <<
     std::endl;
+  std::cout <<
+    "--binary-trace                  Store Chrome timeline in binary format" <<
+    std::endl;
 }
 
 extern "C"
@@ -69,6 +72,9 @@ int ParseArgs(int argc, char* argv[]) {
     } else if (strcmp(argv[i], "--chrome-call-logging") == 0) {
       utils::SetEnv("CLT_ChromeCallLogging=1");
       ++app_index;
+    } else if (strcmp(argv[i], "--binary-trace") == 0) {
+      utils::SetEnv("CLT_BinaryTrace=1");
+      ++app_index;
     } else {
       break;
     }
@@ -116,6 +122,11 @@ static unsigned ReadArgs() {
     options |= (1 << CLT_CHROME_CALL_LOGGING);
   }
 
+  value = utils::GetEnv("CLT_BinaryTrace");
+  if (!value.empty() && value == "1") {
+    options |= (1 << CLT_BINARY_TRACE);
+  }
+
   return options;
 }
 
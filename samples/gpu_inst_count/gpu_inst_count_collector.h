@@ -12,16 +12,28 @@
 #include <map>
 #include <mutex>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 
-#include "gen_binary_decoder.h"
+#include "counter_sum.h"
+#include "disassembly_cache.h"
 #include "gtpin_utils.h"
+#include "sampling_policy.h"
+#include "timestamp.h"
+
+// Per-run block counts are summed along with their squares, so the error
+// of the count may be estimated if not all the runs are profiled
+struct BlockCount {
+  uint64_t total;
+  double total_squares;
+};
 
 struct KernelData {
   std::string name;
   uint32_t call_count;
+  uint32_t profiled_count;
   std::vector<uint8_t> binary;
-  std::map<int32_t, uint64_t> block_map;
+  std::map<int32_t, BlockCount> block_map;
 };
 
 struct MemoryLocation {
@@ -55,20 +67,32 @@ class GpuInstCountCollector {
       return;
     }
 
+    // Disassembly is the most of the reporting time for large apps
+    utils::DisassemblyCache cache;
     for (auto data : kernel_data_map) {
+      bool sampled = (data.second.profiled_count < data.second.call_count);
+
       std::stringstream ss;
       ss << "=== " << data.second.name << " (runs " <<
-        data.second.call_count  << " times) ===";
+        data.second.call_count  << " times";
+      if (sampled) {
+        ss << ", profiled " << data.second.profiled_count;
+      }
+      ss << ") ===";
       std::string prologue = ss.str();
       std::string epilogue(prologue.size(), '=');
       std::cerr << prologue << std::endl;
 
-      GenBinaryDecoder decoder(data.second.binary, arch);
+      if (data.second.profiled_count == 0) {
+        std::cerr << std::endl;
+        continue;
+      }
 
-      std::vector<Instruction> instruction_list = decoder.Disassemble();
+      std::vector<Instruction> instruction_list =
+        cache.Disassemble(data.second.binary, arch);
       PTI_ASSERT(instruction_list.size() > 0);
 
-      std::vector< std::pair<int32_t, uint64_t> > block_list;
+      std::vector< std::pair<int32_t, BlockCount> > block_list;
       for (auto block : data.second.block_map) {
         block_list.push_back(std::make_pair(block.first, block.second));
       }
@@ -81,12 +105,21 @@ class GpuInstCountCollector {
           ++block_id;
         }
 
-        uint64_t count = block_list[block_id - 1].second /
-          data.second.call_count;
+        // Average over the profiled runs estimates the count of any run
+        const BlockCount& block = block_list[block_id - 1].second;
+        uint64_t count = block.total / data.second.profiled_count;
         std::cerr << "[" << std::setw(10) << std::setfill(' ') << std::dec <<
-          count << "] 0x" << std::setw(4) << std::setfill('0') << std::hex <<
-          std::uppercase << instruction.offset << ": " << instruction.text <<
-          std::endl;
+          count;
+        if (sampled) {
+          utils::SampleEstimate estimate = utils::EstimateMean(
+              static_cast<double>(block.total), block.total_squares,
+              data.second.profiled_count, data.second.call_count);
+          std::cerr << " +-" << std::setw(10) << std::fixed <<
+            std::setprecision(0) << estimate.error;
+        }
+        std::cerr << "] 0x" << std::setw(4) << std::setfill('0') <<
+          std::hex << std::uppercase << instruction.offset << ": " <<
+          instruction.text << std::endl;
       }
 
       std::cerr << std::endl;
@@ -94,7 +127,7 @@ class GpuInstCountCollector {
   }
 
  private: // Implementation Details
-  GpuInstCountCollector() {
+  GpuInstCountCollector() : sampling_policy_(utils::GetSamplingPolicy()) {
     utils::gtpin::KnobAddBool("silent_warnings", false);
 
     if (!utils::GetEnv("PTI_GEN12").empty()) {
@@ -118,13 +151,41 @@ class GpuInstCountCollector {
     kernel_memory_map_[kernel] = kernel_memory_list;
   }
 
-  std::vector<MemoryLocation> GetKernelMemoryList(GTPinKernel kernel) {
+  // Counts the run and tells if it is to be profiled
+  bool SampleKernelRun(GTPinKernel kernel, GTPinKernelExec kernel_exec) {
+    uint64_t time = utils::GetTimestamp();
+    const std::lock_guard<std::mutex> lock(lock_);
+    auto it = kernel_data_map_.find(kernel);
+    PTI_ASSERT(it != kernel_data_map_.end());
+    ++it->second.call_count;
+
+    if (!sampling_policy_.Sample(reinterpret_cast<uint64_t>(kernel), time)) {
+      return false;
+    }
+    PTI_ASSERT(profiled_exec_map_.count(kernel_exec) == 0);
+    profiled_exec_map_[kernel_exec] = time;
+    return true;
+  }
+
+  // Lists are never changed or removed once added, so the pointer stays
+  // valid and the list is read without the lock. Returns nullptr if the
+  // run is not profiled
+  const std::vector<MemoryLocation>* GetProfiledRun(
+      GTPinKernel kernel, GTPinKernelExec kernel_exec, uint64_t* start_time) {
+    PTI_ASSERT(start_time != nullptr);
     const std::lock_guard<std::mutex> lock(lock_);
+    auto exec = profiled_exec_map_.find(kernel_exec);
+    if (exec == profiled_exec_map_.end()) {
+      return nullptr;
+    }
+    *start_time = exec->second;
+    profiled_exec_map_.erase(exec);
+
     auto it = kernel_memory_map_.find(kernel);
     if (it == kernel_memory_map_.end()) {
-      return std::vector<MemoryLocation>();
+      return nullptr;
     }
-    return it->second;
+    return &(it->second);
   }
 
   void AddKernelData(GTPinKernel kernel, const KernelData& kernel_data) {
@@ -133,19 +194,29 @@ class GpuInstCountCollector {
     kernel_data_map_[kernel] = kernel_data;
   }
 
-  void AppendKernelBlockValue(
-      GTPinKernel kernel, int32_t offset, uint64_t value) {
-    PTI_ASSERT(offset >= 0);
+  // Block values are given in the order of the kernel memory list
+  void AppendKernelRun(
+      GTPinKernel kernel,
+      const std::vector<MemoryLocation>& kernel_memory_list,
+      const std::vector<uint64_t>& value_list,
+      uint64_t run_time) {
+    PTI_ASSERT(kernel_memory_list.size() == value_list.size());
     const std::lock_guard<std::mutex> lock(lock_);
-    PTI_ASSERT(kernel_data_map_.count(kernel) == 1);
-    PTI_ASSERT(kernel_data_map_[kernel].block_map.count(offset) == 1);
-    kernel_data_map_[kernel].block_map[offset] += value;
-  }
+    auto it = kernel_data_map_.find(kernel);
+    PTI_ASSERT(it != kernel_data_map_.end());
+
+    std::map<int32_t, BlockCount>& block_map = it->second.block_map;
+    for (size_t i = 0; i < kernel_memory_list.size(); ++i) {
+      PTI_ASSERT(kernel_memory_list[i].offset >= 0);
+      auto block = block_map.find(kernel_memory_list[i].offset);
+      PTI_ASSERT(block != block_map.end());
+      double value = static_cast<double>(value_list[i]);
+      block->second.total += value_list[i];
+      block->second.total_squares += value * value;
+    }
+    it->second.profiled_count += 1;
 
-  void AppendKernelCallCount(GTPinKernel kernel, uint32_t call_count) {
-    const std::lock_guard<std::mutex> lock(lock_);
-    PTI_ASSERT(kernel_data_map_.count(kernel) == 1);
-    kernel_data_map_[kernel].call_count += call_count;
+    sampling_policy_.Complete(reinterpret_cast<uint64_t>(kernel), run_time);
   }
 
  private: // Callbacks
@@ -172,7 +243,7 @@ class GpuInstCountCollector {
       kernel_memory_list.push_back({offset, mem});
 
       PTI_ASSERT(kernel_data.block_map.count(offset) == 0);
-      kernel_data.block_map[offset] = 0;
+      kernel_data.block_map[offset] = {0, 0.0};
     }
 
     uint32_t kernel_binary_size = 0;
@@ -192,6 +263,7 @@ class GpuInstCountCollector {
 
     kernel_data.name = kernel_name;
     kernel_data.call_count = 0;
+    kernel_data.profiled_count = 0;
 
     GpuInstCountCollector* collector =
       reinterpret_cast<GpuInstCountCollector*>(data);
@@ -203,7 +275,15 @@ class GpuInstCountCollector {
 
   static void OnKernelRun(GTPinKernelExec kernel_exec, void* data) {
     GTPINTOOL_STATUS status = GTPINTOOL_STATUS_SUCCESS;
-    GTPin_KernelProfilingActive(kernel_exec, 1);
+
+    GpuInstCountCollector* collector =
+      reinterpret_cast<GpuInstCountCollector*>(data);
+    PTI_ASSERT(collector != nullptr);
+
+    GTPinKernel kernel = GTPin_KernelExec_GetKernel(kernel_exec);
+    bool sampled = collector->SampleKernelRun(kernel, kernel_exec);
+
+    status = GTPin_KernelProfilingActive(kernel_exec, sampled ? 1 : 0);
     PTI_ASSERT(status == GTPINTOOL_STATUS_SUCCESS);
   }
 
@@ -215,30 +295,46 @@ class GpuInstCountCollector {
     PTI_ASSERT(collector != nullptr);
 
     GTPinKernel kernel = GTPin_KernelExec_GetKernel(kernel_exec);
+    uint64_t start_time = 0;
+    const std::vector<MemoryLocation>* kernel_memory_list =
+      collector->GetProfiledRun(kernel, kernel_exec, &start_time);
+    if (kernel_memory_list == nullptr) {
+      return;
+    }
+
+    // Reused between the runs, so nothing is allocated per kernel
+    static thread_local std::vector<uint32_t> sample_list;
+    static thread_local std::vector<uint64_t> value_list;
+    value_list.clear();
 
-    for (auto block : collector->GetKernelMemoryList(kernel)) {
+    for (auto& block : *kernel_memory_list) {
       uint32_t thread_count = GTPin_MemSampleLength(block.location);
       PTI_ASSERT(thread_count > 0);
 
-      uint32_t total = 0, value = 0;
+      // GTPin gives no way to read all the samples at once
+      sample_list.resize(thread_count);
       for (uint32_t tid = 0; tid < thread_count; ++tid) {
-          status = GTPin_MemRead(
-              block.location, tid, sizeof(uint32_t),
-              reinterpret_cast<char*>(&value), nullptr);
-          PTI_ASSERT(status == GTPINTOOL_STATUS_SUCCESS);
-          total += value;
+        status = GTPin_MemRead(
+            block.location, tid, sizeof(uint32_t),
+            reinterpret_cast<char*>(sample_list.data() + tid), nullptr);
+        PTI_ASSERT(status == GTPINTOOL_STATUS_SUCCESS);
       }
 
-      collector->AppendKernelBlockValue(kernel, block.offset, total);
+      value_list.push_back(
+          utils::SumCounters(sample_list.data(), sample_list.size()));
     }
 
-    collector->AppendKernelCallCount(kernel, 1);
+    collector->AppendKernelRun(kernel, *kernel_memory_list, value_list,
+                               utils::GetTimestamp() - start_time);
   }
 
  private: // Data
   KernelMemoryMap kernel_memory_map_;
   KernelDataMap kernel_data_map_;
   std::mutex lock_;
+
+  utils::SamplingPolicy sampling_policy_;
+  std::unordered_map<GTPinKernelExec, uint64_t> profiled_exec_map_;
 };
 
 #endif // PTI_SAMPLES_GPU_INST_COUNT_GPU_INST_COUNT_COLLECTOR_H_
\ No newline at end of file
@@ -16,8 +16,10 @@ __declspec(dllexport)
 #endif
 void Usage() {
   std::cout <<
-    "Usage: ./gpu_inst_count[.exe] <application> <args>" <<
+    "Usage: ./gpu_inst_count[.exe] [options] <application> <args>" <<
     std::endl;
+  std::cout << "Options:" << std::endl;
+  utils::PrintSamplingUsage();
 }
 
 extern "C"
@@ -25,7 +27,16 @@ extern "C"
 __declspec(dllexport)
 #endif
 int ParseArgs(int argc, char* argv[]) {
-  return 1;
+  int app_index = 1;
+  for (int i = 1; i < argc; ) {
+    int count = utils::ParseSamplingArg(argc, argv, i);
+    if (count == 0) {
+      break;
+    }
+    i += count;
+    app_index += count;
+  }
+  return app_index;
 }
 
 extern "C"
@@ -12,10 +12,14 @@
 #include <map>
 #include <mutex>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 
-#include "gen_binary_decoder.h"
+#include "counter_sum.h"
+#include "disassembly_cache.h"
 #include "gtpin_utils.h"
+#include "sampling_policy.h"
+#include "timestamp.h"
 
 struct PerfMonData {
   uint32_t freq;
@@ -24,6 +28,9 @@ struct PerfMonData {
   uint32_t skipped;
 };
 
+static_assert(sizeof(PerfMonData) == 4 * sizeof(uint32_t),
+              "Samples are summed as records of four counters");
+
 struct PerfMonValue {
   uint64_t cycles;
   uint64_t pm;
@@ -32,6 +39,7 @@ struct PerfMonValue {
 struct KernelData {
   std::string name;
   uint32_t call_count;
+  uint32_t profiled_count;
   std::vector<uint8_t> binary;
   std::map<int32_t, PerfMonValue> block_map;
 };
@@ -67,11 +75,11 @@ class GpuPerfMonCollector {
       return;
     }
 
+    // Disassembly is the most of the reporting time for large apps
+    utils::DisassemblyCache cache;
     for (auto data : kernel_data_map) {
-      GenBinaryDecoder decoder(data.second.binary, arch);
-
       std::vector<Instruction> instruction_list =
-        decoder.Disassemble();
+        cache.Disassemble(data.second.binary, arch);
       PTI_ASSERT(instruction_list.size() > 0);
 
       std::vector< std::pair<int32_t, PerfMonValue> > block_list;
@@ -92,8 +100,14 @@ class GpuPerfMonCollector {
       }
 
       std::stringstream ss;
+      // Percentages are ratios of the sums, so they need no scaling if
+      // not all the runs are profiled
       ss << "=== " << data.second.name << " (runs " <<
-        data.second.call_count  << " times) ===";
+        data.second.call_count  << " times";
+      if (data.second.profiled_count < data.second.call_count) {
+        ss << ", profiled " << data.second.profiled_count;
+      }
+      ss << ") ===";
       std::string prologue = ss.str();
       std::string epilogue(prologue.size(), '=');
       std::cerr << prologue << std::endl;
@@ -129,7 +143,7 @@ class GpuPerfMonCollector {
   }
 
  private: // Implementation Details
-  GpuPerfMonCollector() {
+  GpuPerfMonCollector() : sampling_policy_(utils::GetSamplingPolicy()) {
     utils::gtpin::KnobAddBool("silent_warnings", false);
     utils::gtpin::KnobAddInt("allow_sregs", 0);
 
@@ -154,13 +168,41 @@ class GpuPerfMonCollector {
     kernel_memory_map_[kernel] = kernel_memory_list;
   }
 
-  std::vector<MemoryLocation> GetKernelMemoryList(GTPinKernel kernel) {
+  // Counts the run and tells if it is to be profiled
+  bool SampleKernelRun(GTPinKernel kernel, GTPinKernelExec kernel_exec) {
+    uint64_t time = utils::GetTimestamp();
     const std::lock_guard<std::mutex> lock(lock_);
+    auto it = kernel_data_map_.find(kernel);
+    PTI_ASSERT(it != kernel_data_map_.end());
+    ++it->second.call_count;
+
+    if (!sampling_policy_.Sample(reinterpret_cast<uint64_t>(kernel), time)) {
+      return false;
+    }
+    PTI_ASSERT(profiled_exec_map_.count(kernel_exec) == 0);
+    profiled_exec_map_[kernel_exec] = time;
+    return true;
+  }
+
+  // Lists are never changed or removed once added, so the pointer stays
+  // valid and the list is read without the lock. Returns nullptr if the
+  // run is not profiled
+  const std::vector<MemoryLocation>* GetProfiledRun(
+      GTPinKernel kernel, GTPinKernelExec kernel_exec, uint64_t* start_time) {
+    PTI_ASSERT(start_time != nullptr);
+    const std::lock_guard<std::mutex> lock(lock_);
+    auto exec = profiled_exec_map_.find(kernel_exec);
+    if (exec == profiled_exec_map_.end()) {
+      return nullptr;
+    }
+    *start_time = exec->second;
+    profiled_exec_map_.erase(exec);
+
     auto it = kernel_memory_map_.find(kernel);
     if (it == kernel_memory_map_.end()) {
-      return std::vector<MemoryLocation>();
+      return nullptr;
     }
-    return it->second;
+    return &(it->second);
   }
 
   void AddKernelData(GTPinKernel kernel, const KernelData& kernel_data) {
@@ -169,20 +211,28 @@ class GpuPerfMonCollector {
     kernel_data_map_[kernel] = kernel_data;
   }
 
-  void AppendKernelBlockValue(
-      GTPinKernel kernel, int32_t offset, PerfMonValue value) {
-    PTI_ASSERT(offset >= 0);
+  // Block values are given in the order of the kernel memory list
+  void AppendKernelRun(
+      GTPinKernel kernel,
+      const std::vector<MemoryLocation>& kernel_memory_list,
+      const std::vector<PerfMonValue>& value_list,
+      uint64_t run_time) {
+    PTI_ASSERT(kernel_memory_list.size() == value_list.size());
     const std::lock_guard<std::mutex> lock(lock_);
-    PTI_ASSERT(kernel_data_map_.count(kernel) == 1);
-    PTI_ASSERT(kernel_data_map_[kernel].block_map.count(offset) == 1);
-    kernel_data_map_[kernel].block_map[offset].cycles += value.cycles;
-    kernel_data_map_[kernel].block_map[offset].pm += value.pm;
-  }
+    auto it = kernel_data_map_.find(kernel);
+    PTI_ASSERT(it != kernel_data_map_.end());
+
+    std::map<int32_t, PerfMonValue>& block_map = it->second.block_map;
+    for (size_t i = 0; i < kernel_memory_list.size(); ++i) {
+      PTI_ASSERT(kernel_memory_list[i].offset >= 0);
+      auto block = block_map.find(kernel_memory_list[i].offset);
+      PTI_ASSERT(block != block_map.end());
+      block->second.cycles += value_list[i].cycles;
+      block->second.pm += value_list[i].pm;
+    }
+    it->second.profiled_count += 1;
 
-  void AppendKernelCallCount(GTPinKernel kernel, uint32_t call_count) {
-    const std::lock_guard<std::mutex> lock(lock_);
-    PTI_ASSERT(kernel_data_map_.count(kernel) == 1);
-    kernel_data_map_[kernel].call_count += call_count;
+    sampling_policy_.Complete(reinterpret_cast<uint64_t>(kernel), run_time);
   }
 
  private: // Callbacks
@@ -252,6 +302,7 @@ class GpuPerfMonCollector {
 
     kernel_data.name = kernel_name;
     kernel_data.call_count = 0;
+    kernel_data.profiled_count = 0;
 
     GpuPerfMonCollector* collector =
       reinterpret_cast<GpuPerfMonCollector*>(data);
@@ -263,7 +314,15 @@ class GpuPerfMonCollector {
 
   static void OnKernelRun(GTPinKernelExec kernelExec, void* data) {
     GTPINTOOL_STATUS status = GTPINTOOL_STATUS_SUCCESS;
-    GTPin_KernelProfilingActive(kernelExec, 1);
+
+    GpuPerfMonCollector* collector =
+      reinterpret_cast<GpuPerfMonCollector*>(data);
+    PTI_ASSERT(collector != nullptr);
+
+    GTPinKernel kernel = GTPin_KernelExec_GetKernel(kernelExec);
+    bool sampled = collector->SampleKernelRun(kernel, kernelExec);
+
+    status = GTPin_KernelProfilingActive(kernelExec, sampled ? 1 : 0);
     PTI_ASSERT(status == GTPINTOOL_STATUS_SUCCESS);
   }
 
@@ -275,33 +334,49 @@ class GpuPerfMonCollector {
     PTI_ASSERT(collector != nullptr);
 
     GTPinKernel kernel = GTPin_KernelExec_GetKernel(kernelExec);
+    uint64_t start_time = 0;
+    const std::vector<MemoryLocation>* kernel_memory_list =
+      collector->GetProfiledRun(kernel, kernelExec, &start_time);
+    if (kernel_memory_list == nullptr) {
+      return;
+    }
+
+    // Reused between the runs, so nothing is allocated per kernel
+    static thread_local std::vector<PerfMonData> sample_list;
+    static thread_local std::vector<PerfMonValue> value_list;
+    value_list.clear();
 
-    for (auto block : collector->GetKernelMemoryList(kernel)) {
+    for (auto& block : *kernel_memory_list) {
       uint32_t thread_count = GTPin_MemSampleLength(block.location);
       PTI_ASSERT(thread_count > 0);
 
-      uint64_t total_cycles = 0, total_pm = 0;
-      PerfMonData value{};
+      // GTPin gives no way to read all the samples at once
+      sample_list.resize(thread_count);
       for (uint32_t tid = 0; tid < thread_count; ++tid) {
-          status = GTPin_MemRead(
-              block.location, tid, sizeof(PerfMonData),
-              reinterpret_cast<char*>(&value), nullptr);
-          PTI_ASSERT(status == GTPINTOOL_STATUS_SUCCESS);
-          total_cycles += value.cycles;
-          total_pm += value.pm;
+        status = GTPin_MemRead(
+            block.location, tid, sizeof(PerfMonData),
+            reinterpret_cast<char*>(sample_list.data() + tid), nullptr);
+        PTI_ASSERT(status == GTPINTOOL_STATUS_SUCCESS);
       }
 
-      collector->AppendKernelBlockValue(
-          kernel, block.offset, {total_cycles, total_pm});
+      uint64_t sum_list[4] = {0, 0, 0, 0};
+      utils::SumCounterRecords(
+          reinterpret_cast<const uint32_t*>(sample_list.data()),
+          sample_list.size(), sum_list);
+      value_list.push_back({sum_list[1], sum_list[2]}); // cycles, pm
     }
 
-    collector->AppendKernelCallCount(kernel, 1);
+    collector->AppendKernelRun(kernel, *kernel_memory_list, value_list,
+                               utils::GetTimestamp() - start_time);
   }
 
  private: // Data
   KernelMemoryMap kernel_memory_map_;
   KernelDataMap kernel_data_map_;
   std::mutex lock_;
+
+  utils::SamplingPolicy sampling_policy_;
+  std::unordered_map<GTPinKernelExec, uint64_t> profiled_exec_map_;
 };
 
 #endif // PTI_SAMPLES_GPU_PERFMON_READ_GPU_INST_COUNT_COLLECTOR_H_
\ No newline at end of file
@@ -0,0 +1,250 @@
+//==============================================================
+// Copyright (C) Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#ifndef PTI_SAMPLES_OMP_HOT_REGIONS_OMP_DEVICE_TRACER_H_
+#define PTI_SAMPLES_OMP_HOT_REGIONS_OMP_DEVICE_TRACER_H_
+
+#include <stdint.h>
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <omp-tools.h>
+
+#include "omp_region_collector.h"
+#include "omp_trace_parser.h"
+#include "pti_assert.h"
+
+struct OmpTraceDevice {
+  ompt_device_t* device;
+  ompt_stop_trace_t stop_trace;
+  ompt_get_record_ompt_t get_record_ompt;
+  ompt_advance_buffer_cursor_t advance_buffer_cursor;
+  OmpTraceParser* parser;
+  bool active;
+};
+
+struct OmpTraceBuffer {
+  int device_num;
+  ompt_buffer_t* buffer;
+  size_t size;
+  ompt_buffer_cursor_t begin;
+  bool owned;
+};
+
+// Device tracing mode: the runtime writes target region and data transfer
+// records into the buffers given by the tool, while complete buffers are
+// parsed on the worker thread, so application threads pay no callback
+// per event. Each device is parsed into its own region table
+class OmpDeviceTracer {
+ public: // User Interface
+  OmpDeviceTracer(OmpRegionCollector* collector) : collector_(collector) {
+    PTI_ASSERT(collector_ != nullptr);
+    active_ = true;
+    worker_thread_ = std::thread(Run, this);
+  }
+
+  // Stops tracing on the devices that are still active and waits for the
+  // rest of the buffers to be parsed
+  ~OmpDeviceTracer() {
+    std::vector<int> device_list;
+    {
+      const std::lock_guard<std::mutex> lock(lock_);
+      for (auto& value : device_map_) {
+        if (value.second->active) {
+          device_list.push_back(value.first);
+        }
+      }
+    }
+    for (auto device_num : device_list) {
+      RemoveDevice(device_num);
+    }
+
+    {
+      const std::lock_guard<std::mutex> lock(queue_lock_);
+      active_ = false;
+    }
+    condition_.notify_one();
+    worker_thread_.join();
+
+    for (auto& value : device_map_) {
+      delete value.second->parser;
+      delete value.second;
+    }
+  }
+
+  // Expected to be called on device initialization, buffer callbacks are
+  // to forward to RequestBuffer() and CompleteBuffer()
+  bool AddDevice(int device_num, ompt_device_t* device,
+                 ompt_function_lookup_t lookup,
+                 ompt_callback_buffer_request_t request,
+                 ompt_callback_buffer_complete_t complete) {
+    PTI_ASSERT(lookup != nullptr);
+    PTI_ASSERT(request != nullptr && complete != nullptr);
+
+    ompt_set_trace_ompt_t set_trace_ompt =
+      reinterpret_cast<ompt_set_trace_ompt_t>(lookup("ompt_set_trace_ompt"));
+    ompt_start_trace_t start_trace =
+      reinterpret_cast<ompt_start_trace_t>(lookup("ompt_start_trace"));
+    ompt_stop_trace_t stop_trace =
+      reinterpret_cast<ompt_stop_trace_t>(lookup("ompt_stop_trace"));
+    ompt_get_record_ompt_t get_record_ompt =
+      reinterpret_cast<ompt_get_record_ompt_t>(lookup("ompt_get_record_ompt"));
+    ompt_advance_buffer_cursor_t advance_buffer_cursor =
+      reinterpret_cast<ompt_advance_buffer_cursor_t>(
+          lookup("ompt_advance_buffer_cursor"));
+    ompt_translate_time_t translate_time =
+      reinterpret_cast<ompt_translate_time_t>(lookup("ompt_translate_time"));
+    if (set_trace_ompt == nullptr || start_trace == nullptr ||
+        stop_trace == nullptr || get_record_ompt == nullptr ||
+        advance_buffer_cursor == nullptr) {
+      return false;
+    }
+
+    // Runtime may support either pre-5.1 or 5.1 record types
+    bool enabled = false;
+    for (auto type : {ompt_callback_target, ompt_callback_target_emi,
+                      ompt_callback_target_data_op,
+                      ompt_callback_target_data_op_emi}) {
+      ompt_set_result_t result = set_trace_ompt(device, 1, type);
+      if (result != ompt_set_error && result != ompt_set_never) {
+        enabled = true;
+      }
+    }
+    if (!enabled) {
+      return false;
+    }
+
+    OmpTraceParser* parser = new OmpTraceParser(
+        collector_->CreateThreadTable(), device, translate_time);
+    PTI_ASSERT(parser != nullptr);
+    OmpTraceDevice* trace_device = new OmpTraceDevice{
+        device, stop_trace, get_record_ompt, advance_buffer_cursor,
+        parser, true};
+    PTI_ASSERT(trace_device != nullptr);
+    {
+      const std::lock_guard<std::mutex> lock(lock_);
+      PTI_ASSERT(device_map_.count(device_num) == 0);
+      device_map_[device_num] = trace_device;
+    }
+
+    if (!start_trace(device, request, complete)) {
+      const std::lock_guard<std::mutex> lock(lock_);
+      trace_device->active = false;
+      return false;
+    }
+    return true;
+  }
+
+  // Remaining records are delivered on stop with buffer complete callback
+  void RemoveDevice(int device_num) {
+    OmpTraceDevice* trace_device = nullptr;
+    {
+      const std::lock_guard<std::mutex> lock(lock_);
+      auto it = device_map_.find(device_num);
+      if (it == device_map_.end() || !it->second->active) {
+        return;
+      }
+      trace_device = it->second;
+      trace_device->active = false;
+    }
+    trace_device->stop_trace(trace_device->device);
+  }
+
+  void RequestBuffer(ompt_buffer_t** buffer, size_t* size) {
+    PTI_ASSERT(buffer != nullptr && size != nullptr);
+    *buffer = new uint8_t[kBufferSize];
+    PTI_ASSERT(*buffer != nullptr);
+    *size = kBufferSize;
+  }
+
+  void CompleteBuffer(int device_num, ompt_buffer_t* buffer, size_t size,
+                      ompt_buffer_cursor_t begin, int owned) {
+    {
+      const std::lock_guard<std::mutex> lock(queue_lock_);
+      buffer_list_.push_back(
+          {device_num, buffer, size, begin, owned != 0});
+    }
+    condition_.notify_one();
+  }
+
+  OmpDeviceTracer(const OmpDeviceTracer& copy) = delete;
+  OmpDeviceTracer& operator=(const OmpDeviceTracer& copy) = delete;
+
+ private: // Implementation Details
+  void ProcessBuffer(const OmpTraceBuffer& buffer) {
+    OmpTraceDevice* trace_device = nullptr;
+    {
+      const std::lock_guard<std::mutex> lock(lock_);
+      auto it = device_map_.find(buffer.device_num);
+      PTI_ASSERT(it != device_map_.end());
+      trace_device = it->second;
+    }
+
+    ompt_buffer_cursor_t cursor = buffer.begin;
+    while (buffer.size > 0) {
+      ompt_record_ompt_t* record =
+        trace_device->get_record_ompt(buffer.buffer, cursor);
+      if (record == nullptr) {
+        break;
+      }
+      trace_device->parser->Parse(*record);
+
+      ompt_buffer_cursor_t next = 0;
+      if (!trace_device->advance_buffer_cursor(
+              trace_device->device, buffer.buffer, buffer.size,
+              cursor, &next)) {
+        break;
+      }
+      cursor = next;
+    }
+
+    if (buffer.owned) {
+      delete[] static_cast<uint8_t*>(buffer.buffer);
+    }
+  }
+
+  // Keeps parsing till the tracer is destroyed and the queue is empty
+  static void Run(OmpDeviceTracer* tracer) {
+    PTI_ASSERT(tracer != nullptr);
+    std::vector<OmpTraceBuffer> buffer_list;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(tracer->queue_lock_);
+        tracer->condition_.wait(lock, [tracer] {
+            return !tracer->buffer_list_.empty() || !tracer->active_; });
+        if (tracer->buffer_list_.empty()) {
+          break;
+        }
+        buffer_list.swap(tracer->buffer_list_);
+      }
+
+      for (auto& buffer : buffer_list) {
+        tracer->ProcessBuffer(buffer);
+      }
+      buffer_list.clear();
+    }
+  }
+
+ private: // Data
+  OmpRegionCollector* collector_;
+
+  std::mutex lock_;
+  std::map<int, OmpTraceDevice*> device_map_;
+
+  std::thread worker_thread_;
+  std::mutex queue_lock_;
+  std::condition_variable condition_;
+  std::vector<OmpTraceBuffer> buffer_list_;
+  bool active_ = false;
+
+  static const size_t kBufferSize = 1 << 20;
+};
+
+#endif // PTI_SAMPLES_OMP_HOT_REGIONS_OMP_DEVICE_TRACER_H_
\ No newline at end of file
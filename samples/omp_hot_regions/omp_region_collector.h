@@ -13,6 +13,8 @@
 #include <mutex>
 #include <set>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include "pti_assert.h"
 #include "utils.h"
@@ -49,37 +51,100 @@ struct RegionInfo {
 
 using RegionMap = std::map<uint64_t, RegionInfo>;
 
+// Region statistics of a single thread. It is updated by the owning
+// thread only, so no locking is needed on region end
+class OmpRegionTable {
+ public: // User Interface
+  void AddRegion(
+      uint64_t ra, RegionType type, uint64_t time, size_t bytes_transferred) {
+    uint64_t id = ra + type;
+    RegionInfo info{type, time, time, time, 1, bytes_transferred};
+    if (last_region_ != nullptr && id == last_id_) {
+      Merge(*last_region_, info);
+      return;
+    }
+
+    auto result = region_map_.emplace(id, info);
+    if (!result.second) {
+      Merge(result.first->second, info);
+    }
+    // Map nodes are never moved, so the pointer stays valid
+    last_id_ = id;
+    last_region_ = &result.first->second;
+  }
+
+  // Begin timestamps for the regions without ompt_data_t to keep them
+  void PushTimestamp(uint64_t timestamp) {
+    time_stack_.push_back(timestamp);
+  }
+
+  uint64_t PopTimestamp() {
+    PTI_ASSERT(!time_stack_.empty());
+    uint64_t timestamp = time_stack_.back();
+    time_stack_.pop_back();
+    return timestamp;
+  }
+
+  static void Merge(RegionInfo& region, const RegionInfo& info) {
+    PTI_ASSERT(region.type == info.type);
+    region.total_time += info.total_time;
+    if (info.min_time < region.min_time) {
+      region.min_time = info.min_time;
+    }
+    if (info.max_time > region.max_time) {
+      region.max_time = info.max_time;
+    }
+    region.call_count += info.call_count;
+    region.bytes_transferred += info.bytes_transferred;
+  }
+
+ private: // Data
+  friend class OmpRegionCollector;
+
+  std::unordered_map<uint64_t, RegionInfo> region_map_;
+  std::vector<uint64_t> time_stack_;
+
+  // The same region usually ends many times in a row
+  uint64_t last_id_ = 0;
+  RegionInfo* last_region_ = nullptr;
+};
+
 class OmpRegionCollector {
  public: // Interface
   static OmpRegionCollector* Create() {
     return new OmpRegionCollector();
   }
 
-  ~OmpRegionCollector() {}
+  ~OmpRegionCollector() {
+    for (auto table : table_list_) {
+      delete table;
+    }
+  }
 
-  void AddRegion(
-      uint64_t ra, RegionType type, uint64_t time, size_t bytes_transferred) {
+  // Tables are owned by the collector, so statistics of the finished
+  // threads are kept till the end
+  OmpRegionTable* CreateThreadTable() {
+    OmpRegionTable* table = new OmpRegionTable;
+    PTI_ASSERT(table != nullptr);
     const std::lock_guard<std::mutex> lock(lock_);
-    uint64_t id = ra + type;
-    if (region_map_.count(id) == 0) {
-      region_map_[id] = {type, time, time, time, 1, bytes_transferred};
-    } else {
-      RegionInfo& region = region_map_[id];
-      PTI_ASSERT(region.type == type);
-      region.total_time += time;
-      if (time < region.min_time) {
-        region.min_time = time;
-      }
-      if (time > region.max_time) {
-        region.max_time = time;
-      }
-      region.call_count += 1;
-      region.bytes_transferred += bytes_transferred;
-    }
+    table_list_.push_back(table);
+    return table;
   }
 
-  const RegionMap& GetRegionMap() const {
-    return region_map_;
+  // Merges the tables of all the threads, expected to be called once
+  // the regions are done (e.g. at ompt_finalize)
+  RegionMap GetRegionMap() const {
+    const std::lock_guard<std::mutex> lock(lock_);
+    RegionMap region_map;
+    for (auto table : table_list_) {
+      for (auto& value : table->region_map_) {
+        auto result = region_map.insert(value);
+        if (!result.second) {
+          OmpRegionTable::Merge(result.first->second, value.second);
+        }
+      }
+    }
+    return region_map;
   }
 
   static void PrintRegionTable(const RegionMap& region_map) {
@@ -152,8 +217,8 @@ class OmpRegionCollector {
   }
 
  private: // Data
-  RegionMap region_map_;
-  std::mutex lock_;
+  std::vector<OmpRegionTable*> table_list_;
+  mutable std::mutex lock_;
 
   static const uint32_t kRegionIDLength = 20;
   static const uint32_t kRegionTypeLength = 20;
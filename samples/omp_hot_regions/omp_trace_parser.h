@@ -0,0 +1,106 @@
+//==============================================================
+// Copyright (C) Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#ifndef PTI_SAMPLES_OMP_HOT_REGIONS_OMP_TRACE_PARSER_H_
+#define PTI_SAMPLES_OMP_HOT_REGIONS_OMP_TRACE_PARSER_H_
+
+#include <unordered_map>
+
+#include <omp-tools.h>
+
+#include "omp_region_collector.h"
+#include "pti_assert.h"
+#include "utils.h"
+
+// Turns OMPT device trace records into region statistics. It depends
+// neither on the runtime nor on the trace buffer layout: records are
+// given one by one, so synthetic ompt_record_ompt_t values may be used.
+// Device time is translated with the given function if any, otherwise
+// it is taken as nanoseconds
+class OmpTraceParser {
+ public: // User Interface
+  OmpTraceParser(OmpRegionTable* table,
+                 ompt_device_t* device = nullptr,
+                 ompt_translate_time_t translate_time = nullptr)
+      : table_(table), device_(device), translate_time_(translate_time) {
+    PTI_ASSERT(table_ != nullptr);
+  }
+
+  void Parse(const ompt_record_ompt_t& record) {
+    switch (record.type) {
+      case ompt_callback_target:
+      case ompt_callback_target_emi:
+        ParseTarget(record.record.target, record.time);
+        break;
+      case ompt_callback_target_data_op:
+      case ompt_callback_target_data_op_emi:
+        ParseDataOp(record.record.target_data_op, record.time);
+        break;
+      default: // Other records are not collected
+        break;
+    }
+  }
+
+ private: // Implementation Details
+  void ParseTarget(const ompt_record_target_t& target,
+                   ompt_device_time_t time) {
+    if (target.kind != ompt_target) {
+      return;
+    }
+
+    if (target.endpoint == ompt_scope_begin) {
+      target_map_[target.target_id] = time;
+      return;
+    }
+
+    auto it = target_map_.find(target.target_id);
+    if (it == target_map_.end()) { // Begin was lost with the buffer
+      return;
+    }
+    table_->AddRegion(
+        reinterpret_cast<uint64_t>(target.codeptr_ra),
+        REGION_TYPE_TARGET, GetDuration(it->second, time), 0);
+    target_map_.erase(it);
+  }
+
+  void ParseDataOp(const ompt_record_target_data_op_t& data_op,
+                   ompt_device_time_t time) {
+    RegionType type;
+    if (data_op.optype == ompt_target_data_transfer_to_device) {
+      type = REGION_TYPE_TRANSFER_TO_DEVICE;
+    } else if (data_op.optype == ompt_target_data_transfer_from_device) {
+      type = REGION_TYPE_TRANSFER_FROM_DEVICE;
+    } else {
+      return;
+    }
+
+    table_->AddRegion(
+        reinterpret_cast<uint64_t>(data_op.codeptr_ra), type,
+        GetDuration(time, data_op.end_time), data_op.bytes);
+  }
+
+  uint64_t GetDuration(ompt_device_time_t start,
+                       ompt_device_time_t end) const {
+    if (translate_time_ == nullptr) {
+      PTI_ASSERT(start <= end);
+      return end - start;
+    }
+
+    // Translated time is in seconds
+    double duration =
+      translate_time_(device_, end) - translate_time_(device_, start);
+    PTI_ASSERT(duration >= 0.0);
+    return static_cast<uint64_t>(duration * NSEC_IN_SEC + 0.5);
+  }
+
+ private: // Data
+  OmpRegionTable* table_;
+  ompt_device_t* device_;
+  ompt_translate_time_t translate_time_;
+  std::unordered_map<ompt_id_t, ompt_device_time_t> target_map_;
+};
+
+#endif // PTI_SAMPLES_OMP_HOT_REGIONS_OMP_TRACE_PARSER_H_
\ No newline at end of file
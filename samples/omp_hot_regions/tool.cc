@@ -5,52 +5,118 @@
 // =============================================================
 
 #include <chrono>
-#include <stack>
 
 #include <omp-tools.h>
 
+#include "omp_device_tracer.h"
 #include "omp_region_collector.h"
-
-using TimePoint = std::chrono::time_point<std::chrono::steady_clock>;
-static thread_local std::stack<TimePoint> time_point;
+#include "timestamp.h"
 
 static OmpRegionCollector* collector = nullptr;
+static OmpDeviceTracer* tracer = nullptr;
 static std::chrono::steady_clock::time_point start;
 
+static ompt_get_thread_data_t get_thread_data = nullptr;
+
 // Internal Tool Functionality ////////////////////////////////////////////////
 
-static void PushTimestamp() {
-  time_point.push(std::chrono::steady_clock::now());
+static uint64_t GetDuration(uint64_t start) {
+  uint64_t end = utils::GetTimestamp();
+  PTI_ASSERT(start <= end);
+  return end - start;
 }
 
-static uint64_t PopTimestamp() {
-  TimePoint end = std::chrono::steady_clock::now();
+// Thread tables are normally created on thread begin, the rest is for
+// the threads started before the tool was initialized
+static OmpRegionTable* GetThreadTable() {
+  PTI_ASSERT(get_thread_data != nullptr);
+  ompt_data_t* thread_data = get_thread_data();
+  PTI_ASSERT(thread_data != nullptr);
+  if (thread_data->ptr == nullptr) {
+    PTI_ASSERT(collector != nullptr);
+    thread_data->ptr = collector->CreateThreadTable();
+  }
+  return static_cast<OmpRegionTable*>(thread_data->ptr);
+}
 
-  PTI_ASSERT(time_point.size() > 0);
-  TimePoint start = time_point.top();
-  time_point.pop();
+static void AddTransfer(
+    ompt_target_data_op_t optype, const void* codeptr_ra,
+    uint64_t time, size_t bytes) {
+  if (optype == ompt_target_data_transfer_to_device) {
+    GetThreadTable()->AddRegion(
+        reinterpret_cast<uint64_t>(codeptr_ra),
+        REGION_TYPE_TRANSFER_TO_DEVICE, time, bytes);
+  } else if (optype == ompt_target_data_transfer_from_device) {
+    GetThreadTable()->AddRegion(
+        reinterpret_cast<uint64_t>(codeptr_ra),
+        REGION_TYPE_TRANSFER_FROM_DEVICE, time, bytes);
+  }
+}
 
-  std::chrono::duration<uint64_t, std::nano> time = end - start;
-  return time.count();
+static void ThreadBegin(ompt_thread_t thread_type, ompt_data_t* thread_data) {
+  PTI_ASSERT(thread_data != nullptr);
+  PTI_ASSERT(collector != nullptr);
+  thread_data->ptr = collector->CreateThreadTable();
 }
 
 static void ParallelBegin(
     ompt_data_t* task_data, const ompt_frame_t* task_frame,
     ompt_data_t* parallel_data, unsigned int requested_parallelism,
     int flags, const void* codeptr_ra) {
-  PushTimestamp();
+  PTI_ASSERT(parallel_data != nullptr);
+  parallel_data->value = utils::GetTimestamp();
 }
 
 static void ParallelEnd(
     ompt_data_t* parallel_data, ompt_data_t* task_data,
     int flags, const void* codeptr_ra) {
-  uint64_t time = PopTimestamp();
-  PTI_ASSERT(collector != nullptr);
-  collector->AddRegion(
+  PTI_ASSERT(parallel_data != nullptr);
+  uint64_t time = GetDuration(parallel_data->value);
+  GetThreadTable()->AddRegion(
       reinterpret_cast<uint64_t>(codeptr_ra),
       REGION_TYPE_PARALLEL, time, 0);
 }
 
+// OpenMP 5.1 target callbacks give the place for the begin timestamp
+static void TargetEmi(
+    ompt_target_t kind, ompt_scope_endpoint_t endpoint,
+    int device_num, ompt_data_t* task_data,
+    ompt_data_t* target_task_data, ompt_data_t* target_data,
+    const void* codeptr_ra) {
+  if (kind != ompt_target) {
+    return;
+  }
+
+  PTI_ASSERT(target_data != nullptr);
+  if (endpoint == ompt_scope_begin) {
+    target_data->value = utils::GetTimestamp();
+  } else {
+    uint64_t time = GetDuration(target_data->value);
+    GetThreadTable()->AddRegion(
+        reinterpret_cast<uint64_t>(codeptr_ra),
+        REGION_TYPE_TARGET, time, 0);
+  }
+}
+
+// Host operation ID is set by the tool, so it keeps the begin timestamp
+static void TargetDataOpEmi(
+    ompt_scope_endpoint_t endpoint, ompt_data_t* target_task_data,
+    ompt_data_t* target_data, ompt_id_t* host_op_id,
+    ompt_target_data_op_t optype,
+    void *src_addr, int src_device_num,
+    void *dest_addr, int dest_device_num,
+    size_t bytes, const void *codeptr_ra) {
+  if (optype == ompt_target_data_transfer_to_device ||
+      optype == ompt_target_data_transfer_from_device) {
+    PTI_ASSERT(host_op_id != nullptr);
+    if (endpoint == ompt_scope_begin) {
+      *host_op_id = utils::GetTimestamp();
+    } else {
+      AddTransfer(optype, codeptr_ra, GetDuration(*host_op_id), bytes);
+    }
+  }
+}
+
 static void Target(
     ompt_target_t kind, ompt_scope_endpoint_t endpoint,
     int device_num, ompt_data_t* task_data,
@@ -59,12 +125,12 @@ static void Target(
     return;
   }
 
+  OmpRegionTable* table = GetThreadTable();
   if (endpoint == ompt_scope_begin) {
-    PushTimestamp();
+    table->PushTimestamp(utils::GetTimestamp());
   } else {
-    uint64_t time = PopTimestamp();
-    PTI_ASSERT(collector != nullptr);
-    collector->AddRegion(
+    uint64_t time = GetDuration(table->PopTimestamp());
+    table->AddRegion(
         reinterpret_cast<uint64_t>(codeptr_ra),
         REGION_TYPE_TARGET, time, 0);
   }
@@ -78,30 +144,51 @@ static void TargetDataOp(
     size_t bytes, const void *codeptr_ra) {
   if (optype == ompt_target_data_transfer_to_device ||
       optype == ompt_target_data_transfer_from_device) {
+    OmpRegionTable* table = GetThreadTable();
     if (endpoint == ompt_scope_begin) {
-      PushTimestamp();
+      table->PushTimestamp(utils::GetTimestamp());
     } else {
-      uint64_t time = PopTimestamp();
-      PTI_ASSERT(collector != nullptr);
-      if (optype == ompt_target_data_transfer_to_device) {
-        collector->AddRegion(
-            reinterpret_cast<uint64_t>(codeptr_ra),
-            REGION_TYPE_TRANSFER_TO_DEVICE, time, bytes);
-      } else if (optype == ompt_target_data_transfer_from_device) {
-        collector->AddRegion(
-            reinterpret_cast<uint64_t>(codeptr_ra),
-            REGION_TYPE_TRANSFER_FROM_DEVICE, time, bytes);
-      }
+      AddTransfer(
+          optype, codeptr_ra, GetDuration(table->PopTimestamp()), bytes);
     }
   }
 }
 
+static void BufferRequest(
+    int device_num, ompt_buffer_t** buffer, size_t* bytes) {
+  PTI_ASSERT(tracer != nullptr);
+  tracer->RequestBuffer(buffer, bytes);
+}
+
+static void BufferComplete(
+    int device_num, ompt_buffer_t* buffer, size_t bytes,
+    ompt_buffer_cursor_t begin, int buffer_owned) {
+  PTI_ASSERT(tracer != nullptr);
+  tracer->CompleteBuffer(device_num, buffer, bytes, begin, buffer_owned);
+}
+
+static void DeviceInitialize(
+    int device_num, const char* type, ompt_device_t* device,
+    ompt_function_lookup_t lookup, const char* documentation) {
+  PTI_ASSERT(tracer != nullptr);
+  if (!tracer->AddDevice(
+          device_num, device, lookup, BufferRequest, BufferComplete)) {
+    std::cerr << "[WARNING] Unable to trace OpenMP device " <<
+      device_num << std::endl;
+  }
+}
+
+static void DeviceFinalize(int device_num) {
+  PTI_ASSERT(tracer != nullptr);
+  tracer->RemoveDevice(device_num);
+}
+
 static void PrintResults() {
   std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
   std::chrono::duration<uint64_t, std::nano> time = end - start;
 
   PTI_ASSERT(collector != nullptr);
-  const RegionMap& region_map = collector->GetRegionMap();
+  RegionMap region_map = collector->GetRegionMap();
   if (region_map.size() == 0) {
     return;
   }
@@ -137,8 +224,24 @@ static int Initialize(
     return 0;
   }
 
+  get_thread_data =
+    reinterpret_cast<ompt_get_thread_data_t>(lookup("ompt_get_thread_data"));
+  if (get_thread_data == nullptr) {
+    std::cerr << "[WARNING] Unable to create OpenMP region collector" <<
+      std::endl;
+    return 0;
+  }
+
+  PTI_ASSERT(collector == nullptr);
+  collector = OmpRegionCollector::Create();
+  PTI_ASSERT(collector != nullptr);
+
   ompt_set_result_t result = ompt_set_error;
 
+  result = ompt_set_callback(ompt_callback_thread_begin,
+    reinterpret_cast<ompt_callback_t>(ThreadBegin));
+  PTI_ASSERT(result == ompt_set_always);
+
   result = ompt_set_callback(ompt_callback_parallel_begin,
     reinterpret_cast<ompt_callback_t>(ParallelBegin));
   PTI_ASSERT(result == ompt_set_always);
@@ -146,17 +249,37 @@ static int Initialize(
     reinterpret_cast<ompt_callback_t>(ParallelEnd));
   PTI_ASSERT(result == ompt_set_always);
 
-  result = ompt_set_callback(ompt_callback_target,
-    reinterpret_cast<ompt_callback_t>(Target));
-  PTI_ASSERT(result == ompt_set_always);
-  result = ompt_set_callback(ompt_callback_target_data_op,
-    reinterpret_cast<ompt_callback_t>(TargetDataOp));
-  PTI_ASSERT(result == ompt_set_always);
-
-  PTI_ASSERT(collector == nullptr);
+  if (utils::GetEnv("OMPHR_DeviceTracing") == "1") {
+    // Target regions and transfers come from device trace buffers
+    PTI_ASSERT(tracer == nullptr);
+    tracer = new OmpDeviceTracer(collector);
+    PTI_ASSERT(tracer != nullptr);
+
+    result = ompt_set_callback(ompt_callback_device_initialize,
+      reinterpret_cast<ompt_callback_t>(DeviceInitialize));
+    PTI_ASSERT(result == ompt_set_always || result == ompt_set_never);
+    result = ompt_set_callback(ompt_callback_device_finalize,
+      reinterpret_cast<ompt_callback_t>(DeviceFinalize));
+    PTI_ASSERT(result == ompt_set_always || result == ompt_set_never);
+  } else {
+    // Older runtimes support pre-5.1 target callbacks only, while
+    // host-only ones support none of them
+    result = ompt_set_callback(ompt_callback_target_emi,
+      reinterpret_cast<ompt_callback_t>(TargetEmi));
+    if (result != ompt_set_always) {
+      result = ompt_set_callback(ompt_callback_target,
+        reinterpret_cast<ompt_callback_t>(Target));
+    }
+    PTI_ASSERT(result == ompt_set_always || result == ompt_set_never);
+    result = ompt_set_callback(ompt_callback_target_data_op_emi,
+      reinterpret_cast<ompt_callback_t>(TargetDataOpEmi));
+    if (result != ompt_set_always) {
+      result = ompt_set_callback(ompt_callback_target_data_op,
+        reinterpret_cast<ompt_callback_t>(TargetDataOp));
+    }
+    PTI_ASSERT(result == ompt_set_always || result == ompt_set_never);
+  }
 
-  collector = OmpRegionCollector::Create();
-  PTI_ASSERT(collector != nullptr);
   start = std::chrono::steady_clock::now();
 
   return 1;
@@ -169,6 +292,11 @@ static void Finalize(ompt_data_t* data) {
     delete result;
   }
 
+  if (tracer != nullptr) { // Waits for the rest of trace records
+    delete tracer;
+    tracer = nullptr;
+  }
+
   if (collector != nullptr) {
     PrintResults();
     delete collector;
@@ -0,0 +1,109 @@
+//==============================================================
+// Copyright (C) Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#ifndef PTI_SAMPLES_UTILS_BUFFER_RING_H_
+#define PTI_SAMPLES_UTILS_BUFFER_RING_H_
+
+#include <stdint.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include "pti_assert.h"
+
+namespace utils {
+
+// Fixed set of reusable byte buffers passed from a producer thread to
+// a consumer thread in FIFO order. Producer blocks while all the buffers
+// are in use, so memory footprint does not depend on the run length
+class BufferRing {
+ public: // User Interface
+  BufferRing(size_t buffer_count) : buffer_list_(buffer_count) {
+    PTI_ASSERT(buffer_count > 0);
+    for (auto& buffer : buffer_list_) {
+      free_list_.push_back(&buffer);
+    }
+  }
+
+  std::vector<uint8_t>* Acquire() {
+    std::unique_lock<std::mutex> lock(lock_);
+    if (free_list_.empty()) {
+      ++stall_count_;
+      condition_.wait(lock, [this] { return !free_list_.empty(); });
+    }
+    std::vector<uint8_t>* buffer = free_list_.front();
+    free_list_.pop_front();
+    return buffer;
+  }
+
+  void Submit(std::vector<uint8_t>* buffer) {
+    PTI_ASSERT(buffer != nullptr);
+    {
+      const std::lock_guard<std::mutex> lock(lock_);
+      ready_list_.push_back(buffer);
+    }
+    condition_.notify_all();
+  }
+
+  // Returns nullptr once the ring is closed and all the buffers are popped
+  std::vector<uint8_t>* Pop() {
+    std::unique_lock<std::mutex> lock(lock_);
+    condition_.wait(lock, [this] { return !ready_list_.empty() || closed_; });
+    if (ready_list_.empty()) {
+      return nullptr;
+    }
+    std::vector<uint8_t>* buffer = ready_list_.front();
+    ready_list_.pop_front();
+    return buffer;
+  }
+
+  void Release(std::vector<uint8_t>* buffer) {
+    PTI_ASSERT(buffer != nullptr);
+    {
+      const std::lock_guard<std::mutex> lock(lock_);
+      free_list_.push_back(buffer);
+    }
+    condition_.notify_all();
+  }
+
+  void Open() {
+    const std::lock_guard<std::mutex> lock(lock_);
+    closed_ = false;
+  }
+
+  void Close() {
+    {
+      const std::lock_guard<std::mutex> lock(lock_);
+      closed_ = true;
+    }
+    condition_.notify_all();
+  }
+
+  // Number of times producer had to wait for a free buffer
+  uint64_t GetStallCount() const {
+    const std::lock_guard<std::mutex> lock(lock_);
+    return stall_count_;
+  }
+
+  BufferRing(const BufferRing& copy) = delete;
+  BufferRing& operator=(const BufferRing& copy) = delete;
+
+ private: // Data
+  std::vector< std::vector<uint8_t> > buffer_list_;
+  std::deque<std::vector<uint8_t>*> free_list_;
+  std::deque<std::vector<uint8_t>*> ready_list_;
+  bool closed_ = false;
+  uint64_t stall_count_ = 0;
+
+  mutable std::mutex lock_;
+  std::condition_variable condition_;
+};
+
+} // namespace utils
+
+#endif // PTI_SAMPLES_UTILS_BUFFER_RING_H_
\ No newline at end of file
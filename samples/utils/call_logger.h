@@ -0,0 +1,389 @@
+//==============================================================
+// Copyright (C) Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#ifndef PTI_SAMPLES_UTILS_CALL_LOGGER_H_
+#define PTI_SAMPLES_UTILS_CALL_LOGGER_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "pti_assert.h"
+
+namespace utils {
+
+// Lock-free byte ring with a single producer and a single consumer.
+// Records are pushed as a whole, so consumer never sees a partial one
+class CallLogRing {
+ public:
+  // Returns false if there is not enough free space for the record
+  bool Push(const uint8_t* data, size_t size) {
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    uint64_t tail = tail_.load(std::memory_order_acquire);
+    if (size > kRingSize - (head - tail)) {
+      return false;
+    }
+    size_t offset = head & (kRingSize - 1);
+    size_t part = std::min(size, kRingSize - offset);
+    memcpy(data_ + offset, data, part);
+    memcpy(data_, data + part, size - part);
+    head_.store(head + size, std::memory_order_release);
+    return true;
+  }
+
+  // Appends all the pushed bytes to the data
+  size_t Pop(std::vector<uint8_t>& data) {
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    uint64_t head = head_.load(std::memory_order_acquire);
+    size_t size = head - tail;
+    size_t offset = tail & (kRingSize - 1);
+    size_t part = std::min(size, kRingSize - offset);
+    data.insert(data.end(), data_ + offset, data_ + offset + part);
+    data.insert(data.end(), data_, data_ + (size - part));
+    tail_.store(head, std::memory_order_release);
+    return size;
+  }
+
+  size_t GetSize() const {
+    return head_.load(std::memory_order_relaxed) -
+      tail_.load(std::memory_order_relaxed);
+  }
+
+  static const size_t kRingSize = 1 << 18;
+
+ private:
+  std::atomic<uint64_t> head_{0};
+  char padding_[64];
+  std::atomic<uint64_t> tail_{0};
+  uint8_t data_[kRingSize];
+};
+
+// Per-thread storage for call records. Record is built by its thread
+// and then pushed into the ring, so the writer takes no lock the
+// application thread may wait for
+struct CallLogBuffer {
+  std::vector<uint8_t> record;
+  CallLogRing ring;
+};
+
+// Deferred call logging. API callbacks do not format anything: values
+// are stored in binary form together with the printer for their type,
+// while background thread turns records into text with the very same
+// operator<< and writes it to std::cerr. Records of a single thread are
+// written in order, records of different threads are grouped by thread
+// within each flush period
+class CallLogger {
+ public: // User Interface
+  typedef size_t (*Printer)(std::ostream& stream, const uint8_t* data);
+
+  // Buffer is retired on thread exit, so short-lived threads leave
+  // neither memory nor buffers for the writer to scan
+  CallLogBuffer* GetThreadBuffer() {
+    static thread_local ThreadBuffer buffer(this);
+    return buffer.Get();
+  }
+
+  void Submit(CallLogBuffer* buffer) {
+    PTI_ASSERT(buffer != nullptr);
+    std::vector<uint8_t>& record = buffer->record;
+    if (!buffer->ring.Push(record.data(), record.size())) {
+      // Writer does not keep up, so help it. Records of this thread are
+      // all written after that, so the one larger than the ring goes
+      // straight to the output
+      Drain();
+      if (!buffer->ring.Push(record.data(), record.size())) {
+        const std::lock_guard<std::mutex> drain_lock(drain_lock_);
+        Print(record);
+      }
+    } else if (buffer->ring.GetSize() >= kFlushSize) {
+      condition_.notify_one();
+    }
+    record.clear();
+  }
+
+  // Writes all the submitted records before return
+  void Flush() {
+    Drain();
+  }
+
+  CallLogger(const CallLogger& copy) = delete;
+  CallLogger& operator=(const CallLogger& copy) = delete;
+
+ private: // Implementation Details
+  friend CallLogger& GetCallLogger();
+
+  class ThreadBuffer {
+   public:
+    ThreadBuffer(CallLogger* logger)
+        : logger_(logger), buffer_(logger->AddBuffer()) {}
+
+    ~ThreadBuffer() {
+      logger_->RetireBuffer(buffer_);
+    }
+
+    CallLogBuffer* Get() const {
+      return buffer_;
+    }
+
+   private:
+    CallLogger* logger_;
+    CallLogBuffer* buffer_;
+  };
+
+  CallLogBuffer* AddBuffer() {
+    CallLogBuffer* buffer = new CallLogBuffer;
+    PTI_ASSERT(buffer != nullptr);
+    const std::lock_guard<std::mutex> lock(lock_);
+    buffer_list_.push_back(buffer);
+    return buffer;
+  }
+
+  // Writes the records submitted so far, then removes the buffer while
+  // no drain is in progress, as Drain() uses the copy of the list
+  void RetireBuffer(CallLogBuffer* buffer) {
+    PTI_ASSERT(buffer != nullptr);
+    Drain();
+    {
+      const std::lock_guard<std::mutex> drain_lock(drain_lock_);
+      const std::lock_guard<std::mutex> lock(lock_);
+      auto it = std::find(buffer_list_.begin(), buffer_list_.end(), buffer);
+      PTI_ASSERT(it != buffer_list_.end());
+      buffer_list_.erase(it);
+    }
+    delete buffer;
+  }
+
+  CallLogger() {
+    writer_thread_ = std::thread(Write, this);
+  }
+
+  void Drain() {
+    const std::lock_guard<std::mutex> drain_lock(drain_lock_);
+
+    std::vector<CallLogBuffer*> buffer_list;
+    {
+      const std::lock_guard<std::mutex> lock(lock_);
+      buffer_list = buffer_list_;
+    }
+
+    for (auto buffer : buffer_list) {
+      if (buffer->ring.Pop(data_) > 0) {
+        Print(data_);
+        data_.clear();
+      }
+    }
+  }
+
+  // Expects drain lock to be held
+  void Print(const std::vector<uint8_t>& data) {
+    stream_.str(std::string());
+    size_t offset = 0;
+    while (offset < data.size()) {
+      Printer printer = nullptr;
+      memcpy(&printer, data.data() + offset, sizeof(printer));
+      PTI_ASSERT(printer != nullptr);
+      offset += sizeof(printer);
+      offset += printer(stream_, data.data() + offset);
+    }
+    PTI_ASSERT(offset == data.size());
+
+    std::cerr << stream_.str();
+  }
+
+  static void Write(CallLogger* logger) {
+    PTI_ASSERT(logger != nullptr);
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(logger->lock_);
+        logger->condition_.wait_for(
+            lock, std::chrono::milliseconds(kFlushPeriod));
+      }
+      logger->Drain();
+    }
+  }
+
+ private: // Data
+  std::mutex lock_;
+  std::condition_variable condition_;
+  std::vector<CallLogBuffer*> buffer_list_;
+  std::thread writer_thread_;
+
+  std::mutex drain_lock_;
+  std::vector<uint8_t> data_;
+  std::stringstream stream_;
+
+  static const uint32_t kFlushPeriod = 10; // ms
+  static const size_t kFlushSize = CallLogRing::kRingSize / 4;
+};
+
+// Process-wide logger shared by all the collectors, so records of L0 and
+// OpenCL calls made by the same thread stay in order. It is never
+// destroyed, and writer thread keeps running until the process exits,
+// so collectors should call Flush() once tracing is disabled
+inline CallLogger& GetCallLogger() {
+  static CallLogger* logger = new CallLogger;
+  return *logger;
+}
+
+// Drop-in replacement for std::stringstream in API callbacks. Character
+// arrays are expected to be string literals and are kept by pointer,
+// other strings are copied, the rest of the values are copied as is
+class CallRecord {
+ public: // User Interface
+  typedef CallLogger::Printer Printer;
+
+  CallRecord() : buffer_(GetCallLogger().GetThreadBuffer()) {}
+
+  template <size_t N>
+  CallRecord& operator<<(const char (&str)[N]) {
+    const char* value = str;
+    Append(PrintValue<const char*>, &value, sizeof(value));
+    return *this;
+  }
+
+  template <typename T>
+  CallRecord& operator<<(const T& value) {
+    Capture(value, std::integral_constant<bool,
+        std::is_same<T, const char*>::value ||
+        std::is_same<T, char*>::value>());
+    return *this;
+  }
+
+  CallRecord& operator<<(std::ostream& (*manipulator)(std::ostream&)) {
+    Append(PrintValue<std::ostream& (*)(std::ostream&)>,
+           &manipulator, sizeof(manipulator));
+    return *this;
+  }
+
+  // Raw interface for the generated callbacks: the record is started
+  // with the printer, followed by the values and strings this printer
+  // reads back with CallRecordReader in the same order
+  void Begin(Printer printer) {
+    Append(printer, 0);
+  }
+
+  template <typename T>
+  void Put(const T& value) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Value should be trivially copyable");
+    memcpy(Extend(sizeof(T)), &value, sizeof(T));
+  }
+
+  void PutString(const char* str, size_t size) {
+    PTI_ASSERT(str != nullptr);
+    uint32_t length = static_cast<uint32_t>(size);
+    uint8_t* data = Extend(sizeof(length) + length);
+    memcpy(data, &length, sizeof(length));
+    memcpy(data + sizeof(length), str, length);
+  }
+
+  void PutString(const char* str) {
+    PTI_ASSERT(str != nullptr);
+    PutString(str, strlen(str));
+  }
+
+  void Submit() {
+    GetCallLogger().Submit(buffer_);
+  }
+
+ private: // Implementation Details
+  template <typename T>
+  static size_t PrintValue(std::ostream& stream, const uint8_t* data) {
+    T value;
+    memcpy(&value, data, sizeof(T));
+    stream << value;
+    return sizeof(T);
+  }
+
+  static size_t PrintString(std::ostream& stream, const uint8_t* data) {
+    uint32_t size = 0;
+    memcpy(&size, data, sizeof(size));
+    stream.write(reinterpret_cast<const char*>(data + sizeof(size)), size);
+    return sizeof(size) + size;
+  }
+
+  template <typename T>
+  void Capture(const T& value, std::false_type) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Value should be trivially copyable");
+    Append(PrintValue<T>, &value, sizeof(T));
+  }
+
+  void Capture(const char* str, std::true_type) {
+    Begin(PrintString);
+    PutString(str);
+  }
+
+  void Append(Printer printer, const void* value, size_t size) {
+    memcpy(Append(printer, size), value, size);
+  }
+
+  // Returns the place for the value of the given size
+  uint8_t* Append(Printer printer, size_t size) {
+    std::vector<uint8_t>& record = buffer_->record;
+    size_t offset = record.size();
+    record.resize(offset + sizeof(printer) + size);
+    memcpy(record.data() + offset, &printer, sizeof(printer));
+    return record.data() + offset + sizeof(printer);
+  }
+
+  // Grows the current record without starting a new item
+  uint8_t* Extend(size_t size) {
+    std::vector<uint8_t>& record = buffer_->record;
+    size_t offset = record.size();
+    record.resize(offset + size);
+    return record.data() + offset;
+  }
+
+ private: // Data
+  CallLogBuffer* buffer_;
+};
+
+// Reads the record written with CallRecord::Begin() from the printer
+class CallRecordReader {
+ public: // User Interface
+  CallRecordReader(const uint8_t* data) : data_(data) {
+    PTI_ASSERT(data_ != nullptr);
+  }
+
+  template <typename T>
+  void Get(T& value) {
+    memcpy(&value, data_ + size_, sizeof(T));
+    size_ += sizeof(T);
+  }
+
+  std::string GetString() {
+    uint32_t length = 0;
+    Get(length);
+    std::string str(reinterpret_cast<const char*>(data_ + size_), length);
+    size_ += length;
+    return str;
+  }
+
+  // Number of bytes read so far, to be returned by the printer
+  size_t GetSize() const {
+    return size_;
+  }
+
+ private: // Data
+  const uint8_t* data_;
+  size_t size_ = 0;
+};
+
+} // namespace utils
+
+#endif // PTI_SAMPLES_UTILS_CALL_LOGGER_H_
\ No newline at end of file
@@ -14,6 +14,8 @@
 
 #include <CL/cl.h>
 
+#include "clock_correlator.h"
+#include "timestamp.h"
 #include "utils.h"
 
 namespace utils {
@@ -269,6 +271,25 @@ inline cl_ulong GetCpuTimestamp() {
   return timestamp;
 }
 
+// Device profiling time paired with the host time, device time is taken
+// from the clock OpenCL runtime is expected to use for the device type
+class DeviceClockSource : public ClockSource {
+ public: // User Interface
+  DeviceClockSource(cl_device_type device_type)
+      : device_type_(device_type) {}
+
+  ClockSample GetSample() override {
+    uint64_t start = utils::GetTimestamp();
+    uint64_t device_time = (device_type_ == CL_DEVICE_TYPE_GPU) ?
+      GetGpuTimestamp() : GetCpuTimestamp();
+    uint64_t end = utils::GetTimestamp();
+    return {start + (end - start) / 2, device_time};
+  }
+
+ private: // Data
+  cl_device_type device_type_;
+};
+
 } // namespace cl
 } // namespace utils
 
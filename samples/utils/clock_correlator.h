@@ -0,0 +1,250 @@
+//==============================================================
+// Copyright (C) Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#ifndef PTI_SAMPLES_UTILS_CLOCK_CORRELATOR_H_
+#define PTI_SAMPLES_UTILS_CLOCK_CORRELATOR_H_
+
+#include <stdint.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "pti_assert.h"
+#include "tick_converter.h"
+#include "utils.h"
+
+namespace utils {
+
+struct ClockSample {
+  uint64_t host_time;
+  uint64_t device_ticks;
+};
+
+// Provides (host, device) time pairs read as close to each other as
+// possible. Host time is expected in utils::GetTimestamp() time base
+class ClockSource {
+ public: // User Interface
+  virtual ~ClockSource() {}
+  virtual ClockSample GetSample() = 0;
+};
+
+// Maps device clock ticks to host time with the linear model fitted over
+// the recent samples, so drift between the clocks is followed. Device
+// counter may be narrower than 64 bits: samples are unwrapped into
+// monotonic 64-bit stream, while converted ticks are unwrapped around
+// the latest sample (so they are expected to be within half of the
+// counter period from it). Model is pure math and can be fed with
+// synthetic samples
+class ClockDriftModel {
+ public: // User Interface
+  ClockDriftModel(uint64_t frequency, uint32_t counter_bits = 64)
+      : mask_(counter_bits < 64 ? (1ULL << counter_bits) - 1 : ~0ULL) {
+    PTI_ASSERT(frequency > 0);
+    PTI_ASSERT(counter_bits > 0 && counter_bits <= 64);
+    mult_ = ToMult(static_cast<double>(NSEC_IN_SEC) / frequency);
+  }
+
+  bool IsEmpty() const {
+    return sample_list_.empty();
+  }
+
+  void AddSample(const ClockSample& sample) {
+    ClockSample unwrapped{sample.host_time, sample.device_ticks & mask_};
+    if (!sample_list_.empty()) {
+      unwrapped.device_ticks = Unwrap(sample.device_ticks);
+      if (unwrapped.device_ticks <= sample_list_.back().device_ticks ||
+          unwrapped.host_time <= sample_list_.back().host_time) {
+        return; // Out of order sample
+      }
+    }
+
+    sample_list_.push_back(unwrapped);
+    if (sample_list_.size() > kWindowSize) {
+      sample_list_.pop_front();
+    }
+    Fit();
+  }
+
+  uint64_t GetHostTime(uint64_t device_ticks) const {
+    PTI_ASSERT(!sample_list_.empty());
+    uint64_t ticks = Unwrap(device_ticks);
+    if (ticks >= anchor_ticks_) {
+      return anchor_time_ + MulShift(ticks - anchor_ticks_, mult_, kShift);
+    }
+    return anchor_time_ - MulShift(anchor_ticks_ - ticks, mult_, kShift);
+  }
+
+  void GetHostTime(const uint64_t* device_ticks, uint64_t* host_time,
+                   size_t count) const {
+    PTI_ASSERT(count == 0 ||
+               (device_ticks != nullptr && host_time != nullptr));
+    for (size_t i = 0; i < count; ++i) {
+      host_time[i] = GetHostTime(device_ticks[i]);
+    }
+  }
+
+  // Host nanoseconds per device tick, fixed point
+  uint64_t GetMult() const {
+    return mult_;
+  }
+
+  static const uint32_t kShift = 32;
+
+ private: // Implementation Details
+  static uint64_t ToMult(double period) {
+    PTI_ASSERT(period > 0);
+    return static_cast<uint64_t>(period * (1ULL << kShift) + 0.5);
+  }
+
+  // Nearest 64-bit value matching the counter around the latest sample
+  uint64_t Unwrap(uint64_t device_ticks) const {
+    uint64_t ticks = device_ticks & mask_;
+    if (sample_list_.empty() || mask_ == ~0ULL) {
+      return ticks;
+    }
+
+    uint64_t reference = sample_list_.back().device_ticks;
+    uint64_t forward = (ticks - reference) & mask_;
+    if (forward <= (mask_ >> 1)) {
+      return reference + forward;
+    }
+    uint64_t backward = (reference - ticks) & mask_;
+    PTI_ASSERT(backward <= reference);
+    return reference - backward;
+  }
+
+  // Least squares fit of host time over device ticks, model is anchored
+  // at the mean point to keep the rounding error lowest in the window.
+  // Nominal frequency is used until there are two samples
+  void Fit() {
+    PTI_ASSERT(!sample_list_.empty());
+    const ClockSample& first = sample_list_.front();
+
+    double mean_ticks = 0.0, mean_time = 0.0;
+    for (auto& sample : sample_list_) {
+      mean_ticks += static_cast<double>(
+          sample.device_ticks - first.device_ticks);
+      mean_time += static_cast<double>(sample.host_time - first.host_time);
+    }
+    mean_ticks /= sample_list_.size();
+    mean_time /= sample_list_.size();
+
+    if (sample_list_.size() > 1) {
+      double covariance = 0.0, variance = 0.0;
+      for (auto& sample : sample_list_) {
+        double ticks = static_cast<double>(
+            sample.device_ticks - first.device_ticks) - mean_ticks;
+        double time = static_cast<double>(
+            sample.host_time - first.host_time) - mean_time;
+        covariance += ticks * time;
+        variance += ticks * ticks;
+      }
+      PTI_ASSERT(variance > 0.0);
+      mult_ = ToMult(covariance / variance);
+    }
+
+    uint64_t offset = static_cast<uint64_t>(mean_ticks + 0.5);
+    double correction = (static_cast<double>(offset) - mean_ticks) *
+      mult_ / (1ULL << kShift);
+    anchor_ticks_ = first.device_ticks + offset;
+    anchor_time_ = first.host_time +
+      static_cast<uint64_t>(mean_time + correction + 0.5);
+  }
+
+ private: // Data
+  uint64_t mask_;
+  std::deque<ClockSample> sample_list_;
+
+  uint64_t anchor_ticks_ = 0;
+  uint64_t anchor_time_ = 0;
+  uint64_t mult_ = 0;
+
+  static const size_t kWindowSize = 32;
+};
+
+// Keeps the clock model up to date by sampling the source periodically
+// in the background thread. Source is owned by the correlator
+class ClockCorrelator {
+ public: // User Interface
+  ClockCorrelator(ClockSource* source, uint64_t frequency,
+                  uint32_t counter_bits = 64,
+                  uint32_t period = kSamplePeriod)
+      : source_(source), model_(frequency, counter_bits), period_(period) {
+    PTI_ASSERT(source_ != nullptr);
+    PTI_ASSERT(period_ > 0);
+    model_.AddSample(source_->GetSample());
+    active_ = true;
+    thread_ = std::thread(Run, this);
+  }
+
+  ~ClockCorrelator() {
+    {
+      const std::lock_guard<std::mutex> lock(thread_lock_);
+      active_ = false;
+    }
+    condition_.notify_one();
+    thread_.join();
+    delete source_;
+  }
+
+  uint64_t GetHostTime(uint64_t device_ticks) const {
+    const std::lock_guard<std::mutex> lock(lock_);
+    return model_.GetHostTime(device_ticks);
+  }
+
+  // Converts the whole array under a single lock
+  void GetHostTime(const uint64_t* device_ticks, uint64_t* host_time,
+                   size_t count) const {
+    const std::lock_guard<std::mutex> lock(lock_);
+    model_.GetHostTime(device_ticks, host_time, count);
+  }
+
+  // Takes a sample right away, e.g. before the conversion of the ticks
+  // that may be newer than half of the counter period since last sample
+  void Sync() {
+    ClockSample sample = source_->GetSample();
+    const std::lock_guard<std::mutex> lock(lock_);
+    model_.AddSample(sample);
+  }
+
+  ClockCorrelator(const ClockCorrelator& copy) = delete;
+  ClockCorrelator& operator=(const ClockCorrelator& copy) = delete;
+
+ private: // Implementation Details
+  static void Run(ClockCorrelator* correlator) {
+    PTI_ASSERT(correlator != nullptr);
+    std::unique_lock<std::mutex> lock(correlator->thread_lock_);
+    while (correlator->active_) {
+      correlator->condition_.wait_for(
+          lock, std::chrono::milliseconds(correlator->period_));
+      if (!correlator->active_) {
+        break;
+      }
+      correlator->Sync();
+    }
+  }
+
+ private: // Data
+  ClockSource* source_;
+
+  mutable std::mutex lock_;
+  ClockDriftModel model_;
+
+  uint32_t period_; // ms
+  std::thread thread_;
+  std::mutex thread_lock_;
+  std::condition_variable condition_;
+  bool active_ = false;
+
+  static const uint32_t kSamplePeriod = 100; // ms
+};
+
+} // namespace utils
+
+#endif // PTI_SAMPLES_UTILS_CLOCK_CORRELATOR_H_
\ No newline at end of file
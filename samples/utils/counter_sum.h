@@ -0,0 +1,96 @@
+//==============================================================
+// Copyright (C) Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#ifndef PTI_SAMPLES_UTILS_COUNTER_SUM_H_
+#define PTI_SAMPLES_UTILS_COUNTER_SUM_H_
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "pti_assert.h"
+
+namespace utils {
+
+// Sum of 32-bit counters in 64 bits, so it never overflows. Vector path
+// widens eight counters at a time into four independent accumulators
+inline uint64_t SumCounters(const uint32_t* value_list, size_t count) {
+  PTI_ASSERT(count == 0 || value_list != nullptr);
+  uint64_t sum = 0;
+  size_t i = 0;
+
+#if defined(__SSE2__) || defined(_M_X64)
+  const __m128i zero = _mm_setzero_si128();
+  __m128i sum_0 = zero, sum_1 = zero, sum_2 = zero, sum_3 = zero;
+  for (; i + 8 <= count; i += 8) {
+    __m128i first = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(value_list + i));
+    __m128i second = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(value_list + i + 4));
+    sum_0 = _mm_add_epi64(sum_0, _mm_unpacklo_epi32(first, zero));
+    sum_1 = _mm_add_epi64(sum_1, _mm_unpackhi_epi32(first, zero));
+    sum_2 = _mm_add_epi64(sum_2, _mm_unpacklo_epi32(second, zero));
+    sum_3 = _mm_add_epi64(sum_3, _mm_unpackhi_epi32(second, zero));
+  }
+
+  uint64_t lane_list[2] = {0, 0};
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(lane_list),
+                   _mm_add_epi64(_mm_add_epi64(sum_0, sum_1),
+                                 _mm_add_epi64(sum_2, sum_3)));
+  sum = lane_list[0] + lane_list[1];
+#endif
+
+  for (; i < count; ++i) {
+    sum += value_list[i];
+  }
+  return sum;
+}
+
+// Per-field sums of the records made of four 32-bit counters each, e.g.
+// per-thread samples of the structure like {freq, cycles, pm, skipped}
+inline void SumCounterRecords(const uint32_t* value_list, size_t count,
+                              uint64_t sum_list[4]) {
+  PTI_ASSERT(count == 0 || value_list != nullptr);
+  PTI_ASSERT(sum_list != nullptr);
+  for (size_t j = 0; j < 4; ++j) {
+    sum_list[j] = 0;
+  }
+  size_t i = 0;
+
+#if defined(__SSE2__) || defined(_M_X64)
+  // Single record fills the whole register, so fields stay in their lanes:
+  // low accumulators keep the first two fields, high ones keep the rest
+  const __m128i zero = _mm_setzero_si128();
+  __m128i low_0 = zero, high_0 = zero, low_1 = zero, high_1 = zero;
+  for (; i + 2 <= count; i += 2) {
+    __m128i first = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(value_list + 4 * i));
+    __m128i second = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(value_list + 4 * i + 4));
+    low_0 = _mm_add_epi64(low_0, _mm_unpacklo_epi32(first, zero));
+    high_0 = _mm_add_epi64(high_0, _mm_unpackhi_epi32(first, zero));
+    low_1 = _mm_add_epi64(low_1, _mm_unpacklo_epi32(second, zero));
+    high_1 = _mm_add_epi64(high_1, _mm_unpackhi_epi32(second, zero));
+  }
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(sum_list),
+                   _mm_add_epi64(low_0, low_1));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(sum_list + 2),
+                   _mm_add_epi64(high_0, high_1));
+#endif
+
+  for (; i < count; ++i) {
+    for (size_t j = 0; j < 4; ++j) {
+      sum_list[j] += value_list[4 * i + j];
+    }
+  }
+}
+
+} // namespace utils
+
+#endif // PTI_SAMPLES_UTILS_COUNTER_SUM_H_
\ No newline at end of file
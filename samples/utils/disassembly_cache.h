@@ -0,0 +1,464 @@
+//==============================================================
+// Copyright (C) Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#ifndef PTI_SAMPLES_UTILS_DISASSEMBLY_CACHE_H_
+#define PTI_SAMPLES_UTILS_DISASSEMBLY_CACHE_H_
+
+#if defined(_WIN32)
+#include <direct.h>
+#include <sys/utime.h>
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <utime.h>
+#endif
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gen_binary_decoder.h"
+#include "mapped_file.h"
+#include "pti_assert.h"
+#include "utils.h"
+
+namespace utils {
+
+// MurmurHash64A: eight bytes per step, good enough distribution to
+// address the cache by content
+inline uint64_t HashBinary(const uint8_t* data, size_t size) {
+  PTI_ASSERT(size == 0 || data != nullptr);
+  const uint64_t m = 0xC6A4A7935BD1E995ULL;
+  const int r = 47;
+  uint64_t h = 0x8445D61A4E774912ULL ^ (size * m);
+
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    uint64_t k = 0;
+    memcpy(&k, data + i, sizeof(k));
+    k *= m;
+    k ^= k >> r;
+    k *= m;
+    h ^= k;
+    h *= m;
+  }
+
+  if (i < size) {
+    for (size_t j = size - i; j > 0; --j) {
+      h ^= static_cast<uint64_t>(data[i + j - 1]) << (8 * (j - 1));
+    }
+    h *= m;
+  }
+
+  h ^= h >> r;
+  h *= m;
+  h ^= h >> r;
+  return h;
+}
+
+struct DisassemblyCacheHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t arch;
+  uint32_t instruction_count;
+  uint64_t decoder_hash; // IGA version and decoding options
+  uint64_t binary_hash;
+  uint64_t binary_size;
+  uint64_t text_size;
+};
+
+// Instruction text is stored without terminating zero
+struct DisassemblyCacheEntry {
+  int32_t offset;
+  uint32_t text_offset;
+  uint32_t text_size;
+};
+
+struct DisassemblyCacheFile {
+  std::string path;
+  uint64_t size;
+  time_t time;
+};
+
+// Results of disassembling kernel binaries kept across the runs, one file
+// per binary, architecture and decoder version: the header, the entries
+// and then all the texts, so the file is mapped and checked in place.
+// The files are written under unique temporary names and then renamed,
+// so processes sharing the directory (e.g. MPI ranks on a shared
+// filesystem) see either a complete file or no file at all.
+//
+// The directory is taken from PTI_DisassemblyCache variable (0 turns the
+// cache off), otherwise it is placed in the user cache directory. Once
+// per process the files unused for kMaxAge are removed, then the least
+// recently used ones while the directory is larger than kMaxSize
+class DisassemblyCache {
+ public: // User Interface
+  DisassemblyCache()
+      : directory_(GetDirectory()), decoder_hash_(GetDecoderHash()) {}
+
+  DisassemblyCache(const std::string& directory)
+      : directory_(directory), decoder_hash_(GetDecoderHash()) {}
+
+  bool IsEnabled() const {
+    return !directory_.empty();
+  }
+
+  // Loads instructions from the cache, or disassembles the binary and
+  // stores the result for the next runs
+  std::vector<Instruction> Disassemble(
+      const std::vector<uint8_t>& binary, iga_gen_t arch) {
+    if (!IsEnabled() || binary.empty()) {
+      GenBinaryDecoder decoder(binary, arch);
+      return decoder.Disassemble();
+    }
+
+    uint64_t hash = HashBinary(binary.data(), binary.size());
+    std::string path = GetPath(hash, arch);
+
+    std::vector<Instruction> instruction_list;
+    if (Load(path, hash, binary.size(), arch, &instruction_list)) {
+      return instruction_list;
+    }
+
+    GenBinaryDecoder decoder(binary, arch);
+    instruction_list = decoder.Disassemble();
+    if (!instruction_list.empty()) {
+      Store(path, hash, binary.size(), arch, instruction_list);
+    }
+    return instruction_list;
+  }
+
+  bool Load(const std::string& path, uint64_t hash, uint64_t binary_size,
+            uint32_t arch, std::vector<Instruction>* instruction_list) const {
+    PTI_ASSERT(instruction_list != nullptr);
+    MappedFile file(path);
+    if (!file.IsValid() || file.GetSize() < sizeof(DisassemblyCacheHeader)) {
+      return false;
+    }
+
+    DisassemblyCacheHeader header;
+    memcpy(&header, file.GetData(), sizeof(header));
+    if (header.magic != kMagic || header.version != kVersion ||
+        header.arch != arch || header.decoder_hash != decoder_hash_ ||
+        header.binary_hash != hash || header.binary_size != binary_size) {
+      return false;
+    }
+
+    uint64_t entry_size = static_cast<uint64_t>(header.instruction_count) *
+      sizeof(DisassemblyCacheEntry);
+    if (header.text_size > file.GetSize() ||
+        file.GetSize() !=
+        sizeof(DisassemblyCacheHeader) + entry_size + header.text_size) {
+      return false;
+    }
+
+    const uint8_t* entry_data = file.GetData() + sizeof(header);
+    const char* text_data =
+      reinterpret_cast<const char*>(entry_data + entry_size);
+
+    std::vector<Instruction> result(header.instruction_count);
+    for (uint32_t i = 0; i < header.instruction_count; ++i) {
+      DisassemblyCacheEntry entry;
+      memcpy(&entry, entry_data + i * sizeof(entry), sizeof(entry));
+      if (static_cast<uint64_t>(entry.text_offset) + entry.text_size >
+          header.text_size) {
+        return false;
+      }
+      result[i].offset = entry.offset;
+      result[i].text.assign(text_data + entry.text_offset, entry.text_size);
+    }
+
+    instruction_list->swap(result);
+    Touch(path);
+    return true;
+  }
+
+  // Failures are not fatal: the binary is disassembled again next time
+  bool Store(const std::string& path, uint64_t hash, uint64_t binary_size,
+             uint32_t arch,
+             const std::vector<Instruction>& instruction_list) const {
+    if (!MakeDirectory(directory_)) {
+      return false;
+    }
+    if (IsFirstStore()) {
+      Prune(kMaxSize, kMaxAge);
+    }
+
+    uint64_t text_size = 0;
+    for (auto& instruction : instruction_list) {
+      text_size += instruction.text.size();
+    }
+    if (text_size > UINT32_MAX || instruction_list.size() > UINT32_MAX) {
+      return false;
+    }
+
+    DisassemblyCacheHeader header{
+        kMagic, kVersion, arch,
+        static_cast<uint32_t>(instruction_list.size()),
+        decoder_hash_, hash, binary_size, text_size};
+
+    std::vector<uint8_t> data(
+        sizeof(header) +
+        instruction_list.size() * sizeof(DisassemblyCacheEntry) + text_size);
+    memcpy(data.data(), &header, sizeof(header));
+
+    uint8_t* entry_data = data.data() + sizeof(header);
+    uint8_t* text_data = entry_data +
+      instruction_list.size() * sizeof(DisassemblyCacheEntry);
+    uint32_t text_offset = 0;
+    for (size_t i = 0; i < instruction_list.size(); ++i) {
+      const Instruction& instruction = instruction_list[i];
+      DisassemblyCacheEntry entry{
+          instruction.offset, text_offset,
+          static_cast<uint32_t>(instruction.text.size())};
+      memcpy(entry_data + i * sizeof(entry), &entry, sizeof(entry));
+      memcpy(text_data + text_offset, instruction.text.data(),
+             instruction.text.size());
+      text_offset += entry.text_size;
+    }
+
+    std::string temp_path = GetTemporaryPath(path);
+    {
+      std::ofstream stream(temp_path, std::ios::out | std::ios::binary);
+      if (!stream.is_open()) {
+        return false;
+      }
+      stream.write(reinterpret_cast<const char*>(data.data()), data.size());
+      stream.close();
+      if (!stream) {
+        remove(temp_path.c_str());
+        return false;
+      }
+    }
+
+    if (!Rename(temp_path, path)) {
+      remove(temp_path.c_str()); // Entry is in use or written by other one
+      return false;
+    }
+    return true;
+  }
+
+  std::string GetPath(uint64_t hash, uint32_t arch) const {
+    PTI_ASSERT(IsEnabled());
+    std::stringstream ss;
+    ss << directory_ << kSeparator << std::hex << std::setfill('0') <<
+      arch << "-" << std::setw(16) << decoder_hash_ << "-" <<
+      std::setw(16) << hash << ".disasm";
+    return ss.str();
+  }
+
+  // Removes the files older than max_age seconds, then the oldest ones
+  // until the total size is within max_size bytes. Files in use by other
+  // processes may fail to be removed, they are just skipped
+  void Prune(uint64_t max_size, time_t max_age) const {
+    PTI_ASSERT(IsEnabled());
+    std::vector<DisassemblyCacheFile> file_list = GetFileList();
+    std::sort(file_list.begin(), file_list.end(),
+              [](const DisassemblyCacheFile& left,
+                 const DisassemblyCacheFile& right) {
+                return left.time > right.time;
+              });
+
+    time_t now = time(nullptr);
+    uint64_t total_size = 0;
+    for (auto& file : file_list) {
+      if (now - file.time > max_age || total_size + file.size > max_size) {
+        remove(file.path.c_str());
+      } else {
+        total_size += file.size;
+      }
+    }
+  }
+
+ private: // Implementation Details
+  static uint64_t GetDecoderHash() {
+    std::string version = GenBinaryDecoder::GetVersion();
+    return HashBinary(reinterpret_cast<const uint8_t*>(version.data()),
+                      version.size());
+  }
+
+  static bool IsFirstStore() {
+    static std::atomic<bool> stored(false);
+    return !stored.exchange(true);
+  }
+
+  // Cache files and leftovers of failed writes
+  static bool IsCacheFile(const std::string& name) {
+    const std::string suffix_list[] = {".disasm", ".tmp"};
+    for (auto& suffix : suffix_list) {
+      if (name.size() > suffix.size() &&
+          name.compare(name.size() - suffix.size(),
+                       suffix.size(), suffix) == 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  std::vector<DisassemblyCacheFile> GetFileList() const {
+    std::vector<DisassemblyCacheFile> file_list;
+#if defined(_WIN32)
+    WIN32_FIND_DATAA data;
+    HANDLE handle =
+      FindFirstFileA((directory_ + kSeparator + "*").c_str(), &data);
+    if (handle == INVALID_HANDLE_VALUE) {
+      return file_list;
+    }
+    do {
+      if ((data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) ||
+          !IsCacheFile(data.cFileName)) {
+        continue;
+      }
+      uint64_t size = (static_cast<uint64_t>(data.nFileSizeHigh) << 32) |
+        data.nFileSizeLow;
+      uint64_t ticks = // 100ns intervals since 1601
+        (static_cast<uint64_t>(data.ftLastWriteTime.dwHighDateTime) << 32) |
+        data.ftLastWriteTime.dwLowDateTime;
+      file_list.push_back(
+          {directory_ + kSeparator + data.cFileName, size,
+           static_cast<time_t>(ticks / 10000000ULL - 11644473600ULL)});
+    } while (FindNextFileA(handle, &data));
+    FindClose(handle);
+#else
+    DIR* dir = opendir(directory_.c_str());
+    if (dir == nullptr) {
+      return file_list;
+    }
+    while (struct dirent* entry = readdir(dir)) {
+      if (!IsCacheFile(entry->d_name)) {
+        continue;
+      }
+      std::string path = directory_ + kSeparator + entry->d_name;
+      struct stat info;
+      if (stat(path.c_str(), &info) != 0 || !S_ISREG(info.st_mode)) {
+        continue;
+      }
+      file_list.push_back(
+          {path, static_cast<uint64_t>(info.st_size), info.st_mtime});
+    }
+    closedir(dir);
+#endif
+    return file_list;
+  }
+
+  // Modification time marks the last use of the file, it is updated at
+  // most once per kTouchPeriod to keep loads read-only mostly
+  static void Touch(const std::string& path) {
+#if defined(_WIN32)
+    struct _stat info;
+    if (_stat(path.c_str(), &info) == 0 &&
+        time(nullptr) - info.st_mtime > kTouchPeriod) {
+      _utime(path.c_str(), nullptr);
+    }
+#else
+    struct stat info;
+    if (stat(path.c_str(), &info) == 0 &&
+        time(nullptr) - info.st_mtime > kTouchPeriod) {
+      utime(path.c_str(), nullptr);
+    }
+#endif
+  }
+
+  static std::string GetDirectory() {
+    std::string value = GetEnv("PTI_DisassemblyCache");
+    if (value == "0") {
+      return std::string();
+    }
+    if (!value.empty()) {
+      return value;
+    }
+
+#if defined(_WIN32)
+    std::string root = GetEnv("LOCALAPPDATA");
+#else
+    std::string root = GetEnv("XDG_CACHE_HOME");
+    if (root.empty()) {
+      std::string home = GetEnv("HOME");
+      if (!home.empty()) {
+        root = home + kSeparator + ".cache";
+      }
+    }
+#endif
+
+    if (root.empty()) {
+      return std::string();
+    }
+    return root + kSeparator + "pti" + kSeparator + "disasm";
+  }
+
+  // Creates all the missing directories of the path
+  static bool MakeDirectory(const std::string& path) {
+    PTI_ASSERT(!path.empty());
+    for (size_t i = 1; i <= path.size(); ++i) {
+      if (i < path.size() && path[i] != '/' && path[i] != '\\') {
+        continue;
+      }
+      std::string directory = path.substr(0, i);
+      if (directory.back() == ':') { // Drive name
+        continue;
+      }
+#if defined(_WIN32)
+      int status = _mkdir(directory.c_str());
+#else
+      int status = mkdir(directory.c_str(), 0755);
+#endif
+      if (status != 0 && errno != EEXIST) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Process IDs are not unique across the nodes, so the name is random
+  static std::string GetTemporaryPath(const std::string& path) {
+    std::random_device device;
+    uint64_t value = (static_cast<uint64_t>(device()) << 32) | device();
+    std::stringstream ss;
+    ss << path << "." << GetPid() << "." << std::hex << value << ".tmp";
+    return ss.str();
+  }
+
+  static bool Rename(const std::string& from, const std::string& to) {
+#if defined(_WIN32)
+    return MoveFileExA(from.c_str(), to.c_str(),
+                       MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    return rename(from.c_str(), to.c_str()) == 0;
+#endif
+  }
+
+ private: // Data
+  std::string directory_;
+  uint64_t decoder_hash_;
+
+  static const uint32_t kMagic = 0x44495450; // "PTID"
+  static const uint32_t kVersion = 2;
+  static const uint64_t kMaxSize = 512ULL * 1024 * 1024;
+  static const time_t kMaxAge = 30 * 24 * 60 * 60;
+  static const time_t kTouchPeriod = 24 * 60 * 60;
+#if defined(_WIN32)
+  static const char kSeparator = '\\';
+#else
+  static const char kSeparator = '/';
+#endif
+};
+
+} // namespace utils
+
+#endif // PTI_SAMPLES_UTILS_DISASSEMBLY_CACHE_H_
\ No newline at end of file
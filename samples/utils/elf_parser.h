@@ -9,6 +9,9 @@
 
 #include <string.h>
 
+#include <limits>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "elf.h"
@@ -16,9 +19,26 @@
 #include "debug_info_parser.h"
 #include "debug_abbrev_parser.h"
 
+// Non-owning view of a section content
+struct ElfSection {
+  const uint8_t* data;
+  uint64_t size;
+
+  bool IsEmpty() const {
+    return data == nullptr || size == 0;
+  }
+};
+
+// Parser works over the memory it does not own (e.g. a loaded binary or
+// a mapped file, see mapped_file.h). Section headers are scanned once at
+// construction into a name index, so repeated lookups are cheap
 class ElfParser {
  public:
-  ElfParser(const uint8_t* data, uint32_t size) : data_(data), size_(size) {}
+  ElfParser(const uint8_t* data, uint64_t size) : data_(data), size_(size) {
+    if (IsValid()) {
+      BuildSectionIndex();
+    }
+  }
 
   bool IsValid() const {
     if (data_ == nullptr || size_ < sizeof(Elf64Header)) {
@@ -46,26 +66,26 @@ class ElfParser {
       return std::vector<std::string>();
     }
 
-    const uint8_t* section = nullptr;
-    uint64_t section_size = 0;
-    GetSection(".debug_line", &section, &section_size);
-    if (section == nullptr || section_size == 0) {
+    ElfSection section = GetSection(".debug_line");
+    if (section.IsEmpty()) {
       return std::vector<std::string>();
     }
 
-    PTI_ASSERT(section_size < (std::numeric_limits<uint32_t>::max)());
-    DebugLineParser line_parser(section, static_cast<uint32_t>(section_size));
+    PTI_ASSERT(section.size < (std::numeric_limits<uint32_t>::max)());
+    DebugLineParser line_parser(
+        section.data, static_cast<uint32_t>(section.size));
     if (!line_parser.IsValid()) {
       return std::vector<std::string>();
     }
 
-    GetSection(".debug_abbrev", &section, &section_size);
-    if (section == nullptr || section_size == 0) {
+    section = GetSection(".debug_abbrev");
+    if (section.IsEmpty()) {
       return std::vector<std::string>();
     }
 
-    PTI_ASSERT(section_size < (std::numeric_limits<uint32_t>::max)());
-    DebugAbbrevParser abbrev_parser(section, static_cast<uint32_t>(section_size));
+    PTI_ASSERT(section.size < (std::numeric_limits<uint32_t>::max)());
+    DebugAbbrevParser abbrev_parser(
+        section.data, static_cast<uint32_t>(section.size));
     if (!abbrev_parser.IsValid()) {
       return std::vector<std::string>();
     }
@@ -75,13 +95,14 @@ class ElfParser {
       return std::vector<std::string>();
     }
 
-    GetSection(".debug_info", &section, &section_size);
-    if (section == nullptr || section_size == 0) {
+    section = GetSection(".debug_info");
+    if (section.IsEmpty()) {
       return std::vector<std::string>();
     }
 
-    PTI_ASSERT(section_size < (std::numeric_limits<uint32_t>::max)());
-    DebugInfoParser info_parser(section, static_cast<uint32_t>(section_size));
+    PTI_ASSERT(section.size < (std::numeric_limits<uint32_t>::max)());
+    DebugInfoParser info_parser(
+        section.data, static_cast<uint32_t>(section.size));
     if (!info_parser.IsValid()) {
       return std::vector<std::string>();
     }
@@ -109,18 +130,16 @@ class ElfParser {
 
   std::vector<LineInfo> GetLineInfo() const {
     if (!IsValid()) {
-      return std::vector<LineInfo>();    
+      return std::vector<LineInfo>();
     }
 
-    const uint8_t* section = nullptr;
-    uint64_t section_size = 0;
-    GetSection(".debug_line", &section, &section_size);
-    if (section == nullptr || section_size == 0) {
+    ElfSection section = GetSection(".debug_line");
+    if (section.IsEmpty()) {
       return std::vector<LineInfo>();
     }
 
-    PTI_ASSERT(section_size < (std::numeric_limits<uint32_t>::max)());
-    DebugLineParser parser(section, static_cast<uint32_t>(section_size));
+    PTI_ASSERT(section.size < (std::numeric_limits<uint32_t>::max)());
+    DebugLineParser parser(section.data, static_cast<uint32_t>(section.size));
     if (!parser.IsValid()) {
       return std::vector<LineInfo>();
     }
@@ -129,50 +148,73 @@ class ElfParser {
   }
 
   std::vector<uint8_t> GetGenBinary() const {
-    if (!IsValid()) {
+    ElfSection section = GetGenBinarySection();
+    if (section.IsEmpty()) {
       return std::vector<uint8_t>();
     }
+    return std::vector<uint8_t>(section.data, section.data + section.size);
+  }
 
-    const uint8_t* section = nullptr;
-    uint64_t section_size = 0;
-    GetSection("Intel(R) OpenCL Device Binary", &section, &section_size);
-    if (section == nullptr || section_size == 0) {
-      return std::vector<uint8_t>();
-    }
+  // Zero-copy version of GetGenBinary()
+  ElfSection GetGenBinarySection() const {
+    return GetSection("Intel(R) OpenCL Device Binary");
+  }
 
-    std::vector<uint8_t> binary(section_size);
-    memcpy(binary.data(), section, section_size);
-    return binary;
+  // Returns empty section if not found or the parser is not valid
+  ElfSection GetSection(const char* name) const {
+    PTI_ASSERT(name != nullptr);
+    auto it = section_map_.find(name);
+    if (it == section_map_.end()) {
+      return ElfSection{nullptr, 0};
+    }
+    return it->second;
   }
 
  private:
-  void GetSection(const char* name,
-                  const uint8_t** section,
-                  uint64_t* section_size) const {
-    PTI_ASSERT(section != nullptr && section_size != nullptr);
-
+  void BuildSectionIndex() {
     const Elf64Header* header = reinterpret_cast<const Elf64Header*>(data_);
+    if (header->shoff == 0 || header->shnum == 0 ||
+        header->shentsize != sizeof(Elf64SectionHeader) ||
+        header->shoff > size_ ||
+        header->shnum * sizeof(Elf64SectionHeader) > size_ - header->shoff ||
+        header->shstrndx >= header->shnum) {
+      return;
+    }
+
     const Elf64SectionHeader* section_header =
       reinterpret_cast<const Elf64SectionHeader*>(data_ + header->shoff);
-    const char* name_section = reinterpret_cast<const char*>(
-        data_ + section_header[header->shstrndx].offset);
-    
+    const Elf64SectionHeader& name_header = section_header[header->shstrndx];
+    if (!IsInside(name_header.offset, name_header.size)) {
+      return;
+    }
+    const char* name_section =
+      reinterpret_cast<const char*>(data_ + name_header.offset);
+
+    section_map_.reserve(header->shnum);
     for (uint32_t i = 1; i < header->shnum; ++i) {
-      const char* section_name = name_section + section_header[i].name;
-      if (strcmp(section_name, name) == 0) {
-        *section = data_ + section_header[i].offset;
-        *section_size = section_header[i].size;
-        return;
+      if (section_header[i].name >= name_header.size ||
+          !IsInside(section_header[i].offset, section_header[i].size)) {
+        continue;
       }
+
+      const char* section_name = name_section + section_header[i].name;
+      size_t name_length = strnlen(
+          section_name, name_header.size - section_header[i].name);
+      // First section with the name wins, as with the linear search
+      section_map_.emplace(
+          std::string(section_name, name_length),
+          ElfSection{data_ + section_header[i].offset, section_header[i].size});
     }
+  }
 
-    *section = nullptr;
-    *section_size = 0;
+  bool IsInside(uint64_t offset, uint64_t size) const {
+    return offset <= size_ && size <= size_ - offset;
   }
 
  private:
   const uint8_t* data_ = nullptr;
-  uint32_t size_ = 0;
+  uint64_t size_ = 0;
+  std::unordered_map<std::string, ElfSection> section_map_;
 };
 
 #endif // PTI_SAMPLES_UTILS_ELF_PARSER_H_
\ No newline at end of file
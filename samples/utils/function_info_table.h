@@ -0,0 +1,108 @@
+//==============================================================
+// Copyright (C) Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#ifndef PTI_SAMPLES_UTILS_FUNCTION_INFO_TABLE_H_
+#define PTI_SAMPLES_UTILS_FUNCTION_INFO_TABLE_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <limits>
+#include <map>
+#include <new>
+#include <string>
+
+#include "pti_assert.h"
+
+namespace utils {
+
+// Lock-free per-function statistics for the API set known at build time.
+// Entries are indexed by function ID and updated with atomics, so API
+// calls neither take a lock nor build a name string. Names are resolved
+// at report time only. Info is expected to have total_time, min_time,
+// max_time and call_count fields
+template <typename Info, uint32_t kFunctionCount>
+class FunctionInfoTable {
+ public: // User Interface
+  // Entries are placed into the buffer at the cache line boundary, as the
+  // table is a member of heap-allocated collectors and operator new gives
+  // no extended alignment before C++17
+  FunctionInfoTable() {
+    uintptr_t address = reinterpret_cast<uintptr_t>(storage_);
+    address = (address + sizeof(Entry) - 1) & ~(sizeof(Entry) - 1);
+    entry_list_ = reinterpret_cast<Entry*>(address);
+    for (uint32_t id = 0; id < kFunctionCount; ++id) {
+      new (entry_list_ + id) Entry;
+    }
+  }
+
+  ~FunctionInfoTable() {
+    for (uint32_t id = 0; id < kFunctionCount; ++id) {
+      entry_list_[id].~Entry();
+    }
+  }
+
+  FunctionInfoTable(const FunctionInfoTable& copy) = delete;
+  FunctionInfoTable& operator=(const FunctionInfoTable& copy) = delete;
+
+  void AddFunctionTime(uint32_t id, uint64_t time) {
+    PTI_ASSERT(id < kFunctionCount);
+    Entry& entry = entry_list_[id];
+
+    entry.total_time.fetch_add(time, std::memory_order_relaxed);
+    entry.call_count.fetch_add(1, std::memory_order_relaxed);
+
+    // Min and max change rarely, so plain load is enough in most cases
+    uint64_t min_time = entry.min_time.load(std::memory_order_relaxed);
+    while (time < min_time &&
+           !entry.min_time.compare_exchange_weak(
+               min_time, time, std::memory_order_relaxed)) {}
+
+    uint64_t max_time = entry.max_time.load(std::memory_order_relaxed);
+    while (time > max_time &&
+           !entry.max_time.compare_exchange_weak(
+               max_time, time, std::memory_order_relaxed)) {}
+  }
+
+  // Function name is taken as get_name(id) for called functions only
+  template <typename GetName>
+  std::map<std::string, Info> GetFunctionInfoMap(GetName get_name) const {
+    std::map<std::string, Info> info_map;
+    for (uint32_t id = 0; id < kFunctionCount; ++id) {
+      const Entry& entry = entry_list_[id];
+      uint64_t call_count = entry.call_count.load(std::memory_order_relaxed);
+      if (call_count == 0) {
+        continue;
+      }
+      info_map[get_name(id)] = Info{
+          entry.total_time.load(std::memory_order_relaxed),
+          entry.min_time.load(std::memory_order_relaxed),
+          entry.max_time.load(std::memory_order_relaxed),
+          call_count};
+    }
+    return info_map;
+  }
+
+ private: // Implementation Details
+  // Takes a whole cache line to avoid false sharing between functions
+  struct alignas(64) Entry {
+    std::atomic<uint64_t> total_time{0};
+    std::atomic<uint64_t> min_time{(std::numeric_limits<uint64_t>::max)()};
+    std::atomic<uint64_t> max_time{0};
+    std::atomic<uint64_t> call_count{0};
+  };
+
+  static_assert(sizeof(Entry) == 64,
+                "Function entry should take exactly one cache line");
+
+ private: // Data
+  uint8_t storage_[(kFunctionCount + 1) * sizeof(Entry)];
+  Entry* entry_list_ = nullptr;
+};
+
+} // namespace utils
+
+#endif // PTI_SAMPLES_UTILS_FUNCTION_INFO_TABLE_H_
\ No newline at end of file
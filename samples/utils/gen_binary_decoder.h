@@ -7,6 +7,7 @@
 #ifndef PTI_SAMPLES_UTILS_GEN_BINARY_DECODER_H_
 #define PTI_SAMPLES_UTILS_GEN_BINARY_DECODER_H_
 
+#include <sstream>
 #include <vector>
 #include <string>
 
@@ -22,8 +23,15 @@ struct Instruction {
 class GenBinaryDecoder {
  public:
   GenBinaryDecoder(const std::vector<uint8_t>& binary, iga_gen_t arch)
-      : kernel_view_(arch, binary.data(), binary.size(),
-                     iga::SWSB_ENCODE_MODE::SingleDistPipe) {}
+      : kernel_view_(arch, binary.data(), binary.size(), kSwsbEncodeMode) {}
+
+  // Identifies the decoder output, e.g. to drop results saved with
+  // another IGA version
+  static std::string GetVersion() {
+    std::stringstream ss;
+    ss << iga_version_string() << "/" << static_cast<int>(kSwsbEncodeMode);
+    return ss.str();
+  }
 
   bool IsValid() const {
     return kernel_view_.decodeSucceeded();
@@ -55,6 +63,9 @@ class GenBinaryDecoder {
   }
 
  private:
+  static const iga::SWSB_ENCODE_MODE kSwsbEncodeMode =
+    iga::SWSB_ENCODE_MODE::SingleDistPipe;
+
   KernelView kernel_view_;
 };
 
@@ -7,6 +7,9 @@
 #ifndef PTI_SAMPLES_UTILS_GEN_SYMBOLS_DECODER_H_
 #define PTI_SAMPLES_UTILS_GEN_SYMBOLS_DECODER_H_
 
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <igc/ocl_igc_shared/executable_format/program_debug_data.h>
@@ -16,10 +19,19 @@
 #define IS_POWER_OF_TWO(X) (!((X - 1)&X))
 #define IGC_MAX_VALUE 1024
 
+// Kernel debug data is indexed by name once at construction, so lookups
+// for the kernels of the same program do not walk all the headers again
 class GenSymbolsDecoder {
  public:
   GenSymbolsDecoder(const std::vector<uint8_t>& symbols)
-      : data_(symbols.data()), size_(symbols.size()) {}
+      : GenSymbolsDecoder(symbols.data(), symbols.size()) {}
+
+  GenSymbolsDecoder(const uint8_t* data, size_t size)
+      : data_(data), size_(size) {
+    if (IsValidHeader()) {
+      BuildKernelIndex();
+    }
+  }
 
   bool IsValid() const {
     return IsValidHeader();
@@ -31,8 +43,11 @@ class GenSymbolsDecoder {
       return std::vector<std::string>();
     }
 
-    ElfParser parser = GetSection(kernel_name);
-    return parser.GetFileList();
+    const ElfParser* parser = GetSection(kernel_name);
+    if (parser == nullptr) {
+      return std::vector<std::string>();
+    }
+    return parser->GetFileList();
   }
 
   std::vector<LineInfo> GetLineInfo(const std::string& kernel_name) const {
@@ -40,8 +55,11 @@ class GenSymbolsDecoder {
       return std::vector<LineInfo>();
     }
 
-    ElfParser parser = GetSection(kernel_name);
-    return parser.GetLineInfo();
+    const ElfParser* parser = GetSection(kernel_name);
+    if (parser == nullptr) {
+      return std::vector<LineInfo>();
+    }
+    return parser->GetLineInfo();
   }
 
  private:
@@ -60,7 +78,7 @@ class GenSymbolsDecoder {
            (header->NumberOfKernels <= IGC_MAX_VALUE);
   }
 
-  ElfParser GetSection(const std::string& kernel_name) const {
+  void BuildKernelIndex() {
     const uint8_t* ptr = data_;
     const iOpenCL::SProgramDebugDataHeaderIGC* header =
       reinterpret_cast<const iOpenCL::SProgramDebugDataHeaderIGC*>(ptr);
@@ -72,35 +90,48 @@ class GenSymbolsDecoder {
       ptr += sizeof(iOpenCL::SKernelDebugDataHeaderIGC);
       PTI_ASSERT(ptr <= data_ + size_);
 
-      const char* current_kernel_name = reinterpret_cast<const char*>(ptr);
+      const char* kernel_name = reinterpret_cast<const char*>(ptr);
       uint32_t aligned_kernel_name_size = sizeof(uint32_t) *
         (1 + (kernel_header->KernelNameSize - 1) / sizeof(uint32_t));
       ptr += aligned_kernel_name_size;
       PTI_ASSERT(ptr <= data_ + size_);
 
-      if (kernel_name == current_kernel_name) {
-        PTI_ASSERT(kernel_header->SizeGenIsaDbgInBytes == 0);
-
-        ElfParser parser(ptr, kernel_header->SizeVisaDbgInBytes);
-        if (!parser.IsValid()) {
-          continue;
-        }
-
-        return parser;
-      }
-
+      const uint8_t* visa_debug_data = ptr;
       ptr += kernel_header->SizeVisaDbgInBytes;
       PTI_ASSERT(ptr <= data_ + size_);
 
       ptr += kernel_header->SizeGenIsaDbgInBytes;
       PTI_ASSERT(ptr <= data_ + size_);
+
+      std::string name(
+          kernel_name, strnlen(kernel_name, aligned_kernel_name_size));
+
+      // Not supported, but fails the lookup of this kernel only
+      if (kernel_header->SizeGenIsaDbgInBytes > 0) {
+        gen_isa_kernel_set_.insert(name);
+        continue;
+      }
+
+      ElfParser parser(visa_debug_data, kernel_header->SizeVisaDbgInBytes);
+      if (parser.IsValid()) {
+        kernel_map_.emplace(std::move(name), std::move(parser));
+      }
     }
+  }
 
-    return ElfParser(nullptr, 0);
+  const ElfParser* GetSection(const std::string& kernel_name) const {
+    PTI_ASSERT(gen_isa_kernel_set_.count(kernel_name) == 0);
+    auto it = kernel_map_.find(kernel_name);
+    if (it == kernel_map_.end()) {
+      return nullptr;
+    }
+    return &it->second;
   }
 
   const uint8_t* data_ = nullptr;
   size_t size_ = 0;
+  std::unordered_map<std::string, ElfParser> kernel_map_;
+  std::unordered_set<std::string> gen_isa_kernel_set_;
 };
 
 #endif // PTI_SAMPLES_UTILS_GEN_SYMBOLS_DECODER_H_
\ No newline at end of file
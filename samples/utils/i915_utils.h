@@ -14,12 +14,30 @@
 #define I915_TIMESTAMP_LOW_OFFSET 0x2358
 #endif
 
+#include "clock_correlator.h"
+#include "timestamp.h"
 #include "utils.h"
 #include "ze_utils.h"
 
 namespace utils {
 namespace i915 {
 
+#if defined(__linux__)
+// Device is opened once per process and never closed, so timestamp
+// reads cost a single ioctl
+inline int GetDeviceFd() {
+  static int fd = []() {
+    int fd = drmOpenWithType("i915", NULL, DRM_NODE_RENDER);
+    if (fd < 0) {
+      fd = drmOpenWithType("i915", NULL, DRM_NODE_PRIMARY);
+    }
+    return fd;
+  }();
+  PTI_ASSERT(fd >= 0);
+  return fd;
+}
+#endif
+
 inline uint64_t GetGpuTimestamp() {
 #if defined(_WIN32)
 
@@ -27,20 +45,13 @@ inline uint64_t GetGpuTimestamp() {
 
 #elif defined(__linux__)
 
-  int fd = drmOpenWithType("i915", NULL, DRM_NODE_RENDER);
-  if (fd < 0) {
-    fd = drmOpenWithType("i915", NULL, DRM_NODE_PRIMARY);
-  }
-  PTI_ASSERT(fd >= 0);
-
   struct drm_i915_reg_read reg_read_params = {0, };
   reg_read_params.offset = I915_TIMESTAMP_LOW_OFFSET | 1;
 
-  int ioctl_ret = drmIoctl(fd, DRM_IOCTL_I915_REG_READ, &reg_read_params);
+  int ioctl_ret = drmIoctl(
+      GetDeviceFd(), DRM_IOCTL_I915_REG_READ, &reg_read_params);
   PTI_ASSERT(ioctl_ret == 0);
 
-  drmClose(fd);
-
   return reg_read_params.val;
 
 #endif
@@ -64,20 +75,13 @@ inline uint64_t GetGpuTimerFrequency() {
 
 #elif defined(__linux__)
 
-  int fd = drmOpenWithType("i915", NULL, DRM_NODE_RENDER);
-  if (fd < 0) {
-    fd = drmOpenWithType("i915", NULL, DRM_NODE_PRIMARY);
-  }
-  PTI_ASSERT(fd >= 0);
-
   int32_t frequency = 0;
 
   drm_i915_getparam_t params = {0, };
   params.param = I915_PARAM_CS_TIMESTAMP_FREQUENCY;
   params.value = &frequency;
 
-  int ioctl_ret = drmIoctl(fd, DRM_IOCTL_I915_GETPARAM, &params);
-  drmClose(fd);
+  int ioctl_ret = drmIoctl(GetDeviceFd(), DRM_IOCTL_I915_GETPARAM, &params);
 
   // May not work for old Linux kernels (5.0+ is required)
   if (ioctl_ret != 0) {
@@ -90,6 +94,33 @@ inline uint64_t GetGpuTimerFrequency() {
 #endif
 }
 
+// GPU timestamp register paired with the host time read around it. Of a
+// few attempts the one with the shortest host interval is taken
+class GpuClockSource : public ClockSource {
+ public: // User Interface
+  ClockSample GetSample() override {
+    ClockSample sample{0, 0};
+    uint64_t best_interval = UINT64_MAX;
+    for (uint32_t i = 0; i < kSampleCount; ++i) {
+      uint64_t start = utils::GetTimestamp();
+      uint64_t ticks = GetGpuTimestamp();
+      uint64_t end = utils::GetTimestamp();
+      if (end - start < best_interval) {
+        best_interval = end - start;
+        sample.host_time = start + (end - start) / 2;
+        sample.device_ticks = ticks;
+      }
+    }
+    return sample;
+  }
+
+ private: // Data
+  static const uint32_t kSampleCount = 3;
+};
+
+// GPU timestamps are handled as 32-bit counter values
+const uint32_t kGpuTimestampBits = 32;
+
 } // namespace i915
 } // namespace utils
 
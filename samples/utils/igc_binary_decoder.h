@@ -11,7 +11,7 @@
 #include <igc/ocl_igc_shared/executable_format/patch_list.h>
 #include <MD/metrics_discovery_internal_api.h>
 
-#include "gen_binary_decoder.h"
+#include "disassembly_cache.h"
 
 using namespace iOpenCL;
 
@@ -45,8 +45,8 @@ class IgcBinaryDecoder {
         std::vector<uint8_t> raw_binary(kernel_header->KernelHeapSize);
         memcpy(raw_binary.data(), ptr,
                kernel_header->KernelHeapSize * sizeof(uint8_t));
-        GenBinaryDecoder decoder(raw_binary, arch);
-        return decoder.Disassemble();
+        utils::DisassemblyCache cache;
+        return cache.Disassemble(raw_binary, arch);
       }
 
       ptr += kernel_header->PatchListSize +
@@ -0,0 +1,138 @@
+//==============================================================
+// Copyright (C) Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#ifndef PTI_SAMPLES_UTILS_INTERVAL_JOIN_H_
+#define PTI_SAMPLES_UTILS_INTERVAL_JOIN_H_
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "pti_assert.h"
+
+namespace utils {
+
+struct TimeInterval {
+  uint64_t start;
+  uint64_t end;
+};
+
+// Range of sample indices [first, last) falling into the interval
+struct SampleRange {
+  size_t first;
+  size_t last;
+};
+
+namespace interval_join {
+
+// Sweeps intervals sorted by start and, separately, by end, advancing
+// sample cursors monotonically. Handles [begin, end) part of the orders
+inline void Sweep(const std::vector<uint64_t>& timestamp_list,
+                  const std::vector<TimeInterval>& interval_list,
+                  const std::vector<size_t>& start_order,
+                  const std::vector<size_t>& end_order,
+                  size_t begin, size_t end,
+                  std::vector<SampleRange>& range_list) {
+  if (begin == end) {
+    return;
+  }
+
+  size_t first = std::lower_bound(
+      timestamp_list.begin(), timestamp_list.end(),
+      interval_list[start_order[begin]].start) - timestamp_list.begin();
+  for (size_t i = begin; i < end; ++i) {
+    const TimeInterval& interval = interval_list[start_order[i]];
+    while (first < timestamp_list.size() &&
+           timestamp_list[first] < interval.start) {
+      ++first;
+    }
+    range_list[start_order[i]].first = first;
+  }
+
+  size_t last = std::upper_bound(
+      timestamp_list.begin(), timestamp_list.end(),
+      interval_list[end_order[begin]].end) - timestamp_list.begin();
+  for (size_t i = begin; i < end; ++i) {
+    const TimeInterval& interval = interval_list[end_order[i]];
+    while (last < timestamp_list.size() &&
+           timestamp_list[last] <= interval.end) {
+      ++last;
+    }
+    range_list[end_order[i]].last = last;
+  }
+}
+
+} // namespace interval_join
+
+// Point-in-interval join: for every interval finds the samples with
+// timestamps in [start, end]. Samples must be sorted by time (as metric
+// reports are), intervals are sorted internally, so the cost is
+// O(N log N) for intervals and a single linear pass over the samples.
+// Interval set may be split into thread_count time ranges processed
+// in parallel. Since matching samples are contiguous, sample values
+// are better aggregated with prefix sums over the returned ranges
+inline std::vector<SampleRange> JoinIntervals(
+    const std::vector<uint64_t>& timestamp_list,
+    const std::vector<TimeInterval>& interval_list,
+    size_t thread_count = 1) {
+  PTI_ASSERT(std::is_sorted(timestamp_list.begin(), timestamp_list.end()));
+  PTI_ASSERT(thread_count > 0);
+
+  std::vector<SampleRange> range_list(interval_list.size(), {0, 0});
+  if (interval_list.empty()) {
+    return range_list;
+  }
+
+  // Interval i gets both cursors from the same partition, so partitions
+  // are formed over start order and end order is built per partition
+  std::vector<size_t> start_order(interval_list.size());
+  std::iota(start_order.begin(), start_order.end(), 0);
+  std::sort(start_order.begin(), start_order.end(),
+            [&interval_list](size_t left, size_t right) {
+              return interval_list[left].start < interval_list[right].start;
+            });
+
+  std::vector<size_t> end_order(start_order);
+  size_t partition_count = std::min(thread_count, interval_list.size());
+  size_t partition_size =
+    (interval_list.size() + partition_count - 1) / partition_count;
+
+  auto process = [&](size_t begin, size_t end) {
+    std::sort(end_order.begin() + begin, end_order.begin() + end,
+              [&interval_list](size_t left, size_t right) {
+                return interval_list[left].end < interval_list[right].end;
+              });
+    interval_join::Sweep(timestamp_list, interval_list,
+                         start_order, end_order, begin, end, range_list);
+  };
+
+  std::vector<std::thread> thread_list;
+  for (size_t begin = partition_size; begin < interval_list.size();
+       begin += partition_size) {
+    size_t end = std::min(begin + partition_size, interval_list.size());
+    thread_list.push_back(std::thread(process, begin, end));
+  }
+  process(0, std::min(partition_size, interval_list.size()));
+
+  for (auto& thread : thread_list) {
+    thread.join();
+  }
+
+  for (auto& range : range_list) {
+    if (range.last < range.first) { // No samples inside
+      range.last = range.first;
+    }
+  }
+
+  return range_list;
+}
+
+} // namespace utils
+
+#endif // PTI_SAMPLES_UTILS_INTERVAL_JOIN_H_
\ No newline at end of file
@@ -0,0 +1,127 @@
+//==============================================================
+// Copyright (C) Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#ifndef PTI_SAMPLES_UTILS_KERNEL_INFO_ACCUMULATOR_H_
+#define PTI_SAMPLES_UTILS_KERNEL_INFO_ACCUMULATOR_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <new>
+#include <string>
+
+#include "pti_assert.h"
+
+namespace utils {
+
+// Lock-sharded storage for per-kernel statistics. Every host thread is
+// bound to one of the shards, so threads reporting kernel completions
+// do not contend on a single lock. Shards are merged at report time only.
+// Info is expected to have total_time, min_time, max_time, call_count,
+// simd_width and bytes_transferred fields
+template <typename Key, typename Info>
+class KernelInfoAccumulator {
+ public: // User Interface
+  // Shards are placed into the buffer at the cache line boundary, as the
+  // accumulator is a member of heap-allocated collectors and operator new
+  // gives no extended alignment before C++17
+  KernelInfoAccumulator() {
+    uintptr_t address = reinterpret_cast<uintptr_t>(storage_);
+    address = (address + alignof(Shard) - 1) & ~(alignof(Shard) - 1);
+    shard_list_ = reinterpret_cast<Shard*>(address);
+    for (size_t i = 0; i < kShardCount; ++i) {
+      new (shard_list_ + i) Shard;
+    }
+  }
+
+  ~KernelInfoAccumulator() {
+    for (size_t i = 0; i < kShardCount; ++i) {
+      shard_list_[i].~Shard();
+    }
+  }
+
+  KernelInfoAccumulator(const KernelInfoAccumulator& copy) = delete;
+  KernelInfoAccumulator& operator=(
+      const KernelInfoAccumulator& copy) = delete;
+
+  void AddKernelInfo(
+      const Key& key, uint64_t time,
+      size_t simd_width, size_t bytes_transferred) {
+    Shard& shard = shard_list_[GetShardId()];
+    const std::lock_guard<std::mutex> lock(shard.lock);
+
+    auto result = shard.info_map.emplace(
+        key, Info{time, time, time, 1, simd_width, bytes_transferred});
+    if (!result.second) {
+      Info& kernel = result.first->second;
+      kernel.total_time += time;
+      if (time > kernel.max_time) {
+        kernel.max_time = time;
+      }
+      if (time < kernel.min_time) {
+        kernel.min_time = time;
+      }
+      kernel.call_count += 1;
+      kernel.bytes_transferred += bytes_transferred;
+      PTI_ASSERT(kernel.simd_width == simd_width);
+    }
+  }
+
+  std::map<Key, Info> GetKernelInfoMap() const {
+    std::map<Key, Info> info_map;
+    for (size_t i = 0; i < kShardCount; ++i) {
+      const Shard& shard = shard_list_[i];
+      const std::lock_guard<std::mutex> lock(shard.lock);
+      for (auto& value : shard.info_map) {
+        Merge(info_map, value.first, value.second);
+      }
+    }
+    return info_map;
+  }
+
+ private: // Implementation Details
+  // Starts at the cache line boundary and takes whole lines to avoid
+  // false sharing between the shards
+  struct alignas(64) Shard {
+    mutable std::mutex lock;
+    std::map<Key, Info> info_map;
+  };
+
+  static size_t GetShardId() {
+    static std::atomic<size_t> thread_count{0};
+    static thread_local size_t shard_id = (thread_count++) % kShardCount;
+    return shard_id;
+  }
+
+  static void Merge(std::map<Key, Info>& info_map,
+                    const Key& key, const Info& info) {
+    auto result = info_map.emplace(key, info);
+    if (!result.second) {
+      Info& kernel = result.first->second;
+      kernel.total_time += info.total_time;
+      if (info.max_time > kernel.max_time) {
+        kernel.max_time = info.max_time;
+      }
+      if (info.min_time < kernel.min_time) {
+        kernel.min_time = info.min_time;
+      }
+      kernel.call_count += info.call_count;
+      kernel.bytes_transferred += info.bytes_transferred;
+      PTI_ASSERT(kernel.simd_width == info.simd_width);
+    }
+  }
+
+ private: // Data
+  static const size_t kShardCount = 16;
+  uint8_t storage_[(kShardCount + 1) * sizeof(Shard)];
+  Shard* shard_list_ = nullptr;
+};
+
+} // namespace utils
+
+#endif // PTI_SAMPLES_UTILS_KERNEL_INFO_ACCUMULATOR_H_
\ No newline at end of file
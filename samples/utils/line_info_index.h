@@ -0,0 +1,134 @@
+//==============================================================
+// Copyright (C) Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#ifndef PTI_SAMPLES_UTILS_LINE_INFO_INDEX_H_
+#define PTI_SAMPLES_UTILS_LINE_INFO_INDEX_H_
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "dwarf_state_machine.h"
+#include "pti_assert.h"
+
+// Half-open range [start, end) of kernel addresses mapped to source line
+struct AddressRange {
+  uint64_t start;
+  uint64_t end;
+  uint32_t file;
+  uint32_t line;
+};
+
+// Address-to-source index over the line table produced by
+// DwarfStateMachine. Every line table row covers addresses up to the next
+// row (or up to the end address for the last one). Rows are kept in
+// their original order, while lookups go through two sorted permutations:
+// by start address (for LookupAddress) and by file and line (for
+// RangesForLine), so each query is a binary search instead of a scan
+class LineInfoIndex {
+ public: // User Interface
+  LineInfoIndex() {}
+
+  LineInfoIndex(const std::vector<LineInfo>& line_info_list,
+                uint64_t end_address) {
+    for (size_t i = 0; i < line_info_list.size(); ++i) {
+      uint64_t start = line_info_list[i].address;
+      uint64_t end = (i + 1 < line_info_list.size()) ?
+                     line_info_list[i + 1].address : end_address;
+      if (start >= end) { // Empty range
+        continue;
+      }
+      range_list_.push_back(
+          {start, end, line_info_list[i].file, line_info_list[i].line});
+    }
+
+    PTI_ASSERT(range_list_.size() < (std::numeric_limits<uint32_t>::max)());
+    address_order_.resize(range_list_.size());
+    for (uint32_t i = 0; i < address_order_.size(); ++i) {
+      address_order_[i] = i;
+    }
+    line_order_ = address_order_;
+
+    std::stable_sort(address_order_.begin(), address_order_.end(),
+                     [this](uint32_t left, uint32_t right) {
+                       return range_list_[left].start <
+                              range_list_[right].start;
+                     });
+
+    // Rows may go back in address, so ranges sorted by start may
+    // overlap: keep running maximum of range ends to bound the search
+    max_end_list_.resize(address_order_.size());
+    uint64_t max_end = 0;
+    for (size_t i = 0; i < address_order_.size(); ++i) {
+      max_end = (std::max)(max_end, range_list_[address_order_[i]].end);
+      max_end_list_[i] = max_end;
+    }
+
+    std::stable_sort(line_order_.begin(), line_order_.end(),
+                     [this](uint32_t left, uint32_t right) {
+                       return GetLineKey(range_list_[left]) <
+                              GetLineKey(range_list_[right]);
+                     });
+  }
+
+  bool IsEmpty() const {
+    return range_list_.empty();
+  }
+
+  // Returns the range with the greatest start containing the address,
+  // or nullptr if the address is not covered by the line table
+  const AddressRange* LookupAddress(uint64_t address) const {
+    size_t i = std::upper_bound(
+        address_order_.begin(), address_order_.end(), address,
+        [this](uint64_t value, uint32_t index) {
+          return value < range_list_[index].start;
+        }) - address_order_.begin();
+
+    while (i > 0 && max_end_list_[i - 1] > address) {
+      --i;
+      const AddressRange& range = range_list_[address_order_[i]];
+      if (address < range.end) {
+        return &range;
+      }
+    }
+
+    return nullptr;
+  }
+
+  // Returns all the ranges of the source line in line table order
+  std::vector<AddressRange> RangesForLine(uint32_t file, uint32_t line) const {
+    uint64_t key = GetLineKey({0, 0, file, line});
+    auto first = std::lower_bound(
+        line_order_.begin(), line_order_.end(), key,
+        [this](uint32_t index, uint64_t value) {
+          return GetLineKey(range_list_[index]) < value;
+        });
+
+    std::vector<AddressRange> range_list;
+    for (auto it = first; it != line_order_.end(); ++it) {
+      if (GetLineKey(range_list_[*it]) != key) {
+        break;
+      }
+      range_list.push_back(range_list_[*it]);
+    }
+    return range_list;
+  }
+
+ private: // Implementation Details
+  static uint64_t GetLineKey(const AddressRange& range) {
+    return (static_cast<uint64_t>(range.file) << 32) | range.line;
+  }
+
+ private: // Data
+  std::vector<AddressRange> range_list_;
+  std::vector<uint32_t> address_order_;
+  std::vector<uint64_t> max_end_list_;
+  std::vector<uint32_t> line_order_;
+};
+
+#endif // PTI_SAMPLES_UTILS_LINE_INFO_INDEX_H_
\ No newline at end of file
@@ -0,0 +1,126 @@
+//==============================================================
+// Copyright (C) Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#ifndef PTI_SAMPLES_UTILS_MAPPED_FILE_H_
+#define PTI_SAMPLES_UTILS_MAPPED_FILE_H_
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <stdint.h>
+
+#include <string>
+
+#include "pti_assert.h"
+
+namespace utils {
+
+// Read-only memory mapping of the whole file, an alternative to
+// LoadBinaryFile() for large binaries that are parsed in place
+// (e.g. with ElfParser) and never copied
+class MappedFile {
+ public: // User Interface
+  MappedFile(const std::string& path) {
+#if defined(_WIN32)
+    file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_ == INVALID_HANDLE_VALUE) {
+      return;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file_, &size) || size.QuadPart == 0) {
+      return;
+    }
+
+    mapping_ = CreateFileMappingA(
+        file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping_ == nullptr) {
+      return;
+    }
+
+    void* data = MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0);
+    if (data == nullptr) {
+      return;
+    }
+
+    data_ = reinterpret_cast<const uint8_t*>(data);
+    size_ = static_cast<size_t>(size.QuadPart);
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+      close(fd);
+      return;
+    }
+
+    void* data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // Mapping stays valid after the descriptor is closed
+    if (data == MAP_FAILED) {
+      return;
+    }
+
+    data_ = reinterpret_cast<const uint8_t*>(data);
+    size_ = static_cast<size_t>(info.st_size);
+#endif
+  }
+
+  ~MappedFile() {
+#if defined(_WIN32)
+    if (data_ != nullptr) {
+      UnmapViewOfFile(data_);
+    }
+    if (mapping_ != nullptr) {
+      CloseHandle(mapping_);
+    }
+    if (file_ != INVALID_HANDLE_VALUE) {
+      CloseHandle(file_);
+    }
+#else
+    if (data_ != nullptr) {
+      int status = munmap(const_cast<uint8_t*>(data_), size_);
+      PTI_ASSERT(status == 0);
+    }
+#endif
+  }
+
+  bool IsValid() const {
+    return data_ != nullptr;
+  }
+
+  const uint8_t* GetData() const {
+    return data_;
+  }
+
+  size_t GetSize() const {
+    return size_;
+  }
+
+  MappedFile(const MappedFile& copy) = delete;
+  MappedFile& operator=(const MappedFile& copy) = delete;
+
+ private: // Data
+  const uint8_t* data_ = nullptr;
+  size_t size_ = 0;
+#if defined(_WIN32)
+  HANDLE file_ = INVALID_HANDLE_VALUE;
+  HANDLE mapping_ = nullptr;
+#endif
+};
+
+} // namespace utils
+
+#endif // PTI_SAMPLES_UTILS_MAPPED_FILE_H_
\ No newline at end of file
@@ -0,0 +1,247 @@
+//==============================================================
+// Copyright (C) Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#ifndef PTI_SAMPLES_UTILS_SAMPLING_POLICY_H_
+#define PTI_SAMPLES_UTILS_SAMPLING_POLICY_H_
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <iostream>
+#include <limits>
+#include <string>
+#include <unordered_map>
+
+#include "pti_assert.h"
+#include "utils.h"
+
+namespace utils {
+
+enum SamplingMode {
+  SAMPLING_MODE_ALL = 0,
+  SAMPLING_MODE_FIXED_RATE = 1, // Every N-th run of each kernel
+  SAMPLING_MODE_FIRST_N = 2, // First N runs of each kernel
+  SAMPLING_MODE_TIME_BUDGET = 3 // Profiled runs take up to N% of the time
+};
+
+struct SamplingStats {
+  uint64_t run_count;
+  uint64_t sampled_count;
+  uint64_t profiled_count; // Sampled runs that are complete
+  uint64_t profiled_time;
+  uint64_t pending_time; // Expected time of incomplete sampled runs
+};
+
+// Decides per kernel run whether it is to be profiled. Kernels are given
+// by an opaque key and host time is passed by the caller, so the policy
+// can be driven with synthetic runs. It is not thread-safe, callers are
+// expected to serialize the calls.
+//
+// In time budget mode each kernel has its first run profiled, then runs
+// are profiled while the time of profiled runs stays within the budget
+// share of the time since the first run. Runs are charged on decision
+// with the average profiled time of the kernel, as they may complete
+// long after the launch, and the charge is corrected on completion
+class SamplingPolicy {
+ public: // User Interface
+  SamplingPolicy(SamplingMode mode = SAMPLING_MODE_ALL, uint64_t value = 0)
+      : mode_(mode), value_(value) {
+    PTI_ASSERT(mode_ == SAMPLING_MODE_ALL || value_ > 0);
+    PTI_ASSERT(mode_ != SAMPLING_MODE_TIME_BUDGET || value_ <= 100);
+  }
+
+  SamplingMode GetMode() const {
+    return mode_;
+  }
+
+  bool Sample(uint64_t kernel, uint64_t time) {
+    if (run_count_ == 0) {
+      start_time_ = time;
+    }
+    ++run_count_;
+
+    SamplingStats& stats = stats_map_[kernel];
+    bool sample = false;
+    switch (mode_) {
+      case SAMPLING_MODE_ALL:
+        sample = true;
+        break;
+      case SAMPLING_MODE_FIXED_RATE:
+        sample = (stats.run_count % value_ == 0);
+        break;
+      case SAMPLING_MODE_FIRST_N:
+        sample = (stats.run_count < value_);
+        break;
+      case SAMPLING_MODE_TIME_BUDGET:
+        sample = SampleInBudget(stats, time);
+        break;
+      default:
+        PTI_ASSERT(0);
+        break;
+    }
+
+    ++stats.run_count;
+    if (sample) {
+      ++stats.sampled_count;
+    }
+    return sample;
+  }
+
+  // Reports completion of the sampled run and its host time
+  void Complete(uint64_t kernel, uint64_t time) {
+    auto it = stats_map_.find(kernel);
+    PTI_ASSERT(it != stats_map_.end());
+    SamplingStats& stats = it->second;
+    PTI_ASSERT(stats.profiled_count < stats.sampled_count);
+
+    uint64_t charge =
+      stats.pending_time / (stats.sampled_count - stats.profiled_count);
+    stats.pending_time -= charge;
+    PTI_ASSERT(pending_time_ >= charge);
+    pending_time_ -= charge;
+
+    stats.profiled_time += time;
+    ++stats.profiled_count;
+    profiled_time_ += time;
+  }
+
+  SamplingStats GetStats(uint64_t kernel) const {
+    auto it = stats_map_.find(kernel);
+    if (it == stats_map_.end()) {
+      return SamplingStats{0, 0, 0, 0, 0};
+    }
+    return it->second;
+  }
+
+ private: // Implementation Details
+  bool SampleInBudget(SamplingStats& stats, uint64_t time) {
+    if (stats.sampled_count == 0) {
+      return true;
+    }
+    if (stats.profiled_count == 0) { // Cost is not known yet
+      return false;
+    }
+
+    uint64_t estimate = stats.profiled_time / stats.profiled_count;
+    uint64_t elapsed = (time > start_time_) ? time - start_time_ : 0;
+    double spent = static_cast<double>(
+        profiled_time_ + pending_time_ + estimate);
+    if (spent * 100 > static_cast<double>(value_) * elapsed) {
+      return false;
+    }
+
+    stats.pending_time += estimate;
+    pending_time_ += estimate;
+    return true;
+  }
+
+ private: // Data
+  SamplingMode mode_;
+  uint64_t value_;
+  std::unordered_map<uint64_t, SamplingStats> stats_map_;
+
+  uint64_t run_count_ = 0;
+  uint64_t start_time_ = 0;
+  uint64_t profiled_time_ = 0;
+  uint64_t pending_time_ = 0;
+};
+
+struct SampleEstimate {
+  double value;
+  double error;
+};
+
+// Per-run mean of the value over all the runs estimated from the sampled
+// ones, given the sum and the sum of squares of the sampled values. Error
+// is the standard error with finite population correction, it is zero
+// if all the runs are sampled and infinite if only one of many is
+inline SampleEstimate EstimateMean(double sum, double sum_squares,
+                                   uint64_t sampled_count,
+                                   uint64_t run_count) {
+  PTI_ASSERT(sampled_count > 0);
+  PTI_ASSERT(sampled_count <= run_count);
+  double n = static_cast<double>(sampled_count);
+  double mean = sum / n;
+  if (sampled_count == run_count) {
+    return {mean, 0.0};
+  }
+  if (sampled_count == 1) {
+    return {mean, std::numeric_limits<double>::infinity()};
+  }
+
+  double variance = (sum_squares - n * mean * mean) / (n - 1);
+  if (variance < 0.0) { // Rounding
+    variance = 0.0;
+  }
+  double correction = 1.0 - n / static_cast<double>(run_count);
+  return {mean, sqrt(variance / n * correction)};
+}
+
+// Tool options are passed to the tool library through the environment
+inline void PrintSamplingUsage() {
+  std::cout <<
+    "--sampling-rate <N>             Profile every N-th run of each kernel" <<
+    std::endl;
+  std::cout <<
+    "--sampling-first <N>            Profile first N runs of each kernel" <<
+    std::endl;
+  std::cout <<
+    "--sampling-budget <P>           Profile kernel runs while they take " <<
+    "up to P% of the time" << std::endl;
+}
+
+// Returns the number of arguments consumed, zero if the argument is not
+// a sampling option
+inline int ParseSamplingArg(int argc, char* argv[], int index) {
+  PTI_ASSERT(index < argc);
+  const char* mode = nullptr;
+  if (strcmp(argv[index], "--sampling-rate") == 0) {
+    mode = "rate";
+  } else if (strcmp(argv[index], "--sampling-first") == 0) {
+    mode = "first";
+  } else if (strcmp(argv[index], "--sampling-budget") == 0) {
+    mode = "budget";
+  } else {
+    return 0;
+  }
+
+  if (index + 1 >= argc) {
+    std::cout << "[WARNING] Value is missing for " << argv[index] <<
+      std::endl;
+    return 1;
+  }
+  SetEnv((std::string("PTI_SamplingMode=") + mode).c_str());
+  SetEnv((std::string("PTI_SamplingValue=") + argv[index + 1]).c_str());
+  return 2;
+}
+
+inline SamplingPolicy GetSamplingPolicy() {
+  std::string mode = GetEnv("PTI_SamplingMode");
+  if (mode.empty()) {
+    return SamplingPolicy();
+  }
+
+  uint64_t value = strtoull(GetEnv("PTI_SamplingValue").c_str(), nullptr, 0);
+  if (mode == "rate" && value > 0) {
+    return SamplingPolicy(SAMPLING_MODE_FIXED_RATE, value);
+  }
+  if (mode == "first" && value > 0) {
+    return SamplingPolicy(SAMPLING_MODE_FIRST_N, value);
+  }
+  if (mode == "budget" && value > 0 && value <= 100) {
+    return SamplingPolicy(SAMPLING_MODE_TIME_BUDGET, value);
+  }
+
+  std::cerr << "[WARNING] Invalid sampling mode, all the kernel runs " <<
+    "will be profiled" << std::endl;
+  return SamplingPolicy();
+}
+
+} // namespace utils
+
+#endif // PTI_SAMPLES_UTILS_SAMPLING_POLICY_H_
\ No newline at end of file
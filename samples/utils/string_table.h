@@ -0,0 +1,91 @@
+//==============================================================
+// Copyright (C) Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#ifndef PTI_SAMPLES_UTILS_STRING_TABLE_H_
+#define PTI_SAMPLES_UTILS_STRING_TABLE_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "pti_assert.h"
+
+namespace utils {
+
+// Append-only table of interned strings (e.g. kernel names). Every string
+// gets a stable 32-bit identifier; strings are never moved or removed,
+// so references returned by GetString() stay valid till the process end.
+// Interning takes a lock, while lookup by identifier is lock-free
+class StringTable {
+ public: // User Interface
+  uint32_t Intern(const std::string& str) {
+    const std::lock_guard<std::mutex> lock(lock_);
+
+    auto it = id_map_.find(str);
+    if (it != id_map_.end()) {
+      return it->second;
+    }
+
+    uint32_t id = size_.load(std::memory_order_relaxed);
+    uint32_t chunk_id = id / kChunkSize;
+    PTI_ASSERT(chunk_id < kChunkCount);
+
+    std::string* chunk = chunk_list_[chunk_id].load(std::memory_order_relaxed);
+    if (chunk == nullptr) {
+      chunk = new std::string[kChunkSize];
+      PTI_ASSERT(chunk != nullptr);
+      chunk_list_[chunk_id].store(chunk, std::memory_order_release);
+    }
+
+    chunk[id % kChunkSize] = str;
+    id_map_[str] = id;
+    size_.store(id + 1, std::memory_order_release);
+    return id;
+  }
+
+  const std::string& GetString(uint32_t id) const {
+    PTI_ASSERT(id < size_.load(std::memory_order_acquire));
+    std::string* chunk =
+      chunk_list_[id / kChunkSize].load(std::memory_order_acquire);
+    PTI_ASSERT(chunk != nullptr);
+    return chunk[id % kChunkSize];
+  }
+
+  uint32_t GetSize() const {
+    return size_.load(std::memory_order_acquire);
+  }
+
+ private: // Data
+  static const uint32_t kChunkSize = 1024;
+  static const uint32_t kChunkCount = 4096;
+
+  std::mutex lock_;
+  std::unordered_map<std::string, uint32_t> id_map_;
+  std::atomic<std::string*> chunk_list_[kChunkCount] = {};
+  std::atomic<uint32_t> size_{0};
+};
+
+// Process-wide table shared by all the collectors. It is never destroyed
+// to stay available for reporting from library destructors
+inline StringTable& GetStringTable() {
+  static StringTable* table = new StringTable;
+  return *table;
+}
+
+inline uint32_t InternString(const std::string& str) {
+  return GetStringTable().Intern(str);
+}
+
+inline const std::string& GetInternedString(uint32_t id) {
+  return GetStringTable().GetString(id);
+}
+
+} // namespace utils
+
+#endif // PTI_SAMPLES_UTILS_STRING_TABLE_H_
\ No newline at end of file
@@ -0,0 +1,164 @@
+//==============================================================
+// Copyright (C) Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#ifndef PTI_SAMPLES_UTILS_TICK_CONVERTER_H_
+#define PTI_SAMPLES_UTILS_TICK_CONVERTER_H_
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "pti_assert.h"
+#include "utils.h"
+
+namespace utils {
+
+// (value * mult) >> shift over the full 128-bit product, shift should be
+// in [1, 63] range. No 128-bit types, so it is portable and has the same
+// steps as the vector version in TickConverter
+inline uint64_t MulShift(uint64_t value, uint64_t mult, uint32_t shift) {
+  uint64_t value_low = value & 0xFFFFFFFF, value_high = value >> 32;
+  uint64_t mult_low = mult & 0xFFFFFFFF, mult_high = mult >> 32;
+
+  uint64_t low = value_low * mult_low;
+  uint64_t cross_1 = value_high * mult_low;
+  uint64_t cross_2 = value_low * mult_high;
+  uint64_t high = value_high * mult_high;
+
+  uint64_t middle = (low >> 32) + (cross_1 & 0xFFFFFFFF) +
+    (cross_2 & 0xFFFFFFFF);
+  high += (cross_1 >> 32) + (cross_2 >> 32) + (middle >> 32);
+  low = (middle << 32) | (low & 0xFFFFFFFF);
+
+  return (high << (64 - shift)) | (low >> shift);
+}
+
+// Device timer ticks to nanoseconds without division: reciprocal of the
+// frequency is computed once as fixed-point value with the largest
+// shift that keeps it below 2^62. Conversion never overflows while the
+// result fits into 64 bits and is off by at most 1 ns for tick values
+// below 2^shift (e.g. 2^56 ticks for 19.2 MHz timer)
+class TickConverter {
+ public: // User Interface
+  TickConverter(uint64_t frequency) {
+    PTI_ASSERT(frequency > 0 && frequency < (1ULL << 62));
+
+    // Long division of NSEC_IN_SEC * 2^shift by frequency
+    mult_ = NSEC_IN_SEC / frequency;
+    uint64_t remainder = NSEC_IN_SEC % frequency;
+    while (shift_ < kMaxShift && mult_ < (1ULL << 61)) {
+      mult_ <<= 1;
+      remainder <<= 1;
+      if (remainder >= frequency) {
+        remainder -= frequency;
+        mult_ |= 1;
+      }
+      ++shift_;
+    }
+    PTI_ASSERT(shift_ > 0);
+  }
+
+  uint64_t ToNs(uint64_t ticks) const {
+    return MulShift(ticks, mult_, shift_);
+  }
+
+  // Converts the whole array in one pass, in place is allowed
+  void ToNs(const uint64_t* ticks, uint64_t* ns, size_t count) const {
+    PTI_ASSERT(count == 0 || (ticks != nullptr && ns != nullptr));
+    size_t i = 0;
+
+#if defined(__SSE2__) || defined(_M_X64)
+    // Same math as in MulShift() for two values at once: SSE2 has no
+    // 64-bit multiply, but has 32x32->64 one, so compilers do not
+    // vectorize the plain loop without wider instruction sets enabled
+    const __m128i mask = _mm_set1_epi64x(0xFFFFFFFF);
+    const __m128i mult_low = _mm_set1_epi64x(mult_ & 0xFFFFFFFF);
+    const __m128i mult_high = _mm_set1_epi64x(mult_ >> 32);
+    const __m128i left = _mm_cvtsi32_si128(64 - shift_);
+    const __m128i right = _mm_cvtsi32_si128(shift_);
+
+    for (; i + 2 <= count; i += 2) {
+      __m128i value = _mm_loadu_si128(
+          reinterpret_cast<const __m128i*>(ticks + i));
+      __m128i value_high = _mm_srli_epi64(value, 32);
+
+      __m128i low = _mm_mul_epu32(value, mult_low);
+      __m128i cross_1 = _mm_mul_epu32(value_high, mult_low);
+      __m128i cross_2 = _mm_mul_epu32(value, mult_high);
+      __m128i high = _mm_mul_epu32(value_high, mult_high);
+
+      __m128i middle = _mm_add_epi64(
+          _mm_add_epi64(_mm_srli_epi64(low, 32), _mm_and_si128(cross_1, mask)),
+          _mm_and_si128(cross_2, mask));
+      high = _mm_add_epi64(
+          _mm_add_epi64(high, _mm_srli_epi64(middle, 32)),
+          _mm_add_epi64(_mm_srli_epi64(cross_1, 32),
+                        _mm_srli_epi64(cross_2, 32)));
+      low = _mm_or_si128(_mm_slli_epi64(middle, 32), _mm_and_si128(low, mask));
+
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(ns + i),
+                       _mm_or_si128(_mm_sll_epi64(high, left),
+                                    _mm_srl_epi64(low, right)));
+    }
+#endif
+
+    for (; i < count; ++i) {
+      ns[i] = MulShift(ticks[i], mult_, shift_);
+    }
+  }
+
+  void ToNs(std::vector<uint64_t>& ticks) const {
+    ToNs(ticks.data(), ticks.data(), ticks.size());
+  }
+
+ private: // Data
+  uint64_t mult_ = 0;
+  uint32_t shift_ = 0;
+
+  static const uint32_t kMaxShift = 63;
+};
+
+// Turns values of the counter narrower than 64 bits into monotonic 64-bit
+// stream. The first value is taken as is, every next one is expected to
+// be less than one counter period after the previous one
+class CounterUnwrapper {
+ public: // User Interface
+  CounterUnwrapper(uint32_t counter_bits)
+      : mask_(counter_bits < 64 ? (1ULL << counter_bits) - 1 : ~0ULL) {
+    PTI_ASSERT(counter_bits > 0 && counter_bits <= 64);
+  }
+
+  uint64_t Unwrap(uint64_t value) {
+    if (empty_) {
+      empty_ = false;
+      last_ = value;
+    } else {
+      last_ += (value - last_) & mask_;
+    }
+    return last_;
+  }
+
+  // Unwraps the array in place
+  void Unwrap(uint64_t* value_list, size_t count) {
+    PTI_ASSERT(count == 0 || value_list != nullptr);
+    for (size_t i = 0; i < count; ++i) {
+      value_list[i] = Unwrap(value_list[i]);
+    }
+  }
+
+ private: // Data
+  uint64_t mask_;
+  uint64_t last_ = 0;
+  bool empty_ = true;
+};
+
+} // namespace utils
+
+#endif // PTI_SAMPLES_UTILS_TICK_CONVERTER_H_
\ No newline at end of file
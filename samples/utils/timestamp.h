@@ -0,0 +1,290 @@
+//==============================================================
+// Copyright (C) Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#ifndef PTI_SAMPLES_UTILS_TIMESTAMP_H_
+#define PTI_SAMPLES_UTILS_TIMESTAMP_H_
+
+#if defined(__gnu_linux__)
+#include <time.h>
+#endif
+
+#if defined(__gnu_linux__) && defined(__x86_64__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include "pti_assert.h"
+#include "utils.h"
+
+namespace utils {
+
+#if defined(__gnu_linux__) && defined(__x86_64__)
+
+// Host clock based on the invariant TSC. Ticks are converted to
+// nanoseconds with a single fixed-point multiply. The rate is calibrated
+// against CLOCK_MONOTONIC_RAW over the whole run, while the offset
+// follows CLOCK_MONOTONIC, so values are in the same time base as
+// std::chrono::steady_clock. Recalibration is done on read once per
+// period by one of the calling threads: the error is slewed out (or
+// stepped forward if it is large), so the clock never goes backwards
+class TscClock {
+ public: // User Interface
+  bool IsValid() const {
+    return valid_;
+  }
+
+  uint64_t GetTime() {
+    PTI_ASSERT(valid_);
+    uint64_t tsc = __rdtsc();
+
+    Calibration calibration;
+    uint32_t sequence = 0;
+    do {
+      sequence = sequence_.load(std::memory_order_acquire);
+      calibration.tsc = tsc_.load(std::memory_order_relaxed);
+      calibration.time = time_.load(std::memory_order_relaxed);
+      calibration.mult = mult_.load(std::memory_order_relaxed);
+      calibration.period = period_.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+    } while ((sequence & 1) || sequence != sequence_.load(
+                 std::memory_order_relaxed));
+
+    if (tsc > calibration.tsc && tsc - calibration.tsc >= calibration.period) {
+      if (!calibrating_.test_and_set(std::memory_order_acquire)) {
+        Calibrate(calibration);
+        calibrating_.clear(std::memory_order_release);
+      }
+    }
+
+    return Convert(calibration, tsc);
+  }
+
+  TscClock(const TscClock& copy) = delete;
+  TscClock& operator=(const TscClock& copy) = delete;
+
+ private: // Implementation Details
+  friend TscClock& GetTscClock();
+
+  struct Sample {
+    uint64_t tsc;
+    uint64_t raw;
+    int64_t offset; // CLOCK_MONOTONIC - CLOCK_MONOTONIC_RAW
+  };
+
+  struct Calibration {
+    uint64_t tsc;
+    uint64_t time;
+    uint64_t mult;
+    uint64_t period; // In ticks
+  };
+
+  TscClock() {
+    valid_ = IsTscUsable();
+    if (!valid_) {
+      return;
+    }
+
+    first_ = GetSample();
+    std::this_thread::sleep_for(std::chrono::milliseconds(kInitialPeriod));
+    Sample sample = GetSample();
+    PTI_ASSERT(sample.tsc > first_.tsc);
+
+    period_ns_ = kMinPeriod * NSEC_IN_MSEC;
+    uint64_t mult = GetMult(sample);
+    Publish({sample.tsc, sample.raw + sample.offset, mult,
+             GetTicks(period_ns_, mult)});
+  }
+
+  // Invariant TSC runs at a constant rate in all the power states, and
+  // current kernel clock source tells it is synchronized across CPUs
+  static bool IsTscUsable() {
+    unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) {
+      return false;
+    }
+    if ((edx & (1 << 8)) == 0) {
+      return false;
+    }
+
+    std::ifstream file(
+        "/sys/devices/system/clocksource/clocksource0/current_clocksource");
+    if (file.is_open()) {
+      std::string clock_source;
+      file >> clock_source;
+      return clock_source == "tsc";
+    }
+    return true;
+  }
+
+  static uint64_t ReadClock(clockid_t clock) {
+    timespec time;
+    int status = clock_gettime(clock, &time);
+    PTI_ASSERT(status == 0);
+    return time.tv_sec * static_cast<uint64_t>(NSEC_IN_SEC) + time.tv_nsec;
+  }
+
+  // Takes the best of a few attempts, so preemption between the reads
+  // does not spoil the sample
+  static Sample GetSample() {
+    Sample sample{0, 0, 0};
+    uint64_t best_window = UINT64_MAX;
+    for (uint32_t i = 0; i < kSampleCount; ++i) {
+      uint64_t start = __rdtsc();
+      uint64_t raw = ReadClock(CLOCK_MONOTONIC_RAW);
+      uint64_t end = __rdtsc();
+      if (end - start < best_window) {
+        best_window = end - start;
+        sample.tsc = start + (end - start) / 2;
+        sample.raw = raw;
+      }
+    }
+
+    uint64_t monotonic = ReadClock(CLOCK_MONOTONIC);
+    uint64_t raw = ReadClock(CLOCK_MONOTONIC_RAW);
+    sample.offset = static_cast<int64_t>(monotonic - raw);
+    return sample;
+  }
+
+  // Nanoseconds per tick in fixed point, measured since the very first
+  // sample, so the precision grows with the run
+  uint64_t GetMult(const Sample& sample) const {
+    PTI_ASSERT(sample.tsc > first_.tsc);
+    PTI_ASSERT(sample.raw > first_.raw);
+    unsigned __int128 time = sample.raw - first_.raw;
+    return static_cast<uint64_t>(
+        (time << kShift) / (sample.tsc - first_.tsc));
+  }
+
+  static uint64_t GetTicks(uint64_t time, uint64_t mult) {
+    PTI_ASSERT(mult > 0);
+    return static_cast<uint64_t>(
+        (static_cast<unsigned __int128>(time) << kShift) / mult);
+  }
+
+  static uint64_t Convert(const Calibration& calibration, uint64_t tsc) {
+    if (tsc <= calibration.tsc) { // Read before concurrent recalibration
+      return calibration.time;
+    }
+    unsigned __int128 ticks = tsc - calibration.tsc;
+    return calibration.time +
+      static_cast<uint64_t>((ticks * calibration.mult) >> kShift);
+  }
+
+  void Calibrate(const Calibration& calibration) {
+    Sample sample = GetSample();
+    if (sample.tsc <= calibration.tsc) {
+      return;
+    }
+
+    uint64_t mult = GetMult(sample);
+    uint64_t time = Convert(calibration, sample.tsc);
+    int64_t error = static_cast<int64_t>(sample.raw + sample.offset - time);
+
+    if (period_ns_ < kMaxPeriod * NSEC_IN_MSEC) {
+      period_ns_ *= 2;
+    }
+
+    if (error > static_cast<int64_t>(kMaxError)) {
+      time += error;
+    } else {
+      // Remove the error over the next period, limited to kMaxSlew ppm
+      int64_t max_slew = static_cast<int64_t>(mult / (1000000 / kMaxSlew));
+      int64_t slew = static_cast<int64_t>(
+          static_cast<__int128>(mult) * error / period_ns_);
+      if (slew > max_slew) {
+        slew = max_slew;
+      } else if (slew < -max_slew) {
+        slew = -max_slew;
+      }
+      mult += slew;
+    }
+
+    Publish({sample.tsc, time, mult, GetTicks(period_ns_, mult)});
+  }
+
+  // Single writer under calibrating_ flag, readers retry on odd or
+  // changed sequence
+  void Publish(const Calibration& calibration) {
+    uint32_t sequence = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    tsc_.store(calibration.tsc, std::memory_order_relaxed);
+    time_.store(calibration.time, std::memory_order_relaxed);
+    mult_.store(calibration.mult, std::memory_order_relaxed);
+    period_.store(calibration.period, std::memory_order_relaxed);
+    sequence_.store(sequence + 2, std::memory_order_release);
+  }
+
+ private: // Data
+  bool valid_ = false;
+  Sample first_{0, 0, 0};
+  uint64_t period_ns_ = 0;
+  std::atomic_flag calibrating_ = ATOMIC_FLAG_INIT;
+
+  std::atomic<uint32_t> sequence_{0};
+  std::atomic<uint64_t> tsc_{0};
+  std::atomic<uint64_t> time_{0};
+  std::atomic<uint64_t> mult_{0};
+  std::atomic<uint64_t> period_{0};
+
+  static const uint32_t kShift = 32;
+  static const uint32_t kSampleCount = 3;
+  static const uint32_t kInitialPeriod = 1; // ms
+  static const uint32_t kMinPeriod = 10; // ms
+  static const uint32_t kMaxPeriod = 1000; // ms
+  static const uint32_t kMaxSlew = 500; // ppm
+  static const uint64_t kMaxError = 100000; // ns
+};
+
+// Process-wide clock calibrated on the first use and never destroyed
+inline TscClock& GetTscClock() {
+  static TscClock* clock = new TscClock;
+  return *clock;
+}
+
+#endif // __gnu_linux__ && __x86_64__
+
+// Current host time in nanoseconds in the time base of
+// std::chrono::steady_clock. Calibrated TSC is used where possible,
+// with fallback to clock_gettime() (or steady_clock itself)
+inline uint64_t GetTimestamp() {
+#if defined(__gnu_linux__) && defined(__x86_64__)
+  TscClock& clock = GetTscClock();
+  if (clock.IsValid()) {
+    return clock.GetTime();
+  }
+#endif
+
+#if defined(__gnu_linux__)
+  timespec time;
+  int status = clock_gettime(CLOCK_MONOTONIC, &time);
+  PTI_ASSERT(status == 0);
+  return time.tv_sec * static_cast<uint64_t>(NSEC_IN_SEC) + time.tv_nsec;
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// Nanoseconds passed since the given steady_clock time point
+inline uint64_t GetTimestamp(
+    const std::chrono::steady_clock::time_point& base_time) {
+  uint64_t base = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      base_time.time_since_epoch()).count();
+  return GetTimestamp() - base;
+}
+
+} // namespace utils
+
+#endif // PTI_SAMPLES_UTILS_TIMESTAMP_H_
\ No newline at end of file
@@ -0,0 +1,463 @@
+//==============================================================
+// Copyright (C) Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#ifndef PTI_SAMPLES_UTILS_TRACE_FORMAT_H_
+#define PTI_SAMPLES_UTILS_TRACE_FORMAT_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "pti_assert.h"
+#include "utils.h"
+
+// Binary trace file layout (version 1, host byte order):
+//   TraceFileHeader
+//   { TraceChunkHeader, payload }*
+// Every chunk declares its payload size, so readers may skip unknown chunk
+// types. Strings and tracks are defined in the chunks preceding the first
+// event that refers them. Events are sorted by start time within a chunk
+// and keep start time as a delta from the previous event (chunk base
+// time for the first one)
+
+const char kTraceFileMagic[8] = {'P', 'T', 'I', 'T', 'R', 'A', 'C', 'E'};
+const uint32_t kTraceFileVersion = 1;
+
+enum TraceChunkType {
+  TRACE_CHUNK_PROCESS = 0,    // Process name, count is zero
+  TRACE_CHUNK_STRING = 1,     // TraceString entries followed by characters
+  TRACE_CHUNK_TRACK = 2,      // TraceTrack entries
+  TRACE_CHUNK_EVENT = 3,      // TraceEvent entries
+  TRACE_CHUNK_LONG_EVENT = 4  // TraceLongEvent entries
+};
+
+enum TraceTrackType {
+  TRACE_TRACK_QUEUE = 0,
+  TRACE_TRACK_THREAD = 1
+};
+
+struct TraceFileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t pid;
+};
+
+struct TraceChunkHeader {
+  uint32_t type;
+  uint32_t count;
+  uint32_t size;
+  uint32_t reserved;
+  uint64_t base;
+};
+
+struct TraceString {
+  uint32_t id;
+  uint32_t length;
+};
+
+struct TraceTrack {
+  uint32_t id;
+  uint32_t type;
+  uint64_t value;
+};
+
+struct TraceEvent {
+  uint32_t name_id;
+  uint32_t track_id;
+  uint32_t start_delta;
+  uint32_t duration;
+};
+
+// Events that do not fit into 32-bit deltas
+struct TraceLongEvent {
+  uint32_t name_id;
+  uint32_t track_id;
+  uint64_t start;
+  uint64_t end;
+};
+
+static_assert(sizeof(TraceFileHeader) == 16, "Unexpected header size");
+static_assert(sizeof(TraceChunkHeader) == 24, "Unexpected chunk size");
+static_assert(sizeof(TraceEvent) == 16, "Unexpected event size");
+static_assert(sizeof(TraceLongEvent) == 24, "Unexpected event size");
+
+// Decoded event, timestamps are in nanoseconds
+struct TraceEventRecord {
+  uint32_t name_id;
+  uint32_t track_id;
+  uint64_t start;
+  uint64_t end;
+};
+
+namespace trace_format {
+
+inline void WriteChromeHeader(std::ostream& stream, uint32_t pid,
+                              const std::string& process_name) {
+  stream << "[" << std::endl;
+  stream <<
+    "{\"ph\":\"M\", \"name\":\"process_name\", \"pid\":" <<
+    pid << ", \"tid\":0, \"args\":{\"name\":\"" <<
+    process_name << "\"}}," << std::endl;
+}
+
+inline void WriteChromeEvent(std::ostream& stream, uint32_t pid,
+                             uint64_t tid, const std::string& name,
+                             uint64_t start, uint64_t end) {
+  stream << "{\"ph\":\"X\", \"pid\":" << pid <<
+    ", \"tid\":" << tid <<
+    ", \"name\":\"" << name <<
+    "\", \"ts\": " << start / NSEC_IN_USEC <<
+    ", \"dur\":" << (end - start) / NSEC_IN_USEC <<
+    "}," << "\n";
+}
+
+} // namespace trace_format
+
+// Encodes trace records into the binary chunks. Records are buffered
+// up to one chunk and written out on overflow or explicit flush
+class TraceFileEncoder {
+ public: // User Interface
+  TraceFileEncoder(const std::string& file_name, uint32_t pid,
+                   const std::string& process_name) {
+    stream_.open(file_name, std::ios::out | std::ios::binary);
+    PTI_ASSERT(stream_.is_open());
+
+    TraceFileHeader header{};
+    memcpy(header.magic, kTraceFileMagic, sizeof(kTraceFileMagic));
+    header.version = kTraceFileVersion;
+    header.pid = pid;
+    stream_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    WriteChunk(TRACE_CHUNK_PROCESS, 0, 0,
+               process_name.data(), process_name.size());
+  }
+
+  ~TraceFileEncoder() {
+    Flush();
+    stream_.close();
+  }
+
+  // Name is requested only for the identifiers not stored yet
+  template <typename NameProvider>
+  void AddEvent(uint32_t name_id, uint32_t track_type, uint64_t track_value,
+                uint64_t start, uint64_t end, NameProvider get_name) {
+    if (name_id >= name_list_.size()) {
+      name_list_.resize(name_id + 1, false);
+    }
+    if (!name_list_[name_id]) {
+      AddString(name_id, get_name(name_id));
+      name_list_[name_id] = true;
+    }
+
+    uint32_t track_id = GetTrackId(track_type, track_value);
+    event_list_.push_back({name_id, track_id, start, end});
+    if (event_list_.size() == kChunkEventCount) {
+      Flush();
+    }
+  }
+
+  void Flush() {
+    if (!string_data_.empty()) {
+      WriteChunk(TRACE_CHUNK_STRING, string_count_, 0,
+                 string_data_.data(), string_data_.size());
+      string_data_.clear();
+      string_count_ = 0;
+    }
+
+    if (!track_list_.empty()) {
+      WriteChunk(TRACE_CHUNK_TRACK, track_list_.size(), 0,
+                 track_list_.data(), track_list_.size() * sizeof(TraceTrack));
+      track_list_.clear();
+    }
+
+    if (!event_list_.empty()) {
+      WriteEvents();
+      event_list_.clear();
+    }
+
+    stream_.flush();
+  }
+
+  TraceFileEncoder(const TraceFileEncoder& copy) = delete;
+  TraceFileEncoder& operator=(const TraceFileEncoder& copy) = delete;
+
+ private: // Implementation Details
+  void AddString(uint32_t id, const std::string& str) {
+    TraceString entry{id, static_cast<uint32_t>(str.size())};
+    const char* data = reinterpret_cast<const char*>(&entry);
+    string_data_.insert(string_data_.end(), data, data + sizeof(entry));
+    string_data_.insert(string_data_.end(), str.begin(), str.end());
+    ++string_count_;
+  }
+
+  uint32_t GetTrackId(uint32_t type, uint64_t value) {
+    auto& track_map = (type == TRACE_TRACK_QUEUE) ?
+      queue_track_map_ : thread_track_map_;
+    auto it = track_map.find(value);
+    if (it != track_map.end()) {
+      return it->second;
+    }
+
+    uint32_t track_id = track_count_++;
+    track_map[value] = track_id;
+    track_list_.push_back({track_id, type, value});
+    return track_id;
+  }
+
+  void WriteEvents() {
+    std::sort(event_list_.begin(), event_list_.end(),
+              [](const TraceEventRecord& left, const TraceEventRecord& right) {
+                return left.start < right.start;
+              });
+
+    std::vector<TraceEvent> short_list;
+    std::vector<TraceLongEvent> long_list;
+    uint64_t base = 0, last = 0;
+
+    for (auto& record : event_list_) {
+      uint64_t duration =
+        (record.end > record.start) ? record.end - record.start : 0;
+      if (duration > UINT32_MAX) {
+        long_list.push_back(
+            {record.name_id, record.track_id, record.start, record.end});
+        continue;
+      }
+
+      if (short_list.empty() || record.start - last > UINT32_MAX) {
+        WriteShortEvents(short_list, base);
+        base = last = record.start;
+      }
+
+      short_list.push_back({
+          record.name_id, record.track_id,
+          static_cast<uint32_t>(record.start - last),
+          static_cast<uint32_t>(duration)});
+      last = record.start;
+    }
+
+    WriteShortEvents(short_list, base);
+    if (!long_list.empty()) {
+      WriteChunk(TRACE_CHUNK_LONG_EVENT, long_list.size(), 0,
+                 long_list.data(), long_list.size() * sizeof(TraceLongEvent));
+    }
+  }
+
+  void WriteShortEvents(std::vector<TraceEvent>& event_list, uint64_t base) {
+    if (!event_list.empty()) {
+      WriteChunk(TRACE_CHUNK_EVENT, event_list.size(), base,
+                 event_list.data(), event_list.size() * sizeof(TraceEvent));
+      event_list.clear();
+    }
+  }
+
+  void WriteChunk(uint32_t type, size_t count, uint64_t base,
+                  const void* data, size_t size) {
+    PTI_ASSERT(count <= UINT32_MAX && size <= UINT32_MAX);
+    TraceChunkHeader header{type, static_cast<uint32_t>(count),
+                            static_cast<uint32_t>(size), 0, base};
+    stream_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    stream_.write(reinterpret_cast<const char*>(data), size);
+  }
+
+ private: // Data
+  static const size_t kChunkEventCount = 4096;
+
+  std::ofstream stream_;
+
+  std::vector<bool> name_list_;
+  std::vector<char> string_data_;
+  uint32_t string_count_ = 0;
+
+  std::unordered_map<uint64_t, uint32_t> queue_track_map_;
+  std::unordered_map<uint64_t, uint32_t> thread_track_map_;
+  std::vector<TraceTrack> track_list_;
+  uint32_t track_count_ = 0;
+
+  std::vector<TraceEventRecord> event_list_;
+};
+
+// Streaming reader of the binary trace. Only the current chunk, string
+// and track tables are kept in memory, so the file size is not limited
+class TraceFileReader {
+ public: // User Interface
+  TraceFileReader(const std::string& file_name) {
+    stream_.open(file_name, std::ios::in | std::ios::binary);
+    if (!stream_.is_open()) {
+      return;
+    }
+
+    TraceFileHeader header{};
+    stream_.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!stream_ ||
+        memcmp(header.magic, kTraceFileMagic, sizeof(kTraceFileMagic)) != 0 ||
+        header.version != kTraceFileVersion) {
+      stream_.close();
+      return;
+    }
+
+    pid_ = header.pid;
+    valid_ = true;
+
+    // Process name always goes first
+    TraceChunkHeader chunk{};
+    if (!ReadChunk(chunk) || chunk.type != TRACE_CHUNK_PROCESS) {
+      stream_.close();
+      valid_ = false;
+      return;
+    }
+    process_name_.assign(data_.data(), data_.size());
+  }
+
+  bool IsValid() const {
+    return valid_;
+  }
+
+  uint32_t GetPid() const {
+    return pid_;
+  }
+
+  const std::string& GetProcessName() const {
+    return process_name_;
+  }
+
+  const std::string& GetName(uint32_t id) const {
+    PTI_ASSERT(id < name_list_.size());
+    return name_list_[id];
+  }
+
+  const TraceTrack& GetTrack(uint32_t id) const {
+    PTI_ASSERT(id < track_list_.size());
+    return track_list_[id];
+  }
+
+  // Reads the next chunk with events, all the string and track chunks
+  // on the way are applied to the reader tables. Returns false at the end
+  bool ReadEvents(std::vector<TraceEventRecord>& event_list) {
+    event_list.clear();
+    TraceChunkHeader header{};
+    while (ReadChunk(header)) {
+      switch (header.type) {
+        case TRACE_CHUNK_STRING:
+          ParseStrings(header);
+          break;
+        case TRACE_CHUNK_TRACK:
+          ParseTracks(header);
+          break;
+        case TRACE_CHUNK_EVENT:
+          ParseEvents(header, event_list);
+          return true;
+        case TRACE_CHUNK_LONG_EVENT:
+          ParseLongEvents(header, event_list);
+          return true;
+        default: // Unknown chunk types are skipped
+          break;
+      }
+    }
+    return false;
+  }
+
+  TraceFileReader(const TraceFileReader& copy) = delete;
+  TraceFileReader& operator=(const TraceFileReader& copy) = delete;
+
+ private: // Implementation Details
+  // File may be cut at any point if the traced process crashed, so the
+  // incomplete chunk at the end is dropped and the rest is kept
+  bool ReadChunk(TraceChunkHeader& header) {
+    if (!valid_) {
+      return false;
+    }
+    stream_.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!stream_) {
+      if (stream_.gcount() > 0) {
+        WarnTruncated();
+      }
+      return false;
+    }
+    data_.resize(header.size);
+    stream_.read(data_.data(), header.size);
+    if (!stream_) {
+      WarnTruncated();
+      return false;
+    }
+    return true;
+  }
+
+  static void WarnTruncated() {
+    std::cerr << "[WARNING] Trace file is truncated, " <<
+      "the last incomplete chunk is skipped" << std::endl;
+  }
+
+  void ParseStrings(const TraceChunkHeader& header) {
+    size_t offset = 0;
+    for (uint32_t i = 0; i < header.count; ++i) {
+      TraceString entry{};
+      PTI_ASSERT(offset + sizeof(entry) <= data_.size());
+      memcpy(&entry, data_.data() + offset, sizeof(entry));
+      offset += sizeof(entry);
+
+      PTI_ASSERT(offset + entry.length <= data_.size());
+      if (entry.id >= name_list_.size()) {
+        name_list_.resize(entry.id + 1);
+      }
+      name_list_[entry.id].assign(data_.data() + offset, entry.length);
+      offset += entry.length;
+    }
+  }
+
+  void ParseTracks(const TraceChunkHeader& header) {
+    PTI_ASSERT(header.size == header.count * sizeof(TraceTrack));
+    for (uint32_t i = 0; i < header.count; ++i) {
+      TraceTrack track{};
+      memcpy(&track, data_.data() + i * sizeof(TraceTrack), sizeof(track));
+      if (track.id >= track_list_.size()) {
+        track_list_.resize(track.id + 1);
+      }
+      track_list_[track.id] = track;
+    }
+  }
+
+  void ParseEvents(const TraceChunkHeader& header,
+                   std::vector<TraceEventRecord>& event_list) {
+    PTI_ASSERT(header.size == header.count * sizeof(TraceEvent));
+    uint64_t start = header.base;
+    for (uint32_t i = 0; i < header.count; ++i) {
+      TraceEvent event{};
+      memcpy(&event, data_.data() + i * sizeof(TraceEvent), sizeof(event));
+      start += event.start_delta;
+      event_list.push_back(
+          {event.name_id, event.track_id, start, start + event.duration});
+    }
+  }
+
+  void ParseLongEvents(const TraceChunkHeader& header,
+                       std::vector<TraceEventRecord>& event_list) {
+    PTI_ASSERT(header.size == header.count * sizeof(TraceLongEvent));
+    for (uint32_t i = 0; i < header.count; ++i) {
+      TraceLongEvent event{};
+      memcpy(&event, data_.data() + i * sizeof(TraceLongEvent), sizeof(event));
+      event_list.push_back(
+          {event.name_id, event.track_id, event.start, event.end});
+    }
+  }
+
+ private: // Data
+  std::ifstream stream_;
+  bool valid_ = false;
+
+  uint32_t pid_ = 0;
+  std::string process_name_;
+  std::vector<std::string> name_list_;
+  std::vector<TraceTrack> track_list_;
+  std::vector<char> data_;
+};
+
+#endif // PTI_SAMPLES_UTILS_TRACE_FORMAT_H_
\ No newline at end of file
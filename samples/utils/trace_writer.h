@@ -0,0 +1,277 @@
+//==============================================================
+// Copyright (C) Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#ifndef PTI_SAMPLES_UTILS_TRACE_WRITER_H_
+#define PTI_SAMPLES_UTILS_TRACE_WRITER_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "pti_assert.h"
+#include "string_table.h"
+#include "trace_format.h"
+#include "utils.h"
+
+// Fixed-size trace record. Device records keep command queue handle
+// and have zero thread identifier, host records are vice versa
+struct TraceRecord {
+  uint64_t start;
+  uint64_t end;
+  uint64_t queue;
+  uint32_t name_id;
+  uint32_t tid;
+};
+
+// Single-producer single-consumer ring of trace records
+class TraceRecordRing {
+ public:
+  bool Push(const TraceRecord& record) {
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) == kRingSize) {
+      return false;
+    }
+    record_list_[head & (kRingSize - 1)] = record;
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  template <typename Consumer>
+  size_t Pop(Consumer consumer) {
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    uint64_t head = head_.load(std::memory_order_acquire);
+    for (uint64_t i = tail; i < head; ++i) {
+      consumer(record_list_[i & (kRingSize - 1)]);
+    }
+    tail_.store(head, std::memory_order_release);
+    return head - tail;
+  }
+
+ private:
+  static const uint64_t kRingSize = 4096;
+
+  std::atomic<uint64_t> head_{0};
+  char padding_[64];
+  std::atomic<uint64_t> tail_{0};
+  TraceRecord record_list_[kRingSize];
+};
+
+enum TraceFormat {
+  TRACE_FORMAT_JSON = 0,
+  TRACE_FORMAT_BINARY = 1
+};
+
+// Asynchronous trace writer. Application threads put binary records into
+// their own lock-free rings, while background thread drains the rings and
+// does all the encoding and file I/O off the hot path. Output is either
+// Chrome trace JSON or the chunked binary format (see trace_format.h)
+class TraceWriter {
+ public: // User Interface
+  TraceWriter(const std::string& file_name,
+              TraceFormat format = TRACE_FORMAT_JSON)
+      : pid_(utils::GetPid()), id_(GetNextId()) {
+    if (format == TRACE_FORMAT_BINARY) {
+      encoder_ = new TraceFileEncoder(
+          file_name, pid_, utils::GetExecutableName());
+      PTI_ASSERT(encoder_ != nullptr);
+    } else {
+      stream_.open(file_name);
+      PTI_ASSERT(stream_.is_open());
+      trace_format::WriteChromeHeader(
+          stream_, pid_, utils::GetExecutableName());
+    }
+
+    writer_thread_ = std::thread(Write, this);
+  }
+
+  ~TraceWriter() {
+    {
+      const std::lock_guard<std::mutex> lock(lock_);
+      active_ = false;
+    }
+    condition_.notify_one();
+    writer_thread_.join();
+
+    Drain();
+    if (encoder_ != nullptr) {
+      delete encoder_;
+    } else {
+      stream_.close();
+    }
+
+    for (auto ring : ring_list_) {
+      delete ring;
+    }
+  }
+
+  void AddDeviceRecord(
+      uint32_t name_id, void* queue, uint64_t start, uint64_t end) {
+    PTI_ASSERT(queue != nullptr);
+    Push({start, end, reinterpret_cast<uint64_t>(queue), name_id, 0});
+  }
+
+  void AddHostRecord(uint32_t name_id, uint64_t start, uint64_t end) {
+    Push({start, end, 0, name_id, utils::GetTid()});
+  }
+
+  // Host API names are interned through per-thread cache to avoid
+  // locking the shared string table on every call
+  void AddHostRecord(const std::string& name, uint64_t start, uint64_t end) {
+    static thread_local std::unordered_map<std::string, uint32_t> id_map;
+    auto it = id_map.find(name);
+    if (it == id_map.end()) {
+      it = id_map.emplace(name, utils::InternString(name)).first;
+    }
+    AddHostRecord(it->second, start, end);
+  }
+
+  // Valid after the writer is stopped only
+  uint64_t GetRecordCount() const {
+    return record_count_;
+  }
+
+  uint64_t GetDroppedCount() const {
+    return dropped_count_.load(std::memory_order_relaxed);
+  }
+
+  uint64_t GetStallCount() const {
+    return stall_count_.load(std::memory_order_relaxed);
+  }
+
+  TraceWriter(const TraceWriter& copy) = delete;
+  TraceWriter& operator=(const TraceWriter& copy) = delete;
+
+ private: // Implementation Details
+  // Writer IDs are never reused, unlike addresses, so the cached ring
+  // can not belong to the destroyed writer
+  static uint64_t GetNextId() {
+    static std::atomic<uint64_t> next_id{1};
+    return next_id.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Rings are owned by the writer, one per thread. The last used one is
+  // cached per thread, so the lookup is done only if the thread switches
+  // between the writers
+  TraceRecordRing* GetRing() {
+    static thread_local uint64_t writer_id = 0;
+    static thread_local TraceRecordRing* ring = nullptr;
+    if (writer_id != id_) {
+      const std::lock_guard<std::mutex> lock(lock_);
+      TraceRecordRing*& thread_ring = ring_map_[std::this_thread::get_id()];
+      if (thread_ring == nullptr) {
+        thread_ring = new TraceRecordRing;
+        PTI_ASSERT(thread_ring != nullptr);
+        ring_list_.push_back(thread_ring);
+      }
+      ring = thread_ring;
+      writer_id = id_;
+    }
+    return ring;
+  }
+
+  void Push(const TraceRecord& record) {
+    TraceRecordRing* ring = GetRing();
+    PTI_ASSERT(ring != nullptr);
+
+    if (!ring->Push(record)) {
+      // Back-pressure: wake up the writer and give it a chance to drain
+      stall_count_.fetch_add(1, std::memory_order_relaxed);
+      condition_.notify_one();
+      uint32_t retry_count = 0;
+      while (!ring->Push(record)) {
+        if (retry_count == kMaxRetryCount) {
+          dropped_count_.fetch_add(1, std::memory_order_relaxed);
+          return;
+        }
+        std::this_thread::yield();
+        ++retry_count;
+      }
+    }
+  }
+
+  void WriteRecord(const TraceRecord& record) {
+    if (encoder_ != nullptr) {
+      if (record.queue != 0) {
+        encoder_->AddEvent(
+            record.name_id, TRACE_TRACK_QUEUE, record.queue,
+            record.start, record.end, utils::GetInternedString);
+      } else {
+        encoder_->AddEvent(
+            record.name_id, TRACE_TRACK_THREAD, record.tid,
+            record.start, record.end, utils::GetInternedString);
+      }
+    } else {
+      uint64_t tid = (record.queue != 0) ? record.queue : record.tid;
+      trace_format::WriteChromeEvent(
+          stream_, pid_, tid, utils::GetInternedString(record.name_id),
+          record.start, record.end);
+    }
+    ++record_count_;
+  }
+
+  void Drain() {
+    std::vector<TraceRecordRing*> ring_list;
+    {
+      const std::lock_guard<std::mutex> lock(lock_);
+      ring_list = ring_list_;
+    }
+
+    for (auto ring : ring_list) {
+      ring->Pop([this](const TraceRecord& record) {
+        WriteRecord(record);
+      });
+    }
+  }
+
+  static void Write(TraceWriter* writer) {
+    PTI_ASSERT(writer != nullptr);
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(writer->lock_);
+        if (!writer->active_) {
+          break;
+        }
+        writer->condition_.wait_for(
+            lock, std::chrono::milliseconds(kFlushPeriod));
+        if (!writer->active_) {
+          break;
+        }
+      }
+      writer->Drain();
+    }
+  }
+
+ private: // Data
+  uint32_t pid_ = 0;
+  uint64_t id_ = 0;
+  std::ofstream stream_;
+  TraceFileEncoder* encoder_ = nullptr;
+
+  std::mutex lock_;
+  std::condition_variable condition_;
+  std::vector<TraceRecordRing*> ring_list_;
+  // Thread may get the ring of the exited one with the same ID, the ring
+  // still has a single producer
+  std::unordered_map<std::thread::id, TraceRecordRing*> ring_map_;
+  bool active_ = true;
+  std::thread writer_thread_;
+
+  uint64_t record_count_ = 0;
+  std::atomic<uint64_t> dropped_count_{0};
+  std::atomic<uint64_t> stall_count_{0};
+
+  static const uint32_t kMaxRetryCount = 1024;
+  static const uint32_t kFlushPeriod = 10; // ms
+};
+
+#endif // PTI_SAMPLES_UTILS_TRACE_WRITER_H_
\ No newline at end of file
@@ -0,0 +1,196 @@
+//==============================================================
+// Copyright (C) Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#ifndef PTI_SAMPLES_UTILS_ZE_EVENT_CACHE_H_
+#define PTI_SAMPLES_UTILS_ZE_EVENT_CACHE_H_
+
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include <level_zero/ze_api.h>
+
+#include "pti_assert.h"
+
+namespace utils {
+
+// Per-context slab allocator for profiling events. Events are carved out of
+// large event pools that grow geometrically and are recycled with
+// zeEventHostReset instead of being destroyed after every use. Events are
+// handed out along with the generation of their context, so a release
+// that comes after the context is gone is ignored even if its handle is
+// reused by the pools of a newer context
+class ZeEventCache {
+ public: // User Interface
+  ZeEventCache(ze_event_pool_flags_t flags) : flags_(flags) {}
+
+  ~ZeEventCache() {
+    const std::lock_guard<std::mutex> lock(lock_);
+    for (auto& value : context_map_) {
+      ReleaseContextInfo(value.second);
+    }
+  }
+
+  ze_event_handle_t GetEvent(ze_context_handle_t context,
+                             uint64_t* generation) {
+    PTI_ASSERT(context != nullptr);
+    PTI_ASSERT(generation != nullptr);
+    const std::lock_guard<std::mutex> lock(lock_);
+
+    auto result = context_map_.emplace(context, ZeEventContextInfo());
+    ZeEventContextInfo& info = result.first->second;
+    if (result.second) {
+      info.generation = ++generation_count_;
+    }
+    if (info.free_list.empty()) {
+      CreatePool(context, info);
+    }
+    PTI_ASSERT(!info.free_list.empty());
+
+    ze_event_handle_t event = info.free_list.back();
+    info.free_list.pop_back();
+    ++event_count_;
+    *generation = info.generation;
+    return event;
+  }
+
+  // Returns false if the event was not allocated by the cache within
+  // the given generation of its context
+  bool ReleaseEvent(ze_event_handle_t event, uint64_t generation) {
+    PTI_ASSERT(event != nullptr);
+    const std::lock_guard<std::mutex> lock(lock_);
+
+    auto it = event_map_.find(event);
+    if (it == event_map_.end()) {
+      return false;
+    }
+
+    auto context = context_map_.find(it->second);
+    PTI_ASSERT(context != context_map_.end());
+    ZeEventContextInfo& info = context->second;
+    if (info.generation != generation) {
+      return false;
+    }
+
+    ze_result_t status = zeEventHostReset(event);
+    PTI_ASSERT(status == ZE_RESULT_SUCCESS);
+
+    info.free_list.push_back(event);
+    return true;
+  }
+
+  bool IsCached(ze_event_handle_t event) {
+    PTI_ASSERT(event != nullptr);
+    const std::lock_guard<std::mutex> lock(lock_);
+    return event_map_.count(event) > 0;
+  }
+
+  // All the events of the context should be released before the call
+  void ReleaseContext(ze_context_handle_t context) {
+    PTI_ASSERT(context != nullptr);
+    const std::lock_guard<std::mutex> lock(lock_);
+
+    auto it = context_map_.find(context);
+    if (it != context_map_.end()) {
+      ReleaseContextInfo(it->second);
+      context_map_.erase(it);
+    }
+  }
+
+  uint64_t GetPoolCount() const {
+    return pool_count_;
+  }
+
+  uint64_t GetEventCount() const {
+    return event_count_;
+  }
+
+  // Number of event pools created per thousand of requested events
+  double GetPoolsPerKiloEvents() const {
+    if (event_count_ == 0) {
+      return 0.0;
+    }
+    return 1000.0 * pool_count_ / event_count_;
+  }
+
+  ZeEventCache(const ZeEventCache& copy) = delete;
+  ZeEventCache& operator=(const ZeEventCache& copy) = delete;
+
+ private: // Implementation Details
+  struct ZeEventContextInfo {
+    std::vector<ze_event_pool_handle_t> pool_list;
+    std::vector<ze_event_handle_t> event_list;
+    std::vector<ze_event_handle_t> free_list;
+    uint32_t next_pool_size = kInitialPoolSize;
+    uint64_t generation = 0;
+  };
+
+  void CreatePool(ze_context_handle_t context, ZeEventContextInfo& info) {
+    PTI_ASSERT(context != nullptr);
+    ze_result_t status = ZE_RESULT_SUCCESS;
+
+    uint32_t pool_size = info.next_pool_size;
+    if (info.next_pool_size < kMaxPoolSize) {
+      info.next_pool_size *= 2;
+    }
+
+    ze_event_pool_desc_t event_pool_desc = {
+        ZE_STRUCTURE_TYPE_EVENT_POOL_DESC, nullptr, flags_, pool_size};
+    ze_event_pool_handle_t event_pool = nullptr;
+    status = zeEventPoolCreate(
+        context, &event_pool_desc, 0, nullptr, &event_pool);
+    PTI_ASSERT(status == ZE_RESULT_SUCCESS);
+    info.pool_list.push_back(event_pool);
+    ++pool_count_;
+
+    for (uint32_t i = 0; i < pool_size; ++i) {
+      ze_event_desc_t event_desc = {
+          ZE_STRUCTURE_TYPE_EVENT_DESC, nullptr, i,
+          ZE_EVENT_SCOPE_FLAG_HOST, ZE_EVENT_SCOPE_FLAG_HOST};
+      ze_event_handle_t event = nullptr;
+      status = zeEventCreate(event_pool, &event_desc, &event);
+      PTI_ASSERT(status == ZE_RESULT_SUCCESS);
+
+      info.event_list.push_back(event);
+      info.free_list.push_back(event);
+      event_map_[event] = context;
+    }
+  }
+
+  void ReleaseContextInfo(ZeEventContextInfo& info) {
+    ze_result_t status = ZE_RESULT_SUCCESS;
+    for (auto event : info.event_list) {
+      event_map_.erase(event);
+      status = zeEventDestroy(event);
+      PTI_ASSERT(status == ZE_RESULT_SUCCESS);
+    }
+    for (auto event_pool : info.pool_list) {
+      status = zeEventPoolDestroy(event_pool);
+      PTI_ASSERT(status == ZE_RESULT_SUCCESS);
+    }
+    info.event_list.clear();
+    info.free_list.clear();
+    info.pool_list.clear();
+  }
+
+ private: // Data
+  ze_event_pool_flags_t flags_;
+
+  std::mutex lock_;
+  std::map<ze_context_handle_t, ZeEventContextInfo> context_map_;
+  std::map<ze_event_handle_t, ze_context_handle_t> event_map_;
+
+  uint64_t generation_count_ = 0;
+  uint64_t pool_count_ = 0;
+  uint64_t event_count_ = 0;
+
+  static const uint32_t kInitialPoolSize = 64;
+  static const uint32_t kMaxPoolSize = 4096;
+};
+
+} // namespace utils
+
+#endif // PTI_SAMPLES_UTILS_ZE_EVENT_CACHE_H_
@@ -7,6 +7,7 @@
 #ifndef PTI_SAMPLES_ZE_DEBUG_INFO_ZE_DEBUG_INFO_COLLECTOR_H_
 #define PTI_SAMPLES_ZE_DEBUG_INFO_ZE_DEBUG_INFO_COLLECTOR_H_
 
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 #include <map>
@@ -18,6 +19,7 @@
 #include "elf_parser.h"
 #include "gen_symbols_decoder.h"
 #include "igc_binary_decoder.h"
+#include "line_info_index.h"
 #include "utils.h"
 #include "ze_utils.h"
 
@@ -36,6 +38,7 @@ struct KernelDebugInfo {
   std::vector<Instruction> instruction_list;
   std::vector<LineInfo> line_info_list;
   std::vector<SourceFileInfo> source_info_list;
+  LineInfoIndex line_info_index;
 };
 
 using KernelDebugInfoMap = std::map<std::string, KernelDebugInfo>;
@@ -76,11 +79,8 @@ class ZeDebugInfoCollector {
       kernel_debug_info.instruction_list;
     PTI_ASSERT(instruction_list.size() > 0);
 
-    int last_instruction_address = instruction_list.back().offset;
-
-    const std::vector<LineInfo>& line_info =
-      kernel_debug_info.line_info_list;
-    PTI_ASSERT(line_info.size() > 0);
+    const LineInfoIndex& line_info_index = kernel_debug_info.line_info_index;
+    PTI_ASSERT(!line_info_index.IsEmpty());
 
     const std::vector<SourceFileInfo>& source_info_list =
       kernel_debug_info.source_info_list;
@@ -89,27 +89,8 @@ class ZeDebugInfoCollector {
     // Print instructions with no corresponding file
     std::cerr << "=== File: Unknown ===" << std::endl;
     for (auto& instruction : instruction_list) {
-      bool found = false;
-
-      for (size_t l = 0; l < line_info.size(); ++l) {
-        int start_address = line_info[l].address;
-        int end_address = (l + 1 < line_info.size()) ?
-                          line_info[l + 1].address :
-                          last_instruction_address;
-
-        if (instruction.offset >= start_address &&
-            instruction.offset < end_address) {
-          found = true;
-          break;
-        }
-      }
-
-      if (!found) {
-        std::cerr << "\t\t[" << "0x" << std::setw(5) <<
-          std::setfill('0') << std::hex << std::uppercase <<
-          instruction.offset << "] " << instruction.text;
-        callback(instruction.offset, callback_data);
-        std::cerr << std::endl;
+      if (line_info_index.LookupAddress(instruction.offset) == nullptr) {
+        PrintInstruction(instruction, callback, callback_data);
       }
     }
 
@@ -118,55 +99,23 @@ class ZeDebugInfoCollector {
       std::cerr << "=== File: " << source_info.file_name.c_str() <<
         " ===" << std::endl;
 
-      const std::vector<SourceLine> line_list = source_info.source_line_list;
+      const std::vector<SourceLine>& line_list = source_info.source_line_list;
       PTI_ASSERT(line_list.size() > 0);
 
       // Print instructions with no corresponding source line
-      for (size_t l = 0; l < line_info.size(); ++l) {
-        if (line_info[l].line == 0) {
-          int start_address = line_info[l].address;
-          int end_address = (l + 1 < line_info.size()) ?
-                            line_info[l + 1].address :
-                            last_instruction_address;
-
-          for (auto instruction : instruction_list) {
-            if (instruction.offset >= start_address &&
-                instruction.offset < end_address &&
-                source_info.file_id == line_info[l].file) {
-              std::cerr << "\t\t[" << "0x" << std::setw(5) <<
-                std::setfill('0') << std::hex << std::uppercase <<
-                instruction.offset << "] " << instruction.text;
-              callback(instruction.offset, callback_data);
-              std::cerr << std::endl;
-            }
-          }
-        }
+      for (auto& range : line_info_index.RangesForLine(
+              source_info.file_id, 0)) {
+        PrintInstructions(instruction_list, range, callback, callback_data);
       }
 
       // Print instructions for corresponding source line
-      for (auto line : line_list) {
+      for (auto& line : line_list) {
         std::cerr << "[" << std::setw(5) << std::setfill(' ') << std::dec <<
           line.number << "] " << line.text << std::endl;
 
-        for (size_t l = 0; l < line_info.size(); ++l) {
-          if (line_info[l].line == line.number) {
-            int start_address = line_info[l].address;
-            int end_address = (l + 1 < line_info.size()) ?
-                              line_info[l + 1].address :
-                              last_instruction_address;
-
-            for (auto instruction : instruction_list) {
-              if (instruction.offset >= start_address &&
-                  instruction.offset < end_address &&
-                  source_info.file_id == line_info[l].file) {
-                std::cerr << "\t\t[" << "0x" << std::setw(5) <<
-                  std::setfill('0') << std::hex << std::uppercase <<
-                  instruction.offset << "] " << instruction.text;
-                callback(instruction.offset, callback_data);
-                std::cerr << std::endl;
-              }
-            }
-          }
+        for (auto& range : line_info_index.RangesForLine(
+                source_info.file_id, line.number)) {
+          PrintInstructions(instruction_list, range, callback, callback_data);
         }
       }
     }
@@ -193,6 +142,34 @@ class ZeDebugInfoCollector {
   }
 
  private: // Implementation Details
+  static void PrintInstruction(
+      const Instruction& instruction,
+      decltype(InstructionCallback)* callback,
+      void* callback_data) {
+    std::cerr << "\t\t[" << "0x" << std::setw(5) <<
+      std::setfill('0') << std::hex << std::uppercase <<
+      instruction.offset << "] " << instruction.text;
+    callback(instruction.offset, callback_data);
+    std::cerr << std::endl;
+  }
+
+  // Instructions are sorted by offset, so ones in range are contiguous
+  static void PrintInstructions(
+      const std::vector<Instruction>& instruction_list,
+      const AddressRange& range,
+      decltype(InstructionCallback)* callback,
+      void* callback_data) {
+    auto it = std::lower_bound(
+        instruction_list.begin(), instruction_list.end(), range.start,
+        [](const Instruction& instruction, uint64_t address) {
+          return static_cast<uint64_t>(instruction.offset) < address;
+        });
+    for (; it != instruction_list.end() &&
+           static_cast<uint64_t>(it->offset) < range.end; ++it) {
+      PrintInstruction(*it, callback, callback_data);
+    }
+  }
+
   ZeDebugInfoCollector() {}
 
   void EnableTracing(zel_tracer_handle_t tracer) {
@@ -218,10 +195,18 @@ class ZeDebugInfoCollector {
     PTI_ASSERT(line_info_list.size() > 0);
     PTI_ASSERT(source_info_list.size() > 0);
 
+    PTI_ASSERT(std::is_sorted(
+        instruction_list.begin(), instruction_list.end(),
+        [](const Instruction& left, const Instruction& right) {
+          return left.offset < right.offset;
+        }));
+    LineInfoIndex line_info_index(
+        line_info_list, instruction_list.back().offset);
+
     const std::lock_guard<std::mutex> lock(lock_);
     PTI_ASSERT(kernel_debug_info_map_.count(name) == 0);
-    kernel_debug_info_map_[name] =
-      {instruction_list, line_info_list, source_info_list};
+    kernel_debug_info_map_[name] = {instruction_list, line_info_list,
+                                    source_info_list, line_info_index};
   }
 
   static std::vector<SourceLine> ReadSourceFile(const std::string& file_path) {
@@ -276,9 +261,7 @@ class ZeDebugInfoCollector {
         module, &native_binary_size, native_binary.data());
     PTI_ASSERT(status == ZE_RESULT_SUCCESS);
 
-    PTI_ASSERT(native_binary.size() < (std::numeric_limits<uint32_t>::max)());
-    ElfParser elf_parser(native_binary.data(),
-                        static_cast<uint32_t>(native_binary.size()));
+    ElfParser elf_parser(native_binary.data(), native_binary.size());
     std::vector<uint8_t> igc_binary = elf_parser.GetGenBinary();
     if (igc_binary.size() == 0) {
       std::cerr << "[WARNING] Unable to get GEN binary" << std::endl;
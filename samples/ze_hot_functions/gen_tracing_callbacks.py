@@ -237,8 +237,34 @@ def get_enum_map(include_path):
 
 # Generate Callbacks ##########################################################
 
+def get_func_id(func):
+  assert func[0] == 'z'
+  return 'Z' + func[1:] + "Id"
+
+def gen_func_ids(f, func_list):
+  f.write("enum ZeFunctionId {\n")
+  for func in func_list:
+    f.write("  " + get_func_id(func) + ",\n")
+  f.write("  ZeFunctionIdCount\n")
+  f.write("};\n")
+  f.write("\n")
+  f.write("using ZeFunctionMask = std::bitset<ZeFunctionIdCount>;\n")
+  f.write("\n")
+
+def gen_func_names(f, func_list):
+  f.write("static const char* GetFunctionName(uint32_t id) {\n")
+  f.write("  static const char* kFunctionNames[ZeFunctionIdCount] = {\n")
+  for func in func_list:
+    f.write("    \"" + func + "\",\n")
+  f.write("  };\n")
+  f.write("  PTI_ASSERT(id < ZeFunctionIdCount);\n")
+  f.write("  return kFunctionNames[id];\n")
+  f.write("}\n")
+  f.write("\n")
+
 def gen_api(f, func_list, group_map):
-  f.write("static void SetTracingAPIs(zel_tracer_handle_t tracer) {\n")
+  f.write("static void SetTracingAPIs(\n")
+  f.write("    zel_tracer_handle_t tracer, const ZeFunctionMask& mask) {\n")
   f.write("  zet_core_callbacks_t prologue = {};\n")
   f.write("  zet_core_callbacks_t epilogue = {};\n")
   f.write("\n")
@@ -252,8 +278,10 @@ def gen_api(f, func_list, group_map):
     callback_cond = callback[1]
     if callback_cond:
       f.write("#if " + callback_cond + "\n")
-    f.write("  prologue." + group_name + "." + callback_name + " = " + func + "OnEnter;\n")
-    f.write("  epilogue." + group_name + "." + callback_name + " = " + func + "OnExit;\n")
+    f.write("  if (mask.test(" + get_func_id(func) + ")) {\n")
+    f.write("    prologue." + group_name + "." + callback_name + " = " + func + "OnEnter;\n")
+    f.write("    epilogue." + group_name + "." + callback_name + " = " + func + "OnExit;\n")
+    f.write("  }\n")
     if callback_cond:
       f.write("#endif //" + callback_cond + "\n")
   f.write("\n")
@@ -313,6 +341,173 @@ def gen_enum(f, enum_map, enum_name, param_name):
   f.write("        break;\n")
   f.write("    }\n")
 
+DESC_TYPE_LIST = [
+  "ze_event_pool_desc_t*",
+  "ze_command_queue_desc_t*",
+  "ze_kernel_desc_t*",
+  "ze_device_mem_alloc_desc_t*",
+  "ze_context_desc_t*",
+  "ze_command_list_desc_t*",
+  "ze_event_desc_t*",
+  "ze_fence_desc_t*",
+  "ze_image_desc_t*",
+  "ze_host_mem_alloc_desc_t*",
+  "ze_external_memory_export_desc_t*",
+  "ze_module_desc_t*",
+  "ze_sampler_desc_t*",
+  "ze_physical_mem_desc_t*",
+  "ze_raytracing_mem_alloc_ext_desc_t*"]
+
+def is_ipc_type(type):
+  return type == "ze_ipc_mem_handle_t" or type == "ze_ipc_event_pool_handle_t"
+
+def is_ipc_pointer_type(type):
+  return type == "ze_ipc_mem_handle_t*" or type == "ze_ipc_event_pool_handle_t*"
+
+def is_string_type(type):
+  return type.find("char*") >= 0 and type.find("char*") == len(type) - len("char*")
+
+def is_out_param(name):
+  return name.find("ph") == 0 or name.find("pptr") == 0 or name.find("pCount") == 0
+
+def get_desc_type(type):
+  for desc_type in DESC_TYPE_LIST:
+    if type.find(desc_type) >= 0:
+      return desc_type
+  return None
+
+def has_value(name, type):
+  if is_out_param(name):
+    return not is_ipc_pointer_type(type)
+  return get_desc_type(type) != None
+
+def get_value_type(type):
+  return "std::remove_cv<std::remove_pointer<" + type + ">::type>::type"
+
+def gen_ipc_string(f, handle, indent):
+  f.write(indent + "record.PutString(\n")
+  f.write(indent + "    " + handle + "->data, strnlen(" + handle + "->data, sizeof(" + handle + "->data)));\n")
+
+def gen_desc_fields(f, desc, field_list):
+  for field in field_list[:-1]:
+    f.write("    stream << " + desc + "." + field + " << \" \";\n")
+  f.write("    stream << " + desc + "." + field_list[-1] + " << \"}\";\n")
+
+def gen_desc_printer(f, name, desc_type):
+  desc = "args." + name + "_value"
+  f.write("  if (args." + name + " != nullptr) {\n")
+  f.write("    stream << \" {\" << GetStructureTypeString(" + desc + ".stype)\n")
+  f.write("      << \"(0x\" << std::hex << " + desc + ".stype << std::dec << \") \";\n")
+  f.write("    stream << " + desc + ".pNext << \" \";\n")
+  if desc_type == "ze_event_pool_desc_t*":
+    gen_desc_fields(f, desc, ["flags", "count"])
+  elif desc_type == "ze_command_queue_desc_t*":
+    gen_desc_fields(f, desc, ["ordinal", "index", "flags", "mode", "priority"])
+  elif desc_type == "ze_kernel_desc_t*":
+    f.write("    stream << " + desc + ".flags << \" \";\n")
+    f.write("    if (" + desc + ".pKernelName == nullptr) {\n")
+    f.write("      stream << \"0\";\n")
+    f.write("    } else {\n")
+    f.write("      std::string str = reader.GetString();\n")
+    f.write("      if (str.empty()) {\n")
+    f.write("        stream << \" " + name + " = \\\"\\\"\";\n")
+    f.write("      } else {\n")
+    f.write("        stream << str << \"}\";\n")
+    f.write("      }\n")
+    f.write("    }\n")
+  elif desc_type == "ze_device_mem_alloc_desc_t*":
+    gen_desc_fields(f, desc, ["flags", "ordinal"])
+  elif desc_type == "ze_command_list_desc_t*":
+    gen_desc_fields(f, desc, ["commandQueueGroupOrdinal", "flags"])
+  elif desc_type == "ze_event_desc_t*":
+    gen_desc_fields(f, desc, ["index", "signal", "wait"])
+  elif desc_type == "ze_image_desc_t*":
+    f.write("    stream << " + desc + ".flags << \" \";\n")
+    f.write("    stream << " + desc + ".type << \" \";\n")
+    f.write("    stream << \"{\" << " + desc + ".format.layout << \" \";\n")
+    f.write("    stream << " + desc + ".format.type << \" \";\n")
+    f.write("    stream << " + desc + ".format.x << \" \";\n")
+    f.write("    stream << " + desc + ".format.y << \" \";\n")
+    f.write("    stream << " + desc + ".format.z << \" \";\n")
+    f.write("    stream << " + desc + ".format.w << \"}\" << \" \";\n")
+    gen_desc_fields(f, desc, ["width", "height", "depth", "arraylevels", "miplevels"])
+  elif desc_type == "ze_module_desc_t*":
+    f.write("    stream << " + desc + ".format << \" \";\n")
+    f.write("    stream << " + desc + ".inputSize << \" \";\n")
+    f.write("    stream << static_cast<const void*>(" + desc + ".pInputModule) << \" \";\n")
+    f.write("    if (" + desc + ".pBuildFlags != nullptr)\n")
+    f.write("      stream << reader.GetString() << \" \";\n")
+    f.write("    else stream << 0 << \" \";\n")
+    f.write("    stream << " + desc + ".pConstants << \"}\";\n")
+  elif desc_type == "ze_sampler_desc_t*":
+    f.write("    stream << " + desc + ".addressMode << \" \";\n")
+    f.write("    stream << " + desc + ".filterMode << \" \";\n")
+    f.write("    stream << static_cast<int>(" + desc + ".isNormalized) << \"}\";\n")
+  elif desc_type == "ze_physical_mem_desc_t*":
+    gen_desc_fields(f, desc, ["flags", "size"])
+  else:
+    gen_desc_fields(f, desc, ["flags"])
+  f.write("  }\n")
+
+def get_desc_string_field(desc_type):
+  if desc_type == "ze_kernel_desc_t*":
+    return "pKernelName"
+  if desc_type == "ze_module_desc_t*":
+    return "pBuildFlags"
+  return None
+
+def gen_enter_args(f, func, params):
+  f.write("struct " + func + "OnEnterArgs {\n")
+  f.write("  uint64_t start_time;\n")
+  for name, type in params:
+    if is_ipc_type(type):
+      continue
+    f.write("  " + type + " " + name + ";\n")
+    if not is_string_type(type) and has_value(name, type):
+      f.write("  " + get_value_type(type) + " " + name + "_value;\n")
+  f.write("};\n")
+  f.write("\n")
+
+def gen_enter_printer(f, func, params):
+  f.write("static size_t " + func + "OnEnterPrint(\n")
+  f.write("    std::ostream& stream, const uint8_t* data) {\n")
+  f.write("  utils::CallRecordReader reader(data);\n")
+  f.write("  " + func + "OnEnterArgs args;\n")
+  f.write("  reader.Get(args);\n")
+  f.write("\n")
+  f.write("  stream << \">>>> [\" << args.start_time << \"] \";\n")
+  f.write("  stream << \"" + func + "\" << \":\";\n")
+  for name, type in params:
+    if is_ipc_type(type):
+      f.write("  stream << \" " + name + " = \" << reader.GetString();\n")
+    elif is_string_type(type):
+      f.write("  if (args." + name + " == nullptr) {\n")
+      f.write("    stream << \" " + name + " = \" << \"0\";\n")
+      f.write("  } else {\n")
+      f.write("    std::string str = reader.GetString();\n")
+      f.write("    if (str.empty()) {\n")
+      f.write("      stream << \" " + name + " = \\\"\\\"\";\n")
+      f.write("    } else {\n")
+      f.write("      stream << \" " + name + " = \\\"\" << str << \"\\\"\";\n")
+      f.write("    }\n")
+      f.write("  }\n")
+    else:
+      f.write("  stream << \" " + name + " = \" << args." + name + ";\n")
+      if is_out_param(name):
+        f.write("  if (args." + name + " != nullptr) {\n")
+        if is_ipc_pointer_type(type):
+          f.write("    stream << \" (" + name[1:] + " = \" << reader.GetString() << \")\";\n")
+        else:
+          f.write("    stream << \" (" + name[1:] + " = \" << args." + name + "_value << \")\";\n")
+        f.write("  }\n")
+      elif get_desc_type(type):
+        gen_desc_printer(f, name, get_desc_type(type))
+  f.write("  stream << std::endl;\n")
+  f.write("\n")
+  f.write("  return reader.GetSize();\n")
+  f.write("}\n")
+  f.write("\n")
+
 def gen_enter_callback(f, func, params, enum_map):
   f.write("  PTI_ASSERT(global_user_data != nullptr);\n")
   f.write("  ZeApiCollector* collector =\n")
@@ -321,176 +516,77 @@ def gen_enter_callback(f, func, params, enum_map):
   f.write("  uint64_t& start_time = *reinterpret_cast<uint64_t*>(instance_user_data);\n")
   f.write("  start_time = collector->GetTimestamp();\n")
   f.write("  if (collector->call_tracing_) {\n")
-  f.write("    std::stringstream stream;\n")
-  f.write("    stream << \">>>> [\" << start_time << \"] \";\n")
-  f.write("    stream << \"" + func + "\" << \":\";\n")
+  f.write("    " + func + "OnEnterArgs args = {};\n")
+  f.write("    args.start_time = start_time;\n")
   for name, type in params:
-    if type == "ze_ipc_mem_handle_t" or type == "ze_ipc_event_pool_handle_t":
-      f.write("    stream << \" " + name + " = \" << (params->p" + name + ")->data;\n")
-    else:
-      if type.find("char*") >= 0 and type.find("char*") == len(type) - len("char*"):
-        f.write("    if (*(params->p" + name + ") == nullptr) {\n")
-        f.write("      stream << \" " + name + " = \" << \"0\";\n")
-        f.write("    } else if (strlen(*(params->p" + name +")) == 0) {\n")
-        f.write("      stream << \" " + name + " = \\\"\\\"\";\n")
-        f.write("    } else {\n")
-        f.write("      stream << \" " + name + " = \\\"\" << *(params->p" + name + ") << \"\\\"\";\n")
+    if is_ipc_type(type):
+      continue
+    f.write("    args." + name + " = *(params->p" + name + ");\n")
+    if not is_string_type(type) and has_value(name, type):
+      f.write("    if (args." + name + " != nullptr) {\n")
+      f.write("      args." + name + "_value = *args." + name + ";\n")
+      f.write("    }\n")
+  f.write("\n")
+  f.write("    utils::CallRecord record;\n")
+  f.write("    record.Begin(" + func + "OnEnterPrint);\n")
+  f.write("    record.Put(args);\n")
+  for name, type in params:
+    if is_ipc_type(type):
+      gen_ipc_string(f, "params->p" + name, "    ")
+    elif is_string_type(type):
+      f.write("    if (args." + name + " != nullptr) {\n")
+      f.write("      record.PutString(args." + name + ");\n")
+      f.write("    }\n")
+    elif is_out_param(name):
+      if is_ipc_pointer_type(type):
+        f.write("    if (args." + name + " != nullptr) {\n")
+        gen_ipc_string(f, "args." + name, "      ")
         f.write("    }\n")
-      else:
-        f.write("    stream << \" " + name + " = \" << *(params->p" + name + ");\n")
-        if name.find("ph") == 0 or name.find("pptr") == 0 or name.find("pCount") == 0:
-          f.write("    if (*(params->p" + name + ") != nullptr) {\n")
-          if type == "ze_ipc_mem_handle_t*" or type == "ze_ipc_event_pool_handle_t*":
-            f.write("      stream << \" (" + name[1:] + " = \" << (*(params->p" + name + "))->data << \")\";\n")
-          else:
-            f.write("      stream << \" (" + name[1:] + " = \" << **(params->p" + name + ") << \")\";\n")
-          f.write("    }\n")
-        elif type.find("ze_event_pool_desc_t*") >= 0:
-          f.write("    if (*(params->p" + name + ") != nullptr) {\n")
-          f.write("      stream << \" {\" << GetStructureTypeString((*(params->p" + name + "))->stype)\n")
-          f.write("        << \"(0x\" << std::hex << (*(params->p" + name + "))->stype << std::dec << \") \";\n")
-          f.write("      stream << (*(params->p" + name + "))->pNext << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->flags << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->count << \"}\";\n")
-          f.write("    }\n")
-        elif type.find("ze_command_queue_desc_t*") >= 0:
-          f.write("    if (*(params->p" + name + ") != nullptr) {\n")
-          f.write("      stream << \" {\" << GetStructureTypeString((*(params->p" + name + "))->stype)\n")
-          f.write("        << \"(0x\" << std::hex << (*(params->p" + name + "))->stype << std::dec << \") \";\n")
-          f.write("      stream << (*(params->p" + name + "))->pNext << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->ordinal << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->index << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->flags << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->mode << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->priority << \"}\";\n")
-          f.write("    }\n")
-        elif type.find("ze_kernel_desc_t*") >= 0:
-          f.write("    if (*(params->p" + name + ") != nullptr) {\n")
-          f.write("      stream << \" {\" << GetStructureTypeString((*(params->p" + name + "))->stype)\n")
-          f.write("        << \"(0x\" << std::hex << (*(params->p" + name + "))->stype << std::dec << \") \";\n")
-          f.write("      stream << (*(params->p" + name + "))->pNext << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->flags << \" \";\n")
-          f.write("      if ((*(params->p" + name + "))->pKernelName == nullptr) {\n")
-          f.write("        stream << \"0\";\n")
-          f.write("      } else if (strlen((*(params->p" + name + "))->pKernelName) == 0) {\n")
-          f.write("        stream << \" " + name + " = \\\"\\\"\";\n")
-          f.write("      } else {\n")
-          f.write("        stream << (*(params->p" + name + "))->pKernelName << \"}\";\n")
-          f.write("      }\n")
-          f.write("    }\n")
-        elif type.find("ze_device_mem_alloc_desc_t*") >= 0:
-          f.write("    if (*(params->p" + name + ") != nullptr) {\n")
-          f.write("      stream << \" {\" << GetStructureTypeString((*(params->p" + name + "))->stype)\n")
-          f.write("        << \"(0x\" << std::hex << (*(params->p" + name + "))->stype << std::dec << \") \";\n")
-          f.write("      stream << (*(params->p" + name + "))->pNext << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->flags << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->ordinal << \"}\";\n")
-          f.write("    }\n")
-        elif type.find("ze_context_desc_t*") >= 0:
-          f.write("    if (*(params->p" + name + ") != nullptr) {\n")
-          f.write("      stream << \" {\" << GetStructureTypeString((*(params->p" + name + "))->stype)\n")
-          f.write("        << \"(0x\" << std::hex << (*(params->p" + name + "))->stype << std::dec << \") \";\n")
-          f.write("      stream << (*(params->p" + name + "))->pNext << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->flags << \"}\";\n")
-          f.write("    }\n")
-        elif type.find("ze_command_list_desc_t*") >= 0:
-          f.write("    if (*(params->p" + name + ") != nullptr) {\n")
-          f.write("      stream << \" {\" << GetStructureTypeString((*(params->p" + name + "))->stype)\n")
-          f.write("        << \"(0x\" << std::hex << (*(params->p" + name + "))->stype << std::dec << \") \";\n")
-          f.write("      stream << (*(params->p" + name + "))->pNext << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->commandQueueGroupOrdinal << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->flags << \"}\";\n")
-          f.write("    }\n")
-        elif type.find("ze_event_desc_t*") >= 0:
-          f.write("    if (*(params->p" + name + ") != nullptr) {\n")
-          f.write("      stream << \" {\" << GetStructureTypeString((*(params->p" + name + "))->stype)\n")
-          f.write("        << \"(0x\" << std::hex << (*(params->p" + name + "))->stype << std::dec << \") \";\n")
-          f.write("      stream << (*(params->p" + name + "))->pNext << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->index << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->signal << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->wait << \"}\";\n")
-          f.write("    }\n")
-        elif type.find("ze_fence_desc_t*") >= 0:
-          f.write("    if (*(params->p" + name + ") != nullptr) {\n")
-          f.write("      stream << \" {\" << GetStructureTypeString((*(params->p" + name + "))->stype)\n")
-          f.write("        << \"(0x\" << std::hex << (*(params->p" + name + "))->stype << std::dec << \") \";\n")
-          f.write("      stream << (*(params->p" + name + "))->pNext << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->flags << \"}\";\n")
-          f.write("    }\n")
-        elif type.find("ze_image_desc_t*") >= 0:
-          f.write("    if (*(params->p" + name + ") != nullptr) {\n")
-          f.write("      stream << \" {\" << GetStructureTypeString((*(params->p" + name + "))->stype)\n")
-          f.write("        << \"(0x\" << std::hex << (*(params->p" + name + "))->stype << std::dec << \") \";\n")
-          f.write("      stream << (*(params->p" + name + "))->pNext << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->flags << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->type << \" \";\n")
-          f.write("      stream << \"{\" << (*(params->p" + name +"))->format.layout << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->format.type << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->format.x << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->format.y << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->format.z << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->format.w << \"}\" << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->width << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->height << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->depth << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->arraylevels << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->miplevels << \"}\";\n")
-          f.write("    }\n")
-        elif type.find("ze_host_mem_alloc_desc_t*") >= 0:
-          f.write("    if (*(params->p" + name + ") != nullptr) {\n")
-          f.write("      stream << \" {\" << GetStructureTypeString((*(params->p" + name + "))->stype)\n")
-          f.write("        << \"(0x\" << std::hex << (*(params->p" + name + "))->stype << std::dec << \") \";\n")
-          f.write("      stream << (*(params->p" + name + "))->pNext << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->flags << \"}\";\n")
-          f.write("    }\n")
-        elif type.find("ze_external_memory_export_desc_t*") >= 0:
-          f.write("    if (*(params->p" + name + ") != nullptr) {\n")
-          f.write("      stream << \" {\" << GetStructureTypeString((*(params->p" + name + "))->stype)\n")
-          f.write("        << \"(0x\" << std::hex << (*(params->p" + name + "))->stype << std::dec << \") \";\n")
-          f.write("      stream << (*(params->p" + name + "))->pNext << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->flags << \"}\";\n")
-          f.write("    }\n")
-        elif type.find("ze_module_desc_t*") >= 0:
-          f.write("    if (*(params->p" + name + ") != nullptr) {\n")
-          f.write("      stream << \" {\" << GetStructureTypeString((*(params->p" + name + "))->stype)\n")
-          f.write("        << \"(0x\" << std::hex << (*(params->p" + name + "))->stype << std::dec << \") \";\n")
-          f.write("      stream << (*(params->p" + name + "))->pNext << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->format << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->inputSize << \" \";\n")
-          f.write("      stream << static_cast<const void*>((*(params->p" + name + "))->pInputModule) << \" \";\n")
-          f.write("      if ((*(params->p" + name + ")) -> pBuildFlags != nullptr) \n")
-          f.write("        stream << (*(params->p" + name + "))->pBuildFlags << \" \";\n")
-          f.write("      else stream << 0 << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->pConstants << \"}\";\n")
-          f.write("    }\n")
-        elif type.find("ze_sampler_desc_t*") >= 0:
-          f.write("    if (*(params->p" + name + ") != nullptr) {\n")
-          f.write("      stream << \" {\" << GetStructureTypeString((*(params->p" + name + "))->stype)\n")
-          f.write("        << \"(0x\" << std::hex << (*(params->p" + name + "))->stype << std::dec << \") \";\n")
-          f.write("      stream << (*(params->p" + name + "))->pNext << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->addressMode << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->filterMode << \" \";\n")
-          f.write("      stream << static_cast<int>((*(params->p" + name + "))->isNormalized) << \"}\";\n")
-          f.write("    }\n")
-        elif type.find("ze_physical_mem_desc_t*") >= 0:
-          f.write("    if (*(params->p" + name + ") != nullptr) {\n")
-          f.write("      stream << \" {\" << GetStructureTypeString((*(params->p" + name + "))->stype)\n")
-          f.write("        << \"(0x\" << std::hex << (*(params->p" + name + "))->stype << std::dec << \") \";\n")
-          f.write("      stream << (*(params->p" + name + "))->pNext << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->flags << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->size << \"}\";\n")
-          f.write("    }\n")
-        elif type.find("ze_raytracing_mem_alloc_ext_desc_t*") >= 0:
-          f.write("    if (*(params->p" + name + ") != nullptr) {\n")
-          f.write("      stream << \" {\" << GetStructureTypeString((*(params->p" + name + "))->stype)\n")
-          f.write("        << \"(0x\" << std::hex << (*(params->p" + name + "))->stype << std::dec << \") \";\n")
-          f.write("      stream << (*(params->p" + name + "))->pNext << \" \";\n")
-          f.write("      stream << (*(params->p" + name + "))->flags << \"}\";\n")
-          f.write("    }\n")
-  f.write("    stream << std::endl;\n")
-  f.write("    std::cerr << stream.str();\n")
+    elif get_desc_string_field(get_desc_type(type)):
+      field = "args." + name + "_value." + get_desc_string_field(get_desc_type(type))
+      f.write("    if (args." + name + " != nullptr && " + field + " != nullptr) {\n")
+      f.write("      record.PutString(" + field + ");\n")
+      f.write("    }\n")
+  f.write("    record.Submit();\n")
   f.write("  }\n")
 
+def gen_exit_args(f, func, params):
+  f.write("struct " + func + "OnExitArgs {\n")
+  f.write("  uint64_t end_time;\n")
+  f.write("  uint64_t time;\n")
+  f.write("  ze_result_t result;\n")
+  for name, type in params:
+    if is_out_param(name):
+      f.write("  " + type + " " + name + ";\n")
+      if not is_ipc_pointer_type(type):
+        f.write("  " + get_value_type(type) + " " + name + "_value;\n")
+  f.write("};\n")
+  f.write("\n")
+
+def gen_exit_printer(f, func, params):
+  f.write("static size_t " + func + "OnExitPrint(\n")
+  f.write("    std::ostream& stream, const uint8_t* data) {\n")
+  f.write("  utils::CallRecordReader reader(data);\n")
+  f.write("  " + func + "OnExitArgs args;\n")
+  f.write("  reader.Get(args);\n")
+  f.write("\n")
+  f.write("  stream << \"<<<< [\" << args.end_time << \"] \";\n")
+  f.write("  stream << \"" + func + "\" << \" [\" << args.time << \" ns]\";\n")
+  for name, type in params:
+    if is_out_param(name):
+      f.write("  if (args." + name + " != nullptr) {\n")
+      if is_ipc_pointer_type(type):
+        f.write("    stream << \" " + name[1:] + " = \" << reader.GetString();\n")
+      else:
+        f.write("    stream << \" " + name[1:] + " = \" << args." + name + "_value;\n")
+      f.write("  }\n")
+  f.write("  stream << \" -> \" << GetResultString(args.result) <<\n")
+  f.write("    \"(0x\" << args.result << \")\" << std::endl;\n")
+  f.write("\n")
+  f.write("  return reader.GetSize();\n")
+  f.write("}\n")
+  f.write("\n")
+
 def gen_exit_callback(f, func, params, enum_map):
   f.write("  PTI_ASSERT(global_user_data != nullptr);\n")
   f.write("  ZeApiCollector* collector =\n")
@@ -501,22 +597,29 @@ def gen_exit_callback(f, func, params, enum_map):
   f.write("  PTI_ASSERT(start_time > 0);\n")
   f.write("  PTI_ASSERT(start_time < end_time);\n")
   f.write("  uint64_t time = end_time - start_time;\n")
-  f.write("  collector->AddFunctionTime(\"" + func + "\", time);\n")
+  f.write("  collector->AddFunctionTime(" + get_func_id(func) + ", time);\n")
   f.write("  if (collector->call_tracing_) {\n")
-  f.write("    std::stringstream stream;\n")
-  f.write("    stream << \"<<<< [\" << end_time << \"] \";\n")
-  f.write("    stream << \"" + func + "\" << \" [\" << time << \" ns]\";\n")
+  f.write("    " + func + "OnExitArgs args = {};\n")
+  f.write("    args.end_time = end_time;\n")
+  f.write("    args.time = time;\n")
+  f.write("    args.result = result;\n")
   for name, type in params:
-    if name.find("ph") == 0 or name.find("pptr") == 0 or name.find("pCount") == 0:
-      f.write("    if (*(params->p" + name + ") != nullptr) {\n")
-      if type == "ze_ipc_mem_handle_t*" or type == "ze_ipc_event_pool_handle_t*":
-        f.write("      stream << \" " + name[1:] + " = \" << (*(params->p" + name + "))->data << \"\";\n")
-      else:
-        f.write("      stream << \" " + name[1:] + " = \" << **(params->p" + name + ") << \"\";\n")
+    if is_out_param(name):
+      f.write("    args." + name + " = *(params->p" + name + ");\n")
+      if not is_ipc_pointer_type(type):
+        f.write("    if (args." + name + " != nullptr) {\n")
+        f.write("      args." + name + "_value = *args." + name + ";\n")
+        f.write("    }\n")
+  f.write("\n")
+  f.write("    utils::CallRecord record;\n")
+  f.write("    record.Begin(" + func + "OnExitPrint);\n")
+  f.write("    record.Put(args);\n")
+  for name, type in params:
+    if is_out_param(name) and is_ipc_pointer_type(type):
+      f.write("    if (args." + name + " != nullptr) {\n")
+      gen_ipc_string(f, "args." + name, "      ")
       f.write("    }\n")
-  f.write("    stream << \" -> \" << GetResultString(result) << \n")
-  f.write("      \"(0x\" << result << \")\" << std::endl;\n")
-  f.write("    std::cerr << stream.str();\n")
+  f.write("    record.Submit();\n")
   f.write("  }\n")
   f.write("\n")
   f.write("  if (collector->callback_ != nullptr) {\n")
@@ -534,6 +637,10 @@ def gen_callbacks(f, func_list, group_map, param_map, enum_map):
     callback_cond = callback[1]
     if callback_cond:
       f.write("#if " + callback_cond + "\n")
+    gen_enter_args(f, func, param_map[func])
+    gen_enter_printer(f, func, param_map[func])
+    gen_exit_args(f, func, param_map[func])
+    gen_exit_printer(f, func, param_map[func])
     f.write("static void " + func + "OnEnter(\n")
     f.write("    " + get_param_struct_name(func) + "* params,\n")
     f.write("    ze_result_t result,\n")
@@ -577,6 +684,8 @@ def main():
   param_map = get_param_map(l0_file)
   enum_map = get_enum_map(l0_path)
 
+  gen_func_ids(dst_file, func_list)
+  gen_func_names(dst_file, func_list)
   gen_result_converter(dst_file, enum_map)
   gen_structure_type_converter(dst_file, enum_map)
   gen_callbacks(dst_file, func_list, group_map, param_map, enum_map)
@@ -7,15 +7,21 @@
 #ifndef PTI_SAMPLES_ZE_HOT_FUNCTIONS_ZE_API_COLLECTOR_H_
 #define PTI_SAMPLES_ZE_HOT_FUNCTIONS_ZE_API_COLLECTOR_H_
 
+#include <bitset>
 #include <chrono>
 #include <iomanip>
 #include <iostream>
 #include <map>
-#include <mutex>
 #include <set>
+#include <sstream>
+#include <string>
+#include <type_traits>
 
 #include <level_zero/layers/zel_tracing_api.h>
 
+#include "call_logger.h"
+#include "function_info_table.h"
+#include "timestamp.h"
 #include "utils.h"
 #include "ze_utils.h"
 
@@ -53,7 +59,8 @@ class ZeApiCollector {
       ZeFunctionTimePoint base_time = std::chrono::steady_clock::now(),
       bool call_tracing = false,
       OnZeFunctionFinishCallback callback = nullptr,
-      void* callback_data = nullptr) {
+      void* callback_data = nullptr,
+      const std::string& filter = std::string()) {
     ZeApiCollector* collector =
       new ZeApiCollector(base_time, call_tracing,
                          callback, callback_data);
@@ -72,7 +79,7 @@ class ZeApiCollector {
     }
 
     collector->tracer_ = tracer;
-    SetTracingAPIs(tracer);
+    SetTracingAPIs(tracer, GetFunctionMask(filter));
 
     status = zelTracerSetEnabled(tracer, true);
     PTI_ASSERT(status == ZE_RESULT_SUCCESS);
@@ -85,10 +92,14 @@ class ZeApiCollector {
     ze_result_t status = ZE_RESULT_SUCCESS;
     status = zelTracerSetEnabled(tracer_, false);
     PTI_ASSERT(status == ZE_RESULT_SUCCESS);
+
+    if (call_tracing_) {
+      utils::GetCallLogger().Flush();
+    }
   }
 
-  const ZeFunctionInfoMap& GetFunctionInfoMap() const {
-    return function_info_map_;
+  ZeFunctionInfoMap GetFunctionInfoMap() const {
+    return function_info_table_.GetFunctionInfoMap(GetFunctionName);
   }
 
   static void PrintFunctionsTable(const ZeFunctionInfoMap& function_info_map) {
@@ -145,26 +156,11 @@ class ZeApiCollector {
 
  private: // Tracing Interface
   uint64_t GetTimestamp() const {
-    std::chrono::duration<uint64_t, std::nano> timestamp =
-      std::chrono::steady_clock::now() - base_time_;
-    return timestamp.count();
+    return utils::GetTimestamp(base_time_);
   }
 
-  void AddFunctionTime(const std::string& name, uint64_t time) {
-    const std::lock_guard<std::mutex> lock(lock_);
-    if (function_info_map_.count(name) == 0) {
-      function_info_map_[name] = {time, time, time, 1};
-    } else {
-      ZeFunction& function = function_info_map_[name];
-      function.total_time += time;
-      if (time < function.min_time) {
-        function.min_time = time;
-      }
-      if (time > function.max_time) {
-        function.max_time = time;
-      }
-      ++function.call_count;
-    }
+  void AddFunctionTime(uint32_t id, uint64_t time) {
+    function_info_table_.AddFunctionTime(id, time);
   }
 
  private: // Implementation Details
@@ -176,11 +172,53 @@ class ZeApiCollector {
 
   #include <tracing.gen> // Auto-generated callbacks
 
+  // Filter is a comma-separated list of function names. Names prefixed
+  // with '-' are excluded from tracing, the others are the only ones
+  // to be traced. Empty filter enables all the functions. Callbacks are
+  // registered for enabled functions only, so the rest are not traced
+  // at all
+  static ZeFunctionMask GetFunctionMask(const std::string& filter) {
+    ZeFunctionMask include_mask;
+    ZeFunctionMask exclude_mask;
+
+    std::stringstream stream(filter);
+    std::string name;
+    while (std::getline(stream, name, ',')) {
+      bool exclude = (!name.empty() && name[0] == '-');
+      if (exclude) {
+        name = name.substr(1);
+      }
+      if (name.empty()) {
+        continue;
+      }
+
+      uint32_t id = 0;
+      while (id < ZeFunctionIdCount && name != GetFunctionName(id)) {
+        ++id;
+      }
+      if (id == ZeFunctionIdCount) {
+        std::cerr << "[WARNING] Unknown function in filter: " << name <<
+          std::endl;
+        continue;
+      }
+
+      if (exclude) {
+        exclude_mask.set(id);
+      } else {
+        include_mask.set(id);
+      }
+    }
+
+    if (include_mask.none()) {
+      include_mask.set();
+    }
+    return include_mask & ~exclude_mask;
+  }
+
  private: // Data
   zel_tracer_handle_t tracer_ = nullptr;
 
-  ZeFunctionInfoMap function_info_map_;
-  std::mutex lock_;
+  utils::FunctionInfoTable<ZeFunction, ZeFunctionIdCount> function_info_table_;
 
   ZeFunctionTimePoint base_time_;
   bool call_tracing_ = false;
@@ -4,9 +4,12 @@
 // SPDX-License-Identifier: MIT
 // =============================================================
 
+#include <string.h>
+
 #include <iomanip>
 #include <iostream>
 #include <set>
+#include <string>
 
 #include "utils.h"
 #include "ze_kernel_collector.h"
@@ -22,7 +25,11 @@ __declspec(dllexport)
 #endif
 void Usage() {
   std::cout <<
-    "Usage: ./ze_hot_kernels[.exe] <application> <args>" <<
+    "Usage: ./ze_hot_kernels[.exe] [options] <application> <args>" <<
+    std::endl;
+  std::cout << "Options:" << std::endl;
+  std::cout <<
+    "--reaper-period [-r] <ms>       Collect completed kernels in background" <<
     std::endl;
 }
 
@@ -31,7 +38,22 @@ extern "C"
 __declspec(dllexport)
 #endif
 int ParseArgs(int argc, char* argv[]) {
-  return 1;
+  int app_index = 1;
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "--reaper-period") == 0 ||
+        strcmp(argv[i], "-r") == 0) {
+      ++i;
+      if (i >= argc) {
+        return argc; // Treated by loader as invalid command line
+      }
+      std::string value = std::string("ZEHK_ReaperPeriod=") + argv[i];
+      utils::SetEnv(value.c_str());
+      app_index += 2;
+    } else {
+      break;
+    }
+  }
+  return app_index;
 }
 
 extern "C"
@@ -80,7 +102,14 @@ void EnableProfiling() {
   status = zeInit(ZE_INIT_FLAG_GPU_ONLY);
   PTI_ASSERT(status == ZE_RESULT_SUCCESS);
 
-  collector = ZeKernelCollector::Create();
+  uint32_t reaper_period = 0;
+  std::string value = utils::GetEnv("ZEHK_ReaperPeriod");
+  if (!value.empty()) {
+    reaper_period = static_cast<uint32_t>(strtoul(value.c_str(), nullptr, 10));
+  }
+
+  collector = ZeKernelCollector::Create(
+      std::chrono::steady_clock::now(), nullptr, nullptr, reaper_period);
   start = std::chrono::steady_clock::now();
 }
 
@@ -7,27 +7,40 @@
 #ifndef PTI_SAMPLES_ZE_HOT_KERNELS_ZE_KERNEL_COLLECTOR_H_
 #define PTI_SAMPLES_ZE_HOT_KERNELS_ZE_KERNEL_COLLECTOR_H_
 
+#include <algorithm>
+#include <condition_variable>
+#include <iterator>
 #include <list>
 #include <map>
 #include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include <level_zero/layers/zel_tracing_api.h>
 
 #include "i915_utils.h"
+#include "kernel_info_accumulator.h"
+#include "string_table.h"
+#include "tick_converter.h"
+#include "timestamp.h"
 #include "utils.h"
+#include "ze_event_cache.h"
 #include "ze_utils.h"
 
 struct ZeKernelInstance {
-  std::string name;
+  uint32_t name_id;
   size_t simd_width;
   size_t bytes_transferred;
   void* queue;
-  ze_event_pool_handle_t event_pool;
   ze_event_handle_t event;
+  bool cached_event;
+  uint64_t event_generation; // Context generation of the cached event
   uint64_t append_time;
   uint64_t submit_time;
+  ze_context_handle_t context;
+  ze_kernel_timestamp_result_t timestamp;
 };
 
 struct ZeKernelInfo {
@@ -54,7 +67,7 @@ struct ZeKernelInfo {
 };
 
 struct ZeKernelInterval {
-  std::string name;
+  uint32_t name_id;
   uint64_t start;
   uint64_t end;
 };
@@ -67,12 +80,15 @@ struct ZeCommandListInfo {
 
 using ZeKernelInfoMap = std::map<std::string, ZeKernelInfo>;
 using ZeKernelIntervalList = std::vector<ZeKernelInterval>;
-using ZeKernelNameMap = std::map<ze_kernel_handle_t, std::string>;
+using ZeKernelInstanceList = std::list<ZeKernelInstance>;
+using ZeKernelInstanceMap =
+  std::unordered_map<ze_event_handle_t, ZeKernelInstanceList::iterator>;
+using ZeKernelNameMap = std::map<ze_kernel_handle_t, uint32_t>;
 using ZeKernelTimePoint = std::chrono::time_point<std::chrono::steady_clock>;
 using ZeCommandListMap = std::map<ze_command_list_handle_t, ZeCommandListInfo>;
 
 typedef void (*OnZeKernelFinishCallback)(
-    void* data, void* queue, const std::string& name,
+    void* data, void* queue, uint32_t name_id,
     uint64_t appended, uint64_t submitted,
     uint64_t started, uint64_t ended);
 
@@ -82,7 +98,8 @@ class ZeKernelCollector {
   static ZeKernelCollector* Create(
       ZeKernelTimePoint base_time = std::chrono::steady_clock::now(),
       OnZeKernelFinishCallback callback = nullptr,
-      void* callback_data = nullptr) {
+      void* callback_data = nullptr,
+      uint32_t reaper_period = 0) {
     ZeKernelCollector* collector = new ZeKernelCollector(
         base_time, callback, callback_data);
     PTI_ASSERT(collector != nullptr);
@@ -99,6 +116,9 @@ class ZeKernelCollector {
     }
 
     collector->EnableTracing(tracer);
+    if (reaper_period > 0) {
+      collector->StartReaper(reaper_period);
+    }
     return collector;
   }
 
@@ -156,13 +176,16 @@ class ZeKernelCollector {
   }
 
   ~ZeKernelCollector() {
+    StopReaper();
     if (tracer_ != nullptr) {
       ze_result_t status = zelTracerDestroy(tracer_);
       PTI_ASSERT(status == ZE_RESULT_SUCCESS);
     }
+    delete clock_correlator_;
   }
 
   void DisableTracing() {
+    StopReaper();
     PTI_ASSERT(tracer_ != nullptr);
     ze_result_t status = ZE_RESULT_SUCCESS;
     status = zelTracerSetEnabled(tracer_, false);
@@ -170,6 +193,10 @@ class ZeKernelCollector {
   }
 
   const ZeKernelInfoMap& GetKernelInfoMap() const {
+    kernel_info_map_.clear();
+    for (auto& value : kernel_info_accumulator_.GetKernelInfoMap()) {
+      kernel_info_map_[utils::GetInternedString(value.first)] = value.second;
+    }
     return kernel_info_map_;
   }
 
@@ -177,26 +204,45 @@ class ZeKernelCollector {
     return kernel_interval_list_;
   }
 
+  // Moves out the intervals collected so far, so the list does not grow
+  // through the run if the intervals are consumed incrementally
+  ZeKernelIntervalList TakeKernelIntervalList() {
+    ZeKernelIntervalList kernel_interval_list;
+    const std::lock_guard<std::mutex> lock(lock_);
+    kernel_interval_list.swap(kernel_interval_list_);
+    return kernel_interval_list;
+  }
+
+  const utils::ZeEventCache& GetEventCache() const {
+    return event_cache_;
+  }
+
  private: // Implementation
 
   ZeKernelCollector(
       ZeKernelTimePoint base_time,
       OnZeKernelFinishCallback callback,
       void* callback_data)
-      : base_time_(base_time),
+      : timer_frequency_(utils::i915::GetGpuTimerFrequency()),
+        tick_converter_(timer_frequency_),
+        base_time_(base_time),
         callback_(callback),
         callback_data_(callback_data),
-        timer_frequency_(utils::i915::GetGpuTimerFrequency()) {
+        memory_copy_name_id_(
+            utils::InternString("zeCommandListAppendMemoryCopy")),
+        event_cache_(ZE_EVENT_POOL_FLAG_KERNEL_TIMESTAMP |
+                     ZE_EVENT_POOL_FLAG_HOST_VISIBLE) {
     PTI_ASSERT(timer_frequency_ > 0);
     if (callback_ != nullptr) {
-      SetCpuGpuTimestamps();
+      clock_correlator_ = new utils::ClockCorrelator(
+          new utils::i915::GpuClockSource, timer_frequency_,
+          utils::i915::kGpuTimestampBits);
+      PTI_ASSERT(clock_correlator_ != nullptr);
     }
   }
 
   uint64_t GetTimestamp() const {
-    std::chrono::duration<uint64_t, std::nano> timestamp =
-      std::chrono::steady_clock::now() - base_time_;
-    return timestamp.count();
+    return utils::GetTimestamp(base_time_);
   }
 
   void EnableTracing(zel_tracer_handle_t tracer) {
@@ -210,6 +256,8 @@ class ZeKernelCollector {
 
     prologue_callbacks.Event.pfnHostResetCb = OnEnterEventHostReset;
 
+    prologue_callbacks.Context.pfnDestroyCb = OnEnterContextDestroy;
+
     prologue_callbacks.EventPool.pfnCreateCb = OnEnterEventPoolCreate;
     epilogue_callbacks.EventPool.pfnCreateCb = OnExitEventPoolCreate;
 
@@ -253,13 +301,14 @@ class ZeKernelCollector {
     PTI_ASSERT(status == ZE_RESULT_SUCCESS);
   }
 
-  void AddKernelName(ze_kernel_handle_t kernel, std::string name) {
+  void AddKernelName(ze_kernel_handle_t kernel, const char* name) {
     PTI_ASSERT(kernel != nullptr);
-    PTI_ASSERT(!name.empty());
+    PTI_ASSERT(name != nullptr && name[0] != '\0');
 
+    uint32_t name_id = utils::InternString(name);
     const std::lock_guard<std::mutex> lock(lock_);
     PTI_ASSERT(kernel_name_map_.count(kernel) == 0);
-    kernel_name_map_[kernel] = name;
+    kernel_name_map_[kernel] = name_id;
   }
 
   void RemoveKernelName(ze_kernel_handle_t kernel) {
@@ -270,15 +319,13 @@ class ZeKernelCollector {
     kernel_name_map_.erase(kernel);
   }
 
-  std::string GetKernelName(ze_kernel_handle_t kernel) {
+  uint32_t GetKernelNameId(ze_kernel_handle_t kernel) {
     PTI_ASSERT(kernel != nullptr);
 
     const std::lock_guard<std::mutex> lock(lock_);
-    if (kernel_name_map_.count(kernel) == 1) {
-      return kernel_name_map_[kernel];
-    }
-
-    return std::string();
+    auto it = kernel_name_map_.find(kernel);
+    PTI_ASSERT(it != kernel_name_map_.end());
+    return it->second;
   }
 
   void AddKernelInstance(ze_command_list_handle_t command_list,
@@ -288,8 +335,16 @@ class ZeKernelCollector {
     kernel_instance_list_.push_back(instance);
     ZeKernelInstance* kernel_instance = &kernel_instance_list_.back();
 
+    // In case the same event is signaled several times without reset,
+    // only the latest instance is indexed, older ones are processed
+    // with ProcessInstances() on completion
+    PTI_ASSERT(kernel_instance->event != nullptr);
+    kernel_instance_map_[kernel_instance->event] =
+      std::prev(kernel_instance_list_.end());
+
     PTI_ASSERT(command_list_map_.count(command_list) == 1);
     ZeCommandListInfo& command_list_info = command_list_map_[command_list];
+    kernel_instance->context = command_list_info.context;
     if (command_list_info.immediate) {
       kernel_instance->submit_time = kernel_instance->append_time;
       kernel_instance->queue = command_list;
@@ -299,136 +354,261 @@ class ZeKernelCollector {
 
   void ProcessInstance(ze_event_handle_t event) {
     PTI_ASSERT(event != nullptr);
-    const std::lock_guard<std::mutex> lock(lock_);
+    ZeKernelInstance instance;
 
-    for (auto it = kernel_instance_list_.begin();
-         it != kernel_instance_list_.end(); ++it) {
-      if ((*it).event == event) {
-        ProcessInstance(*it);
-        kernel_instance_list_.erase(it);
-        break;
+    {
+      const std::lock_guard<std::mutex> lock(lock_);
+      auto it = kernel_instance_map_.find(event);
+      if (it == kernel_instance_map_.end()) {
+        return;
       }
+      ze_result_t status = zeEventQueryStatus(event);
+      PTI_ASSERT(status == ZE_RESULT_SUCCESS);
+      QueryTimestamp(*(it->second));
+
+      instance = *(it->second);
+      kernel_instance_list_.erase(it->second);
+      kernel_instance_map_.erase(it);
     }
+
+    ProcessInstance(instance);
   }
 
-  void ProcessInstance(const ZeKernelInstance& instance) {
-    ze_result_t status = ZE_RESULT_SUCCESS;
-    status = zeEventQueryStatus(instance.event);
+  // Timestamp is read while the instance is still indexed and the lock is
+  // held, so the event reset or destroy by the application waits for it
+  void QueryTimestamp(ZeKernelInstance& instance) {
+    PTI_ASSERT(instance.event != nullptr);
+    ze_result_t status = zeEventQueryKernelTimestamp(
+        instance.event, &instance.timestamp);
     PTI_ASSERT(status == ZE_RESULT_SUCCESS);
+  }
 
-    ze_kernel_timestamp_result_t timestamp{};
-    status = zeEventQueryKernelTimestamp(instance.event, &timestamp);
-    PTI_ASSERT(status == ZE_RESULT_SUCCESS);
+  void RemoveInstanceIndex(ZeKernelInstanceList::iterator instance) {
+    auto it = kernel_instance_map_.find(instance->event);
+    if (it != kernel_instance_map_.end() && it->second == instance) {
+      kernel_instance_map_.erase(it);
+    }
+  }
 
+  // Instance is expected to be taken out with its timestamp queried
+  void ProcessInstance(const ZeKernelInstance& instance) {
+    const ze_kernel_timestamp_result_t& timestamp = instance.timestamp;
     uint64_t start = timestamp.global.kernelStart;
-    uint64_t end = timestamp.global.kernelEnd;
-    uint64_t time = 0, start_ns = 0, end_ns = 0;
 
-    start_ns = start *
-      static_cast<uint64_t>(NSEC_IN_SEC) / timer_frequency_;
-    if (start < end) {
-      end_ns = end *
-        static_cast<uint64_t>(NSEC_IN_SEC) / timer_frequency_;
-    } else { // 32-bit timer overflow
-      PTI_ASSERT(start < (1ULL << 32));
-      end_ns = ((1ULL << 32) + end) *
-        static_cast<uint64_t>(NSEC_IN_SEC) / timer_frequency_;
-    }
-    time = end_ns - start_ns;
+    // Timer may overflow while the kernel runs, so the end is taken
+    // within one timer period after the start
+    utils::CounterUnwrapper unwrapper(utils::i915::kGpuTimestampBits);
+    uint64_t ticks[] = {
+        unwrapper.Unwrap(start),
+        unwrapper.Unwrap(timestamp.global.kernelEnd)};
+    uint64_t ns[] = {0, 0};
+    tick_converter_.ToNs(ticks, ns, 2);
+
+    uint64_t start_ns = ns[0], end_ns = ns[1];
+    uint64_t time = end_ns - start_ns;
 
-    AddKernelInfo(instance.name, time,
-                  instance.simd_width,
-                  instance.bytes_transferred);
+    kernel_info_accumulator_.AddKernelInfo(
+        instance.name_id, time, instance.simd_width, instance.bytes_transferred);
 
-    if (instance.simd_width > 0) { // User kernels only
-      AddKernelInterval(instance.name, start_ns, end_ns);
+    // User kernels only, the ones shorter than a timer tick have no
+    // interval to correlate with
+    if (instance.simd_width > 0 && end_ns > start_ns) {
+      AddKernelInterval(instance.name_id, start_ns, end_ns);
     }
 
     if (callback_ != nullptr) {
+      const std::lock_guard<std::mutex> lock(lock_);
       PTI_ASSERT(instance.append_time > 0);
       PTI_ASSERT(instance.submit_time > 0);
 
-      uint64_t cpu_start = 0, cpu_end = 0;
-      std::chrono::duration<uint64_t, std::nano> time_shift =
-        cpu_timestamp_ - base_time_;
-
-      if (gpu_timestamp_ < start) {
-        cpu_start = (start - gpu_timestamp_) *
-          static_cast<uint64_t>(NSEC_IN_SEC) / timer_frequency_ +
-          time_shift.count();
-        cpu_end = cpu_start + time;
-      } else { // 32-bit timer overflow
-        SetCpuGpuTimestamps();
-        time_shift = cpu_timestamp_ - base_time_;
-        PTI_ASSERT(start < gpu_timestamp_);
-        cpu_start = time_shift.count() - (gpu_timestamp_ - start) *
-          static_cast<uint64_t>(NSEC_IN_SEC) / timer_frequency_;
-        cpu_end = cpu_start + time;
-      }
+      PTI_ASSERT(clock_correlator_ != nullptr);
+      uint64_t base_time = std::chrono::duration_cast<
+        std::chrono::nanoseconds>(base_time_.time_since_epoch()).count();
+      uint64_t cpu_start = clock_correlator_->GetHostTime(start);
+      PTI_ASSERT(cpu_start > base_time);
+      cpu_start -= base_time;
+      uint64_t cpu_end = cpu_start + time;
 
       PTI_ASSERT(instance.queue != nullptr);
-      PTI_ASSERT(!instance.name.empty());
       PTI_ASSERT(instance.append_time > 0);
       PTI_ASSERT(instance.submit_time > 0);
-      callback_(callback_data_, instance.queue, instance.name,
+      callback_(callback_data_, instance.queue, instance.name_id,
                 instance.append_time, instance.submit_time,
                 cpu_start, cpu_end);
     }
 
-    if (instance.event_pool != nullptr) {
-      ze_result_t status = ZE_RESULT_SUCCESS;
-      status = zeEventDestroy(instance.event);
-      PTI_ASSERT(status == ZE_RESULT_SUCCESS);
-      status = zeEventPoolDestroy(instance.event_pool);
-      PTI_ASSERT(status == ZE_RESULT_SUCCESS);
+    // Cache returns false if the event is already destroyed along with
+    // its context by ReleaseContext(), even if its handle is reused since
+    if (instance.cached_event) {
+      event_cache_.ReleaseEvent(instance.event, instance.event_generation);
     }
   }
 
   void ProcessInstances() {
     ze_result_t status = ZE_RESULT_SUCCESS;
-    const std::lock_guard<std::mutex> lock(lock_);
+    std::vector<ZeKernelInstance> completed_list;
+
+    {
+      const std::lock_guard<std::mutex> lock(lock_);
+      auto it = kernel_instance_list_.begin();
+      while (it != kernel_instance_list_.end()) {
+        PTI_ASSERT(it->event != nullptr);
+        status = zeEventQueryStatus(it->event);
+        if (status == ZE_RESULT_NOT_READY) {
+          ++it;
+        } else if (status == ZE_RESULT_SUCCESS) {
+          RemoveInstanceIndex(it);
+          QueryTimestamp(*it);
+          completed_list.push_back(*it);
+          it = kernel_instance_list_.erase(it);
+        } else {
+          PTI_ASSERT(0);
+        }
+      }
+    }
+
+    for (auto& instance : completed_list) {
+      ProcessInstance(instance);
+    }
+  }
 
-    auto it = kernel_instance_list_.begin();
-    while (it != kernel_instance_list_.end()) {
-      PTI_ASSERT(it->event != nullptr);
-      status = zeEventQueryStatus(it->event);
-      if (status == ZE_RESULT_NOT_READY) {
-        ++it;
-      } else if (status == ZE_RESULT_SUCCESS) {
-        ProcessInstance(*it);
+  // Checks up to max_count instances from the head of the list: completed
+  // ones are processed, others are moved to the tail, so the next call
+  // continues with unchecked instances. Returns number of checked ones
+  size_t ProcessInstances(size_t max_count) {
+    ze_result_t status = ZE_RESULT_SUCCESS;
+    std::vector<ZeKernelInstance> completed_list;
+    size_t count = 0;
+
+    {
+      const std::lock_guard<std::mutex> lock(lock_);
+      // Moved instances are not checked twice within the call
+      max_count = (std::min)(max_count, kernel_instance_list_.size());
+      auto it = kernel_instance_list_.begin();
+      while (count < max_count) {
+        PTI_ASSERT(it->event != nullptr);
+        status = zeEventQueryStatus(it->event);
+        auto next = std::next(it);
+        if (status == ZE_RESULT_NOT_READY) {
+          // Iterators and pointers to the instance stay valid
+          kernel_instance_list_.splice(
+              kernel_instance_list_.end(), kernel_instance_list_, it);
+        } else if (status == ZE_RESULT_SUCCESS) {
+          RemoveInstanceIndex(it);
+          QueryTimestamp(*it);
+          completed_list.push_back(*it);
+          kernel_instance_list_.erase(it);
+        } else {
+          PTI_ASSERT(0);
+        }
+        it = next;
+        ++count;
+      }
+    }
+
+    for (auto& instance : completed_list) {
+      ProcessInstance(instance);
+    }
+
+    return count;
+  }
+
+  // Takes out all the instances of the context under the lock, so neither
+  // the reaper nor synchronization points query its events after they are
+  // destroyed: completed instances are processed, the rest are dropped as
+  // their events do not outlive the context
+  void ReleaseContext(ze_context_handle_t context) {
+    PTI_ASSERT(context != nullptr);
+    ze_result_t status = ZE_RESULT_SUCCESS;
+    std::vector<ZeKernelInstance> completed_list;
+
+    {
+      const std::lock_guard<std::mutex> lock(lock_);
+      auto it = kernel_instance_list_.begin();
+      while (it != kernel_instance_list_.end()) {
+        if (it->context != context) {
+          ++it;
+          continue;
+        }
+
+        PTI_ASSERT(it->event != nullptr);
+        status = zeEventQueryStatus(it->event);
+        RemoveInstanceIndex(it);
+        if (status == ZE_RESULT_SUCCESS) {
+          QueryTimestamp(*it);
+          completed_list.push_back(*it);
+        }
         it = kernel_instance_list_.erase(it);
-      } else {
-        PTI_ASSERT(0);
       }
     }
+
+    for (auto& instance : completed_list) {
+      ProcessInstance(instance);
+    }
+
+    // Cached events are reset on release with the calls traced by the
+    // collector itself, so the cache is never called under the lock
+    event_cache_.ReleaseContext(context);
   }
 
-  void AddKernelInfo(
-      std::string name, uint64_t time,
-      size_t simd_width, size_t bytes_transferred) {
-    PTI_ASSERT(!name.empty());
-    if (kernel_info_map_.count(name) == 0) {
-      kernel_info_map_[name] = {
-        time, time, time, 1, simd_width, bytes_transferred};
-    } else {
-      ZeKernelInfo& kernel = kernel_info_map_[name];
-      kernel.total_time += time;
-      if (time > kernel.max_time) {
-        kernel.max_time = time;
+  size_t GetInstanceCount() {
+    const std::lock_guard<std::mutex> lock(lock_);
+    return kernel_instance_list_.size();
+  }
+
+  void StartReaper(uint32_t period) {
+    PTI_ASSERT(period > 0);
+    PTI_ASSERT(!reaper_thread_.joinable());
+    reaper_period_ = period;
+    reaper_active_ = true;
+    reaper_thread_ = std::thread(Reap, this);
+  }
+
+  void StopReaper() {
+    if (!reaper_thread_.joinable()) {
+      return;
+    }
+
+    {
+      const std::lock_guard<std::mutex> lock(reaper_lock_);
+      reaper_active_ = false;
+    }
+    reaper_condition_.notify_one();
+    reaper_thread_.join();
+  }
+
+  // Harvests completed instances in between application synchronization
+  // points, in batches to keep lock hold time short
+  static void Reap(ZeKernelCollector* collector) {
+    PTI_ASSERT(collector != nullptr);
+
+    std::unique_lock<std::mutex> lock(collector->reaper_lock_);
+    while (collector->reaper_active_) {
+      collector->reaper_condition_.wait_for(
+          lock, std::chrono::milliseconds(collector->reaper_period_));
+      if (!collector->reaper_active_) {
+        break;
       }
-      if (time < kernel.min_time) {
-        kernel.min_time = time;
+      lock.unlock();
+
+      size_t total_count = collector->GetInstanceCount();
+      size_t count = 0;
+      while (count < total_count) {
+        size_t processed = collector->ProcessInstances(kReaperBatchSize);
+        if (processed == 0) {
+          break;
+        }
+        count += processed;
       }
-      kernel.call_count += 1;
-      kernel.bytes_transferred += bytes_transferred;
-      PTI_ASSERT(kernel.simd_width == simd_width);
+
+      lock.lock();
     }
   }
 
-  void AddKernelInterval(std::string name, uint64_t start, uint64_t end) {
-    PTI_ASSERT(!name.empty());
+  void AddKernelInterval(uint32_t name_id, uint64_t start, uint64_t end) {
     PTI_ASSERT(start < end);
-    kernel_interval_list_.push_back({name, start, end});
+    const std::lock_guard<std::mutex> lock(lock_);
+    kernel_interval_list_.push_back({name_id, start, end});
   }
 
   void AddCommandList(ze_command_list_handle_t command_list,
@@ -480,11 +660,6 @@ class ZeKernelCollector {
     return command_list_info.context;
   }
 
-  void SetCpuGpuTimestamps() {
-    gpu_timestamp_ = utils::i915::GetGpuTimestamp() & 0x0FFFFFFFF;
-    cpu_timestamp_ = std::chrono::steady_clock::now();
-  }
-
  private: // Callbacks
 
   static void OnExitKernelCreate(
@@ -571,25 +746,16 @@ class ZeKernelCollector {
     }
   }
 
-  static void CreateEvent(ze_context_handle_t context,
-                          ze_event_pool_handle_t& event_pool,
-                          ze_event_handle_t& event) {
-    PTI_ASSERT(context != nullptr);
-    ze_result_t status = ZE_RESULT_SUCCESS;
-
-    ze_event_pool_desc_t event_pool_desc = {
-        ZE_STRUCTURE_TYPE_EVENT_POOL_DESC, nullptr,
-        ZE_EVENT_POOL_FLAG_KERNEL_TIMESTAMP | ZE_EVENT_POOL_FLAG_HOST_VISIBLE,
-        1};
-    status = zeEventPoolCreate(
-        context, &event_pool_desc, 0, nullptr, &event_pool);
-    PTI_ASSERT(status == ZE_RESULT_SUCCESS);
-
-    ze_event_desc_t event_desc = {
-        ZE_STRUCTURE_TYPE_EVENT_DESC, nullptr, 0,
-        ZE_EVENT_SCOPE_FLAG_HOST, ZE_EVENT_SCOPE_FLAG_HOST};
-    zeEventCreate(event_pool, &event_desc, &event);
-    PTI_ASSERT(status == ZE_RESULT_SUCCESS);
+  static void OnEnterContextDestroy(ze_context_destroy_params_t *params,
+                                    ze_result_t result,
+                                    void *global_data,
+                                    void **instance_data) {
+    if (*(params->phContext) != nullptr) {
+      ZeKernelCollector* collector =
+        reinterpret_cast<ZeKernelCollector*>(global_data);
+      PTI_ASSERT(collector != nullptr);
+      collector->ReleaseContext(*(params->phContext));
+    }
   }
 
   static void OnEnterCommandListAppendLaunchKernel(
@@ -606,8 +772,7 @@ class ZeKernelCollector {
 
     ZeKernelInstance* instance = new ZeKernelInstance;
     PTI_ASSERT(instance != nullptr);
-    instance->name = collector->GetKernelName(*(params->phKernel));
-    PTI_ASSERT(!instance->name.empty());
+    instance->name_id = collector->GetKernelNameId(*(params->phKernel));
 
     ze_kernel_properties_t props{};
     ze_result_t status = zeKernelGetProperties(*(params->phKernel), &props);
@@ -621,11 +786,14 @@ class ZeKernelCollector {
     if (*(params->phSignalEvent) == nullptr) {
       ze_context_handle_t context =
         collector->GetCommandListContext(*(params->phCommandList));
-      CreateEvent(context, instance->event_pool, instance->event);
+      instance->event = collector->event_cache_.GetEvent(
+          context, &instance->event_generation);
+      instance->cached_event = true;
       *(params->phSignalEvent) = instance->event;
     } else {
-      instance->event_pool = nullptr;
       instance->event = *(params->phSignalEvent);
+      instance->cached_event = false;
+      instance->event_generation = 0;
     }
 
     *instance_data = static_cast<void*>(instance);
@@ -643,7 +811,7 @@ class ZeKernelCollector {
     }
 
     ZeKernelInstance* instance = new ZeKernelInstance;
-    instance->name = "zeCommandListAppendMemoryCopy";
+    instance->name_id = collector->memory_copy_name_id_;
     instance->bytes_transferred = *(params->psize);
     instance->simd_width = 0;
     instance->append_time = collector->GetTimestamp();
@@ -652,11 +820,14 @@ class ZeKernelCollector {
     if (*(params->phSignalEvent) == nullptr) {
       ze_context_handle_t context =
         collector->GetCommandListContext(*(params->phCommandList));
-      CreateEvent(context, instance->event_pool, instance->event);
+      instance->event = collector->event_cache_.GetEvent(
+          context, &instance->event_generation);
+      instance->cached_event = true;
       *(params->phSignalEvent) = instance->event;
     } else {
-      instance->event_pool = nullptr;
       instance->event = *(params->phSignalEvent);
+      instance->cached_event = false;
+      instance->event_generation = 0;
     }
 
     *instance_data = static_cast<void*>(instance);
@@ -672,18 +843,17 @@ class ZeKernelCollector {
       return;
     }
 
+    ZeKernelCollector* collector =
+      reinterpret_cast<ZeKernelCollector*>(global_data);
+    PTI_ASSERT(collector != nullptr);
+
     if (result != ZE_RESULT_SUCCESS) {
-      if (instance->event_pool != nullptr) {
-        ze_result_t status = ZE_RESULT_SUCCESS;
-        status = zeEventDestroy(instance->event);
-        PTI_ASSERT(status == ZE_RESULT_SUCCESS);
-        status = zeEventPoolDestroy(instance->event_pool);
-        PTI_ASSERT(status == ZE_RESULT_SUCCESS);
+      if (instance->cached_event) {
+        bool released = collector->event_cache_.ReleaseEvent(
+            instance->event, instance->event_generation);
+        PTI_ASSERT(released);
       }
     } else {
-      ZeKernelCollector* collector =
-        reinterpret_cast<ZeKernelCollector*>(global_data);
-      PTI_ASSERT(collector != nullptr);
       collector->AddKernelInstance(command_list, *instance);
     }
 
@@ -800,27 +970,42 @@ class ZeKernelCollector {
   zel_tracer_handle_t tracer_ = nullptr;
 
   uint64_t timer_frequency_ = 0;
+  utils::TickConverter tick_converter_;
   ZeKernelTimePoint base_time_;
 
   OnZeKernelFinishCallback callback_ = nullptr;
   void* callback_data_ = nullptr;
 
-  ZeKernelTimePoint cpu_timestamp_;
-  uint64_t gpu_timestamp_ = 0;
+  uint32_t memory_copy_name_id_ = 0;
+
+  utils::ClockCorrelator* clock_correlator_ = nullptr;
 
   std::mutex lock_;
-  ZeKernelInfoMap kernel_info_map_;
+  utils::KernelInfoAccumulator<uint32_t, ZeKernelInfo>
+    kernel_info_accumulator_;
+  mutable ZeKernelInfoMap kernel_info_map_;
   ZeKernelIntervalList kernel_interval_list_;
   ZeKernelNameMap kernel_name_map_;
-  std::list<ZeKernelInstance> kernel_instance_list_;
+  ZeKernelInstanceList kernel_instance_list_;
+  ZeKernelInstanceMap kernel_instance_map_;
   ZeCommandListMap command_list_map_;
 
+  utils::ZeEventCache event_cache_;
+
+  std::thread reaper_thread_;
+  std::mutex reaper_lock_;
+  std::condition_variable reaper_condition_;
+  bool reaper_active_ = false;
+  uint32_t reaper_period_ = 0; // ms
+
   static const uint32_t kKernelLength = 10;
   static const uint32_t kCallsLength = 12;
   static const uint32_t kSimdLength = 5;
   static const uint32_t kTransferredLength = 20;
   static const uint32_t kTimeLength = 20;
   static const uint32_t kPercentLength = 10;
+
+  static const size_t kReaperBatchSize = 256;
 };
 
 #endif // PTI_SAMPLES_ZE_HOT_KERNELS_ZE_KERNEL_COLLECTOR_H_
\ No newline at end of file
@@ -5,10 +5,15 @@
 // =============================================================
 
 
+#include <algorithm>
+#include <deque>
 #include <iomanip>
 #include <iostream>
+#include <mutex>
 #include <set>
+#include <thread>
 
+#include "interval_join.h"
 #include "ze_kernel_collector.h"
 #include "ze_metric_collector.h"
 
@@ -35,16 +40,40 @@ struct Kernel {
 
 using KernelMap = std::map<std::string, Kernel>;
 
+struct MetricSample {
+  uint64_t timestamp;
+  float eu_active;
+  float eu_stall;
+};
+
 const uint32_t kKernelLength = 10;
 const uint32_t kCallsLength = 12;
 const uint32_t kTimeLength = 20;
 const uint32_t kPercentLength = 16;
 
+// Samples kept in streaming mode to attribute them to kernels
+// that are not completed yet (about 100 seconds of 100 us sampling)
+const size_t kMaxSampleCount = 1024 * 1024;
+
+const char* kRawDumpFileName = "zet_metrics.raw";
+
 static ZeKernelCollector* kernel_collector = nullptr;
 static ZeMetricCollector* metric_collector = nullptr;
 
 static std::chrono::steady_clock::time_point start;
 
+static int gpu_timestamp_id = -1;
+static int eu_active_id = -1;
+static int eu_stall_id = -1;
+static uint32_t report_size = 0;
+
+// Streaming mode data, updated from metric collector worker thread
+static std::mutex stream_lock;
+static std::deque<MetricSample> sample_list;
+static ZeKernelIntervalList pending_interval_list;
+static KernelMap stream_kernel_map;
+static uint64_t evicted_sample_count = 0;
+
 // External Tool Interface ////////////////////////////////////////////////////
 
 extern "C"
@@ -53,7 +82,14 @@ __declspec(dllexport)
 #endif
 void Usage() {
   std::cout <<
-    "Usage: ./ze_metric_streamer[.exe] <application> <args>" <<
+    "Usage: ./ze_metric_streamer[.exe] [options] <application> <args>" <<
+    std::endl;
+  std::cout << "Options:" << std::endl;
+  std::cout <<
+    "--streaming [-s]                Process metrics in bounded memory" <<
+    std::endl;
+  std::cout <<
+    "--raw-dump                      Dump raw reports in streaming mode" <<
     std::endl;
 }
 
@@ -62,7 +98,20 @@ extern "C"
 __declspec(dllexport)
 #endif
 int ParseArgs(int argc, char* argv[]) {
-  return 1;
+  int app_index = 1;
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "--streaming") == 0 ||
+        strcmp(argv[i], "-s") == 0) {
+      utils::SetEnv("ZEMS_Streaming=1");
+      ++app_index;
+    } else if (strcmp(argv[i], "--raw-dump") == 0) {
+      utils::SetEnv("ZEMS_RawDump=1");
+      ++app_index;
+    } else {
+      break;
+    }
+  }
+  return app_index;
 }
 
 extern "C"
@@ -76,6 +125,35 @@ void SetToolEnv() {
 
 // Internal Tool Functionality ////////////////////////////////////////////////
 
+static void AddKernelMetrics(
+    KernelMap& kernel_map, const ZeKernelInterval& kernel,
+    uint32_t sample_count, float eu_active, float eu_stall) {
+  const std::string& name = utils::GetInternedString(kernel.name_id);
+
+  if (sample_count > 0) {
+    eu_active /= sample_count;
+    eu_stall /= sample_count;
+  } else {
+    std::cerr << "[WARNING] No samples found for a kernel instance of " <<
+      name << ", results may be inaccurate" << std::endl;
+  }
+
+  if (kernel_map.count(name) == 0) {
+    kernel_map[name] =
+      {kernel.end - kernel.start, 1, eu_active, eu_stall};
+  } else {
+    Kernel& kernel_info = kernel_map[name];
+    kernel_info.total_time += (kernel.end - kernel.start);
+    kernel_info.eu_active =
+      (kernel_info.eu_active * kernel_info.call_count + eu_active) /
+      (kernel_info.call_count + 1);
+    kernel_info.eu_stall =
+      (kernel_info.eu_stall * kernel_info.call_count + eu_stall) /
+      (kernel_info.call_count + 1);
+    kernel_info.call_count += 1;
+  }
+}
+
 static KernelMap GetKernelMap() {
   PTI_ASSERT(kernel_collector != nullptr);
   PTI_ASSERT(metric_collector != nullptr);
@@ -94,72 +172,137 @@ static KernelMap GetKernelMap() {
 
   KernelMap kernel_map;
 
-  int gpu_timestamp_id = metric_collector->GetMetricId("QueryBeginTime");
-  PTI_ASSERT(gpu_timestamp_id >= 0);
-  int eu_active_id = metric_collector->GetMetricId("EuActive");
-  PTI_ASSERT(eu_active_id >= 0);
-  int eu_stall_id = metric_collector->GetMetricId("EuStall");
-  PTI_ASSERT(eu_stall_id >= 0);
-
-  uint32_t report_size = metric_collector->GetReportSize();
-  PTI_ASSERT(report_size > 0);
+  size_t report_count = report_list.size() / report_size;
+
+  // Timestamps and prefix sums of metric values, so any kernel gets its
+  // samples aggregated in constant time
+  std::vector<uint64_t> timestamp_list(report_count);
+  std::vector<double> eu_active_sum(report_count + 1, 0.0);
+  std::vector<double> eu_stall_sum(report_count + 1, 0.0);
+  for (size_t i = 0; i < report_count; ++i) {
+    const zet_typed_value_t* report = report_list.data() + i * report_size;
+    PTI_ASSERT(report[gpu_timestamp_id].type == ZET_VALUE_TYPE_UINT64);
+    timestamp_list[i] = report[gpu_timestamp_id].value.ui64;
+    PTI_ASSERT(report[eu_active_id].type == ZET_VALUE_TYPE_FLOAT32);
+    eu_active_sum[i + 1] = eu_active_sum[i] + report[eu_active_id].value.fp32;
+    PTI_ASSERT(report[eu_stall_id].type == ZET_VALUE_TYPE_FLOAT32);
+    eu_stall_sum[i + 1] = eu_stall_sum[i] + report[eu_stall_id].value.fp32;
+  }
 
+  std::vector<utils::TimeInterval> interval_list;
+  interval_list.reserve(kernel_interval_list.size());
   for (auto& kernel : kernel_interval_list) {
-    uint32_t sample_count = 0;
-    float eu_active = 0.0f, eu_stall = 0.0f;
+    interval_list.push_back({kernel.start, kernel.end});
+  }
 
-    const zet_typed_value_t* report = report_list.data();
-    while (report < report_list.data() + report_list.size()) {
-      PTI_ASSERT(report[gpu_timestamp_id].type == ZET_VALUE_TYPE_UINT64);
-      uint64_t report_timestamp = report[gpu_timestamp_id].value.ui64;
+  std::vector<utils::SampleRange> range_list = utils::JoinIntervals(
+      timestamp_list, interval_list,
+      std::max(std::thread::hardware_concurrency(), 1u));
+  PTI_ASSERT(range_list.size() == kernel_interval_list.size());
+
+  for (size_t i = 0; i < kernel_interval_list.size(); ++i) {
+    const utils::SampleRange& range = range_list[i];
+    AddKernelMetrics(
+        kernel_map, kernel_interval_list[i], range.last - range.first,
+        eu_active_sum[range.last] - eu_active_sum[range.first],
+        eu_stall_sum[range.last] - eu_stall_sum[range.first]);
+  }
 
-      if (report_timestamp >= kernel.start && report_timestamp <= kernel.end) {
-        PTI_ASSERT(report[eu_active_id].type == ZET_VALUE_TYPE_FLOAT32);
-        eu_active += report[eu_active_id].value.fp32;
-        PTI_ASSERT(report[eu_stall_id].type == ZET_VALUE_TYPE_FLOAT32);
-        eu_stall += report[eu_stall_id].value.fp32;
-        ++sample_count;
-      }
+  return kernel_map;
+}
 
-      if (report_timestamp > kernel.end) {
-        break;
-      }
+// Attributes the samples to the kernels whose intervals are fully covered
+// by the samples received so far (or to all of them in case of flush)
+static void ProcessKernelIntervals(bool flush) {
+  PTI_ASSERT(kernel_collector != nullptr);
 
-      report += report_size;
-    }
+  ZeKernelIntervalList kernel_interval_list =
+    kernel_collector->TakeKernelIntervalList();
+  pending_interval_list.insert(
+      pending_interval_list.end(),
+      kernel_interval_list.begin(), kernel_interval_list.end());
 
-    if (sample_count > 0) {
-      eu_active /= sample_count;
-      eu_stall /= sample_count;
-    } else {
-      std::cerr << "[WARNING] No samples found for a kernel instance of " <<
-        kernel.name << ", results may be inaccurate" << std::endl;
+  uint64_t last_timestamp =
+    sample_list.empty() ? 0 : sample_list.back().timestamp;
+
+  ZeKernelIntervalList remaining_list;
+  for (auto& kernel : pending_interval_list) {
+    if (!flush && kernel.end > last_timestamp) {
+      remaining_list.push_back(kernel);
+      continue;
     }
 
-    if (kernel_map.count(kernel.name) == 0) {
-      kernel_map[kernel.name] =
-        {kernel.end - kernel.start, 1, eu_active, eu_stall};
-    } else {
-      Kernel& kernel_info = kernel_map[kernel.name];
-      kernel_info.total_time += (kernel.end - kernel.start);
-      kernel_info.eu_active =
-        (kernel_info.eu_active * kernel_info.call_count + eu_active) /
-        (kernel_info.call_count + 1);
-      kernel_info.eu_stall =
-        (kernel_info.eu_stall * kernel_info.call_count + eu_stall) /
-        (kernel_info.call_count + 1);
-      kernel_info.call_count += 1;
+    uint32_t sample_count = 0;
+    float eu_active = 0.0f, eu_stall = 0.0f;
+
+    auto sample = std::lower_bound(
+        sample_list.begin(), sample_list.end(), kernel.start,
+        [](const MetricSample& sample, uint64_t timestamp) {
+          return sample.timestamp < timestamp;
+        });
+    for (; sample != sample_list.end() &&
+           sample->timestamp <= kernel.end; ++sample) {
+      eu_active += sample->eu_active;
+      eu_stall += sample->eu_stall;
+      ++sample_count;
     }
+
+    AddKernelMetrics(
+        stream_kernel_map, kernel, sample_count, eu_active, eu_stall);
   }
+  pending_interval_list.swap(remaining_list);
+}
 
-  return kernel_map;
+static void OnMetricReports(
+    void* data, const zet_typed_value_t* report_list, uint32_t report_count) {
+  PTI_ASSERT(report_list != nullptr);
+  PTI_ASSERT(report_size > 0);
+  const std::lock_guard<std::mutex> lock(stream_lock);
+
+  for (uint32_t i = 0; i < report_count; ++i) {
+    const zet_typed_value_t* report = report_list + i * report_size;
+    PTI_ASSERT(report[gpu_timestamp_id].type == ZET_VALUE_TYPE_UINT64);
+    PTI_ASSERT(report[eu_active_id].type == ZET_VALUE_TYPE_FLOAT32);
+    PTI_ASSERT(report[eu_stall_id].type == ZET_VALUE_TYPE_FLOAT32);
+    sample_list.push_back({
+        report[gpu_timestamp_id].value.ui64,
+        report[eu_active_id].value.fp32,
+        report[eu_stall_id].value.fp32});
+  }
+
+  ProcessKernelIntervals(false);
+
+  while (sample_list.size() > kMaxSampleCount) {
+    sample_list.pop_front();
+    ++evicted_sample_count;
+  }
+}
+
+static KernelMap GetStreamKernelMap() {
+  const std::lock_guard<std::mutex> lock(stream_lock);
+  ProcessKernelIntervals(true);
+
+  if (evicted_sample_count > 0) {
+    std::cerr << "[WARNING] " << evicted_sample_count <<
+      " samples were evicted before attribution, results may be inaccurate" <<
+      std::endl;
+  }
+  if (metric_collector->GetStallCount() > 0) {
+    std::cerr << "[WARNING] Metric collection was stalled " <<
+      metric_collector->GetStallCount() << " times, results may be inaccurate" <<
+      std::endl;
+  }
+
+  return stream_kernel_map;
 }
 
 static void PrintResults() {
   std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
   std::chrono::duration<uint64_t, std::nano> time = end - start;
 
-  KernelMap kernel_map = GetKernelMap();
+  KernelMap kernel_map =
+    utils::GetEnv("ZEMS_Streaming") == "1" ?
+      GetStreamKernelMap() : GetKernelMap();
   if (kernel_map.size() == 0) {
     return;
   }
@@ -246,8 +389,17 @@ void EnableProfiling() {
     return;
   }
 
-  metric_collector =
-    ZeMetricCollector::Create(driver, device, "ComputeBasic");
+  OnZeMetricReportsCallback callback = nullptr;
+  const char* raw_file_name = nullptr;
+  if (utils::GetEnv("ZEMS_Streaming") == "1") {
+    callback = OnMetricReports;
+    if (utils::GetEnv("ZEMS_RawDump") == "1") {
+      raw_file_name = kRawDumpFileName;
+    }
+  }
+
+  metric_collector = ZeMetricCollector::Create(
+      driver, device, "ComputeBasic", callback, nullptr, raw_file_name);
   if (metric_collector == nullptr) {
     kernel_collector->DisableTracing();
     delete kernel_collector;
@@ -255,6 +407,16 @@ void EnableProfiling() {
     return;
   }
 
+  gpu_timestamp_id = metric_collector->GetMetricId("QueryBeginTime");
+  PTI_ASSERT(gpu_timestamp_id >= 0);
+  eu_active_id = metric_collector->GetMetricId("EuActive");
+  PTI_ASSERT(eu_active_id >= 0);
+  eu_stall_id = metric_collector->GetMetricId("EuStall");
+  PTI_ASSERT(eu_stall_id >= 0);
+
+  report_size = metric_collector->GetReportSize();
+  PTI_ASSERT(report_size > 0);
+
   start = std::chrono::steady_clock::now();
 }
 
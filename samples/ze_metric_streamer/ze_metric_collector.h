@@ -9,6 +9,7 @@
 
 #include <algorithm>
 #include <atomic>
+#include <fstream>
 #include <map>
 #include <mutex>
 #include <string>
@@ -17,6 +18,7 @@
 
 #include <level_zero/layers/zel_tracing_api.h>
 
+#include "buffer_ring.h"
 #include "ze_utils.h"
 
 enum CollectorState {
@@ -25,12 +27,26 @@ enum CollectorState {
   COLLECTOR_STATE_DISABLED = 2
 };
 
+// Receives calculated values for a chunk of reports, report_count
+// reports of GetReportSize() values each
+typedef void (*OnZeMetricReportsCallback)(
+    void* data, const zet_typed_value_t* report_list, uint32_t report_count);
+
+// Collects time-based metric reports on a background thread. By default
+// raw reports are accumulated and calculated at the end of the run.
+// In streaming mode (callback is specified) raw chunks go through a fixed
+// ring of buffers to a worker thread, that calculates them incrementally,
+// passes the values to the callback and optionally dumps raw data to file,
+// so the memory footprint does not depend on the run length
 class ZeMetricCollector {
  public: // Interface
   static ZeMetricCollector* Create(
       ze_driver_handle_t driver,
       ze_device_handle_t device,
-      const char* group_name) {
+      const char* group_name,
+      OnZeMetricReportsCallback callback = nullptr,
+      void* callback_data = nullptr,
+      const char* raw_file_name = nullptr) {
     PTI_ASSERT(driver != nullptr);
     PTI_ASSERT(device != nullptr);
     PTI_ASSERT(group_name != nullptr);
@@ -47,9 +63,16 @@ class ZeMetricCollector {
     PTI_ASSERT(context != nullptr);
 
     ZeMetricCollector* collector = new ZeMetricCollector(
-        device, context, group);
+        device, context, group, callback, callback_data);
     PTI_ASSERT(collector != nullptr);
 
+    if (raw_file_name != nullptr) {
+      PTI_ASSERT(callback != nullptr);
+      collector->raw_stream_.open(
+          raw_file_name, std::ios::out | std::ios::binary);
+      PTI_ASSERT(collector->raw_stream_.is_open());
+    }
+
     ze_result_t status = ZE_RESULT_SUCCESS;
     zel_tracer_desc_t tracer_desc = {
         ZEL_STRUCTURE_TYPE_TRACER_EXP_DESC, nullptr, collector};
@@ -70,8 +93,13 @@ class ZeMetricCollector {
   ~ZeMetricCollector() {
     ze_result_t status = ZE_RESULT_SUCCESS;
     PTI_ASSERT(collector_thread_ == nullptr);
+    PTI_ASSERT(worker_thread_ == nullptr);
     PTI_ASSERT(collector_state_ == COLLECTOR_STATE_IDLE);
 
+    if (raw_stream_.is_open()) {
+      raw_stream_.close();
+    }
+
     if (tracer_ != nullptr) {
       status = zelTracerDestroy(tracer_);
       PTI_ASSERT(status == ZE_RESULT_SUCCESS);
@@ -88,33 +116,20 @@ class ZeMetricCollector {
     PTI_ASSERT(status == ZE_RESULT_SUCCESS);
   }
 
+  // Not available in streaming mode
   std::vector<zet_typed_value_t> GetReportList() const {
-    ze_result_t status = ZE_RESULT_SUCCESS;
+    PTI_ASSERT(callback_ == nullptr);
     std::vector<zet_typed_value_t> report_list;
-    PTI_ASSERT(metric_group_ != nullptr);
-
-    if (metric_storage_.size() == 0) {
-      return report_list;
-    }
-
-    uint32_t value_count = 0;
-    status = zetMetricGroupCalculateMetricValues(
-        metric_group_, ZET_METRIC_GROUP_CALCULATION_TYPE_METRIC_VALUES,
-        metric_storage_.size(), metric_storage_.data(), &value_count, nullptr);
-    PTI_ASSERT(status == ZE_RESULT_SUCCESS);
-    PTI_ASSERT(value_count > 0);
-
-    report_list.resize(value_count);
-    status = zetMetricGroupCalculateMetricValues(
-        metric_group_, ZET_METRIC_GROUP_CALCULATION_TYPE_METRIC_VALUES,
-        metric_storage_.size(), metric_storage_.data(),
-        &value_count, report_list.data());
-    PTI_ASSERT(status == ZE_RESULT_SUCCESS);
-    report_list.resize(value_count);
-
+    CalculateMetrics(metric_storage_, report_list);
     return report_list;
   }
 
+  // Number of times the collector thread waited for a free buffer
+  // in streaming mode
+  uint64_t GetStallCount() const {
+    return buffer_ring_.GetStallCount();
+  }
+
   int GetMetricId(const char* metric_name) const {
     PTI_ASSERT(metric_name != nullptr);
     PTI_ASSERT(metric_group_ != nullptr);
@@ -135,8 +150,11 @@ class ZeMetricCollector {
  private: // Implementation
   ZeMetricCollector(
       ze_device_handle_t device, ze_context_handle_t context,
-      zet_metric_group_handle_t group)
-      : device_(device), context_(context), metric_group_(group) {
+      zet_metric_group_handle_t group,
+      OnZeMetricReportsCallback callback, void* callback_data)
+      : device_(device), context_(context), metric_group_(group),
+        callback_(callback), callback_data_(callback_data),
+        buffer_ring_(kBufferCount) {
     PTI_ASSERT(device_ != nullptr);
     PTI_ASSERT(context_ != nullptr);
     PTI_ASSERT(metric_group_ != nullptr);
@@ -168,6 +186,13 @@ class ZeMetricCollector {
       PTI_ASSERT(collector_thread_ == nullptr);
       PTI_ASSERT(collector_state_ == COLLECTOR_STATE_IDLE);
 
+      if (callback_ != nullptr) {
+        PTI_ASSERT(worker_thread_ == nullptr);
+        buffer_ring_.Open();
+        worker_thread_ = new std::thread(Calculate, this);
+        PTI_ASSERT(worker_thread_ != nullptr);
+      }
+
       collector_state_.store(COLLECTOR_STATE_IDLE, std::memory_order_release);
       collector_thread_ = new std::thread(Collect, this);
       PTI_ASSERT(collector_thread_ != nullptr);
@@ -193,11 +218,76 @@ class ZeMetricCollector {
       collector_thread_->join();
       delete collector_thread_;
       collector_thread_ = nullptr;
+
+      if (worker_thread_ != nullptr) {
+        buffer_ring_.Close();
+        worker_thread_->join();
+        delete worker_thread_;
+        worker_thread_ = nullptr;
+      }
+
       collector_state_.store(
           COLLECTOR_STATE_IDLE, std::memory_order_release);
     }
   }
 
+  void CalculateMetrics(
+      const std::vector<uint8_t>& storage,
+      std::vector<zet_typed_value_t>& report_list) const {
+    ze_result_t status = ZE_RESULT_SUCCESS;
+    PTI_ASSERT(metric_group_ != nullptr);
+
+    report_list.clear();
+    if (storage.size() == 0) {
+      return;
+    }
+
+    uint32_t value_count = 0;
+    status = zetMetricGroupCalculateMetricValues(
+        metric_group_, ZET_METRIC_GROUP_CALCULATION_TYPE_METRIC_VALUES,
+        storage.size(), storage.data(), &value_count, nullptr);
+    PTI_ASSERT(status == ZE_RESULT_SUCCESS);
+    PTI_ASSERT(value_count > 0);
+
+    report_list.resize(value_count);
+    status = zetMetricGroupCalculateMetricValues(
+        metric_group_, ZET_METRIC_GROUP_CALCULATION_TYPE_METRIC_VALUES,
+        storage.size(), storage.data(),
+        &value_count, report_list.data());
+    PTI_ASSERT(status == ZE_RESULT_SUCCESS);
+    report_list.resize(value_count);
+  }
+
+  // Worker thread for streaming mode, buffer vectors keep their capacity
+  // between the chunks, so steady state processing does not allocate
+  static void Calculate(ZeMetricCollector* collector) {
+    PTI_ASSERT(collector != nullptr);
+    PTI_ASSERT(collector->callback_ != nullptr);
+
+    uint32_t report_size = collector->GetReportSize();
+    PTI_ASSERT(report_size > 0);
+
+    std::vector<zet_typed_value_t> report_list;
+    std::vector<uint8_t>* buffer = nullptr;
+    while ((buffer = collector->buffer_ring_.Pop()) != nullptr) {
+      PTI_ASSERT(buffer->size() > 0);
+      if (collector->raw_stream_.is_open()) {
+        collector->raw_stream_.write(
+            reinterpret_cast<const char*>(buffer->data()), buffer->size());
+      }
+
+      collector->CalculateMetrics(*buffer, report_list);
+      collector->buffer_ring_.Release(buffer);
+
+      if (report_list.size() > 0) {
+        PTI_ASSERT(report_list.size() % report_size == 0);
+        collector->callback_(
+            collector->callback_data_, report_list.data(),
+            report_list.size() / report_size);
+      }
+    }
+  }
+
   void AppendMetrics(const std::vector<uint8_t>& storage) {
     PTI_ASSERT(storage.size() > 0);
 
@@ -259,7 +349,18 @@ class ZeMetricCollector {
           metric_streamer, UINT32_MAX, &data_size, nullptr);
       PTI_ASSERT(status == ZE_RESULT_SUCCESS);
 
-      if (data_size > 0) {
+      if (data_size > 0 && collector->callback_ != nullptr) {
+        std::vector<uint8_t>* buffer = collector->buffer_ring_.Acquire();
+        PTI_ASSERT(buffer != nullptr);
+        buffer->resize(data_size);
+        status = zetMetricStreamerReadData(
+            metric_streamer, UINT32_MAX, &data_size, buffer->data());
+        PTI_ASSERT(status == ZE_RESULT_SUCCESS);
+        buffer->resize(data_size);
+        PTI_ASSERT(buffer->size() > 0);
+
+        collector->buffer_ring_.Submit(buffer);
+      } else if (data_size > 0) {
         storage.resize(data_size);
         status = zetMetricStreamerReadData(
             metric_streamer, UINT32_MAX, &data_size, storage.data());
@@ -318,6 +419,14 @@ class ZeMetricCollector {
   zet_metric_group_handle_t metric_group_ = nullptr;
   std::vector<uint8_t> metric_storage_;
 
+  OnZeMetricReportsCallback callback_ = nullptr;
+  void* callback_data_ = nullptr;
+  std::thread* worker_thread_ = nullptr;
+  utils::BufferRing buffer_ring_;
+  std::ofstream raw_stream_;
+
+  static const size_t kBufferCount = 4;
+
   std::mutex lock_;
   int queue_count_ = 0;
 };
@@ -38,6 +38,9 @@ void Usage() {
   std::cout <<
     "--chrome-call-logging           Dump host API calls to JSON file" <<
     std::endl;
+  std::cout <<
+    "--binary-trace                  Store Chrome timeline in binary format" <<
+    std::endl;
 }
 
 extern "C"
@@ -69,6 +72,9 @@ int ParseArgs(int argc, char* argv[]) {
     } else if (strcmp(argv[i], "--chrome-call-logging") == 0) {
       utils::SetEnv("ZET_ChromeCallLogging=1");
       ++app_index;
+    } else if (strcmp(argv[i], "--binary-trace") == 0) {
+      utils::SetEnv("ZET_BinaryTrace=1");
+      ++app_index;
     } else {
       break;
     }
@@ -118,6 +124,11 @@ static unsigned ReadArgs() {
     options |= (1 << ZET_CHROME_CALL_LOGGING);
   }
 
+  value = utils::GetEnv("ZET_BinaryTrace");
+  if (!value.empty() && value == "1") {
+    options |= (1 << ZET_BINARY_TRACE);
+  }
+
   return options;
 }
 
@@ -9,13 +9,13 @@
 
 #include <chrono>
 #include <cstdint>
-#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
 #include <string>
 
 #include "ze_api_collector.h"
+#include "trace_writer.h"
 #include "ze_kernel_collector.h"
 #include "utils.h"
 
@@ -25,8 +25,10 @@
 #define ZET_DEVICE_TIMELINE        3
 #define ZET_CHROME_DEVICE_TIMELINE 4
 #define ZET_CHROME_CALL_LOGGING    5
+#define ZET_BINARY_TRACE           6
 
 const char* kChromeTraceFileName = "zet_trace.json";
+const char* kBinaryTraceFileName = "zet_trace.bin";
 
 class ZeTracer {
  public:
@@ -112,7 +114,7 @@ class ZeTracer {
       delete kernel_collector_;
     }
 
-    if (chrome_trace_.is_open()) {
+    if (chrome_trace_ != nullptr) {
       CloseTraceFile();
     }
   }
@@ -209,9 +211,10 @@ class ZeTracer {
   }
 
   static void DeviceTimelineCallback(
-      void* data, void* queue, const std::string& name,
+      void* data, void* queue, uint32_t name_id,
       uint64_t appended, uint64_t submitted,
       uint64_t started, uint64_t ended) {
+    const std::string& name = utils::GetInternedString(name_id);
     std::stringstream stream;
     stream << "Device Timeline (queue: " << queue <<
       "): " << name << " [ns] = " <<
@@ -222,45 +225,49 @@ class ZeTracer {
     std::cerr << stream.str();
   }
 
+  const char* GetTraceFileName() {
+    return CheckOption(ZET_BINARY_TRACE) ?
+      kBinaryTraceFileName : kChromeTraceFileName;
+  }
+
   void OpenTraceFile() {
-    chrome_trace_.open(kChromeTraceFileName);
-    PTI_ASSERT(chrome_trace_.is_open());
-    chrome_trace_ << "[" << std::endl;
-    chrome_trace_ <<
-      "{\"ph\":\"M\", \"name\":\"process_name\", \"pid\":" <<
-      utils::GetPid() << ", \"tid\":0, \"args\":{\"name\":\"" <<
-      utils::GetExecutableName() << "\"}}," << std::endl;
+    chrome_trace_ = new TraceWriter(
+        GetTraceFileName(),
+        CheckOption(ZET_BINARY_TRACE) ?
+          TRACE_FORMAT_BINARY : TRACE_FORMAT_JSON);
+    PTI_ASSERT(chrome_trace_ != nullptr);
   }
 
   void CloseTraceFile() {
-    PTI_ASSERT(chrome_trace_.is_open());
-    chrome_trace_.close();
+    PTI_ASSERT(chrome_trace_ != nullptr);
+    uint64_t dropped_count = chrome_trace_->GetDroppedCount();
+    delete chrome_trace_;
+    chrome_trace_ = nullptr;
+
+    if (dropped_count > 0) {
+      std::cerr << "[WARNING] " << dropped_count <<
+        " timeline records were dropped" << std::endl;
+    }
     std::cerr << "Timeline was stored to " <<
-      kChromeTraceFileName << std::endl;
+      GetTraceFileName() << std::endl;
   }
 
   static void ChromeTimelineCallback(
-      void* data, void* queue, const std::string& name,
+      void* data, void* queue, uint32_t name_id,
       uint64_t appended, uint64_t submitted,
       uint64_t started, uint64_t ended) {
     ZeTracer* tracer = reinterpret_cast<ZeTracer*>(data);
     PTI_ASSERT(tracer != nullptr);
-    std::stringstream stream;
-    stream << "{\"ph\":\"X\", \"pid\":" << utils::GetPid() <<
-      ", \"tid\":" << reinterpret_cast<uint64_t>(queue) <<
-      ", \"name\":\"" << name <<
-      "\", \"ts\": " << started / NSEC_IN_USEC <<
-      ", \"dur\":" << (ended - started) / NSEC_IN_USEC <<
-      "}," << std::endl;
-    tracer->chrome_trace_ << stream.str();
+    PTI_ASSERT(tracer->chrome_trace_ != nullptr);
+    tracer->chrome_trace_->AddDeviceRecord(name_id, queue, started, ended);
   }
 
   static void DeviceAndChromeTimelineCallback(
-      void* data, void* queue, const std::string& name,
+      void* data, void* queue, uint32_t name_id,
       uint64_t appended, uint64_t submitted,
       uint64_t started, uint64_t ended) {
-    DeviceTimelineCallback(data, queue, name, appended, submitted, started, ended);
-    ChromeTimelineCallback(data, queue, name, appended, submitted, started, ended);
+    DeviceTimelineCallback(data, queue, name_id, appended, submitted, started, ended);
+    ChromeTimelineCallback(data, queue, name_id, appended, submitted, started, ended);
   }
 
   static void ChromeLoggingCallback(
@@ -268,14 +275,8 @@ class ZeTracer {
       uint64_t started, uint64_t ended) {
     ZeTracer* tracer = reinterpret_cast<ZeTracer*>(data);
     PTI_ASSERT(tracer != nullptr);
-    std::stringstream stream;
-    stream << "{\"ph\":\"X\", \"pid\":" <<
-      utils::GetPid() << ", \"tid\":" << utils::GetTid() <<
-      ", \"name\":\"" << name <<
-      "\", \"ts\": " << started / NSEC_IN_USEC <<
-      ", \"dur\":" << (ended - started) / NSEC_IN_USEC <<
-      "}," << std::endl;
-    tracer->chrome_trace_ << stream.str();
+    PTI_ASSERT(tracer->chrome_trace_ != nullptr);
+    tracer->chrome_trace_->AddHostRecord(name, started, ended);
   }
 
  private:
@@ -287,7 +288,7 @@ class ZeTracer {
   ZeApiCollector* api_collector_ = nullptr;
   ZeKernelCollector* kernel_collector_ = nullptr;
 
-  std::ofstream chrome_trace_;
+  TraceWriter* chrome_trace_ = nullptr;
 };
 
 #endif // PTI_SAMPLES_ZE_TRACER_ZE_TRACER_H_
\ No newline at end of file
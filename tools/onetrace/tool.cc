@@ -37,6 +37,15 @@ void Usage() {
   std::cout <<
     "--chrome-call-logging           Dump host API calls to JSON file" <<
     std::endl;
+  std::cout <<
+    "--binary-trace                  Store Chrome timeline in binary format" <<
+    std::endl;
+  std::cout <<
+    "--ze-api-filter <list>          Trace only listed L0 API functions" <<
+    std::endl;
+  std::cout <<
+    "                                (comma-separated, -name to exclude)" <<
+    std::endl;
 }
 
 extern "C"
@@ -68,6 +77,17 @@ int ParseArgs(int argc, char* argv[]) {
     } else if (strcmp(argv[i], "--chrome-call-logging") == 0) {
       utils::SetEnv("ONETRACE_ChromeCallLogging=1");
       ++app_index;
+    } else if (strcmp(argv[i], "--binary-trace") == 0) {
+      utils::SetEnv("ONETRACE_BinaryTrace=1");
+      ++app_index;
+    } else if (strcmp(argv[i], "--ze-api-filter") == 0) {
+      ++i;
+      if (i >= argc) {
+        return argc; // Treated by loader as invalid command line
+      }
+      std::string value = std::string("ONETRACE_ZeApiFilter=") + argv[i];
+      utils::SetEnv(value.c_str());
+      app_index += 2;
     } else {
       break;
     }
@@ -117,6 +137,11 @@ static unsigned ReadArgs() {
     options |= (1 << ONETRACE_CHROME_CALL_LOGGING);
   }
 
+  value = utils::GetEnv("ONETRACE_BinaryTrace");
+  if (!value.empty() && value == "1") {
+    options |= (1 << ONETRACE_BINARY_TRACE);
+  }
+
   return options;
 }
 
@@ -126,12 +151,13 @@ void EnableProfiling() {
   PTI_ASSERT(status == ZE_RESULT_SUCCESS);
 
   unsigned options = ReadArgs();
-  if (options == 0) {
+  if ((options & ~(1 << ONETRACE_BINARY_TRACE)) == 0) {
     options |= (1 << ONETRACE_HOST_TIMING);
     options |= (1 << ONETRACE_DEVICE_TIMING);
   }
 
-  tracer = UnifiedTracer::Create(options);
+  tracer = UnifiedTracer::Create(
+      options, utils::GetEnv("ONETRACE_ZeApiFilter"));
 }
 
 void DisableProfiling() {
@@ -0,0 +1,213 @@
+//==============================================================
+// Copyright (C) Intel Corporation
+//
+// SPDX-License-Identifier: MIT
+// =============================================================
+
+#include <string.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "trace_format.h"
+
+struct SummaryInfo {
+  uint64_t total_time;
+  uint64_t min_time;
+  uint64_t max_time;
+  uint64_t call_count;
+};
+
+// Key is a pair of track type and name identifier
+using SummaryInfoMap = std::map<std::pair<uint32_t, uint32_t>, SummaryInfo>;
+
+const int kNameLength = 8;
+const int kCallsLength = 12;
+const int kTimeLength = 20;
+const int kPercentLength = 10;
+
+static void Usage() {
+  std::cout <<
+    "Usage: ./onetrace_convert [options] <input_file> [<output_file>]" <<
+    std::endl;
+  std::cout << "Options:" << std::endl;
+  std::cout <<
+    "--json                          Convert to Chrome trace JSON (default)" <<
+    std::endl;
+  std::cout <<
+    "--csv                           Convert to CSV table of events" <<
+    std::endl;
+  std::cout <<
+    "--summary                       Print per-name timing summary" <<
+    std::endl;
+}
+
+static void ConvertToJson(TraceFileReader& reader, std::ostream& out) {
+  trace_format::WriteChromeHeader(
+      out, reader.GetPid(), reader.GetProcessName());
+
+  std::vector<TraceEventRecord> event_list;
+  while (reader.ReadEvents(event_list)) {
+    for (auto& event : event_list) {
+      trace_format::WriteChromeEvent(
+          out, reader.GetPid(), reader.GetTrack(event.track_id).value,
+          reader.GetName(event.name_id), event.start, event.end);
+    }
+  }
+}
+
+static void ConvertToCsv(TraceFileReader& reader, std::ostream& out) {
+  out << "Name,Type,Tid,Start (ns),End (ns),Duration (ns)" << std::endl;
+
+  std::vector<TraceEventRecord> event_list;
+  while (reader.ReadEvents(event_list)) {
+    for (auto& event : event_list) {
+      const TraceTrack& track = reader.GetTrack(event.track_id);
+      out << reader.GetName(event.name_id) << "," <<
+        (track.type == TRACE_TRACK_QUEUE ? "device" : "host") << "," <<
+        track.value << "," <<
+        event.start << "," <<
+        event.end << "," <<
+        event.end - event.start << "\n";
+    }
+  }
+}
+
+static void PrintSummaryTable(
+    TraceFileReader& reader, const SummaryInfoMap& info_map,
+    uint32_t track_type, const char* title, std::ostream& out) {
+  std::vector<std::pair<uint32_t, SummaryInfo> > sorted_list;
+  uint64_t total_duration = 0;
+  size_t max_name_length = kNameLength;
+  for (auto& value : info_map) {
+    if (value.first.first != track_type) {
+      continue;
+    }
+    sorted_list.push_back(std::make_pair(value.first.second, value.second));
+    total_duration += value.second.total_time;
+    max_name_length = std::max(
+        max_name_length, reader.GetName(value.first.second).size());
+  }
+
+  if (total_duration == 0) {
+    return;
+  }
+
+  std::sort(sorted_list.begin(), sorted_list.end(),
+            [](const std::pair<uint32_t, SummaryInfo>& left,
+               const std::pair<uint32_t, SummaryInfo>& right) {
+              return left.second.total_time > right.second.total_time;
+            });
+
+  out << std::endl;
+  out << "== " << title << ": ==" << std::endl;
+  out << std::endl;
+
+  out << std::setw(max_name_length) << "Name" << "," <<
+    std::setw(kCallsLength) << "Calls" << "," <<
+    std::setw(kTimeLength) << "Time (ns)" << "," <<
+    std::setw(kPercentLength) << "Time (%)" << "," <<
+    std::setw(kTimeLength) << "Average (ns)" << "," <<
+    std::setw(kTimeLength) << "Min (ns)" << "," <<
+    std::setw(kTimeLength) << "Max (ns)" << std::endl;
+
+  for (auto& value : sorted_list) {
+    const SummaryInfo& info = value.second;
+    float percent_duration = 100.0f * info.total_time / total_duration;
+    out << std::setw(max_name_length) << reader.GetName(value.first) << "," <<
+      std::setw(kCallsLength) << info.call_count << "," <<
+      std::setw(kTimeLength) << info.total_time << "," <<
+      std::setw(kPercentLength) << std::setprecision(2) <<
+        std::fixed << percent_duration << "," <<
+      std::setw(kTimeLength) << info.total_time / info.call_count << "," <<
+      std::setw(kTimeLength) << info.min_time << "," <<
+      std::setw(kTimeLength) << info.max_time << std::endl;
+  }
+}
+
+static void ConvertToSummary(TraceFileReader& reader, std::ostream& out) {
+  SummaryInfoMap info_map;
+
+  std::vector<TraceEventRecord> event_list;
+  while (reader.ReadEvents(event_list)) {
+    for (auto& event : event_list) {
+      uint32_t track_type = reader.GetTrack(event.track_id).type;
+      uint64_t time = event.end - event.start;
+      auto result = info_map.emplace(
+          std::make_pair(track_type, event.name_id),
+          SummaryInfo{time, time, time, 1});
+      if (!result.second) {
+        SummaryInfo& info = result.first->second;
+        info.total_time += time;
+        info.min_time = std::min(info.min_time, time);
+        info.max_time = std::max(info.max_time, time);
+        info.call_count += 1;
+      }
+    }
+  }
+
+  out << "=== Trace Summary (" << reader.GetProcessName() <<
+    ", pid " << reader.GetPid() << "): ===" << std::endl;
+  PrintSummaryTable(reader, info_map, TRACE_TRACK_THREAD, "Host API", out);
+  PrintSummaryTable(reader, info_map, TRACE_TRACK_QUEUE, "Device", out);
+  out << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+  enum { MODE_JSON, MODE_CSV, MODE_SUMMARY } mode = MODE_JSON;
+
+  int index = 1;
+  for (; index < argc; ++index) {
+    if (strcmp(argv[index], "--json") == 0) {
+      mode = MODE_JSON;
+    } else if (strcmp(argv[index], "--csv") == 0) {
+      mode = MODE_CSV;
+    } else if (strcmp(argv[index], "--summary") == 0) {
+      mode = MODE_SUMMARY;
+    } else {
+      break;
+    }
+  }
+
+  if (index >= argc || argc - index > 2) {
+    Usage();
+    return 1;
+  }
+
+  TraceFileReader reader(argv[index]);
+  if (!reader.IsValid()) {
+    std::cerr << "[ERROR] Unable to read trace file " << argv[index] <<
+      std::endl;
+    return 1;
+  }
+
+  std::ofstream file;
+  if (index + 1 < argc) {
+    file.open(argv[index + 1]);
+    if (!file.is_open()) {
+      std::cerr << "[ERROR] Unable to open output file " <<
+        argv[index + 1] << std::endl;
+      return 1;
+    }
+  }
+  std::ostream& out = file.is_open() ? file : std::cout;
+
+  switch (mode) {
+    case MODE_JSON:
+      ConvertToJson(reader, out);
+      break;
+    case MODE_CSV:
+      ConvertToCsv(reader, out);
+      break;
+    case MODE_SUMMARY:
+      ConvertToSummary(reader, out);
+      break;
+  }
+
+  return 0;
+}
\ No newline at end of file
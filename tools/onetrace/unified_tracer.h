@@ -9,7 +9,6 @@
 
 #include <chrono>
 #include <cstdint>
-#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
@@ -17,6 +16,7 @@
 
 #include "cl_api_collector.h"
 #include "cl_kernel_collector.h"
+#include "trace_writer.h"
 #include "utils.h"
 #include "ze_api_collector.h"
 #include "ze_kernel_collector.h"
@@ -27,12 +27,15 @@
 #define ONETRACE_DEVICE_TIMELINE        3
 #define ONETRACE_CHROME_DEVICE_TIMELINE 4
 #define ONETRACE_CHROME_CALL_LOGGING    5
+#define ONETRACE_BINARY_TRACE           6
 
 const char* kChromeTraceFileName = "onetrace.json";
+const char* kBinaryTraceFileName = "onetrace.bin";
 
 class UnifiedTracer {
  public:
-  static UnifiedTracer* Create(unsigned options) {
+  static UnifiedTracer* Create(
+      unsigned options, const std::string& ze_api_filter = std::string()) {
     cl_device_id cl_cpu_device = utils::cl::GetIntelDevice(CL_DEVICE_TYPE_CPU);
     cl_device_id cl_gpu_device = utils::cl::GetIntelDevice(CL_DEVICE_TYPE_GPU);
     if (cl_cpu_device == nullptr && cl_gpu_device == nullptr) {
@@ -60,7 +63,8 @@ class UnifiedTracer {
       bool call_tracing = tracer->CheckOption(ONETRACE_CALL_LOGGING);
 
       ze_api_collector = ZeApiCollector::Create(
-          tracer->start_time_, call_tracing, ze_callback, tracer);
+          tracer->start_time_, call_tracing, ze_callback, tracer,
+          ze_api_filter);
       if (ze_api_collector == nullptr) {
         std::cerr << "[WARNING] Unable to create L0 API collector" <<
           std::endl;
@@ -180,6 +184,9 @@ class UnifiedTracer {
       ze_api_collector_->DisableTracing();
     }
 
+    if (ze_kernel_collector_ != nullptr) {
+      ze_kernel_collector_->DisableTracing();
+    }
     if (cl_cpu_kernel_collector_ != nullptr) {
       cl_cpu_kernel_collector_->DisableTracing();
     }
@@ -199,6 +206,9 @@ class UnifiedTracer {
       delete ze_api_collector_;
     }
 
+    if (ze_kernel_collector_ != nullptr) {
+      delete ze_kernel_collector_;
+    }
     if (cl_cpu_kernel_collector_ != nullptr) {
       delete cl_cpu_kernel_collector_;
     }
@@ -206,7 +216,7 @@ class UnifiedTracer {
       delete cl_gpu_kernel_collector_;
     }
 
-    if (chrome_trace_.is_open()) {
+    if (chrome_trace_ != nullptr) {
       CloseTraceFile();
     }
   }
@@ -437,9 +447,10 @@ class UnifiedTracer {
   }
 
   static void DeviceTimelineCallback(
-      void* data, void* queue, const std::string& name,
+      void* data, void* queue, uint32_t name_id,
       uint64_t queued, uint64_t submitted,
       uint64_t started, uint64_t ended) {
+    const std::string& name = utils::GetInternedString(name_id);
     std::stringstream stream;
     stream << "Device Timeline (queue: " << queue <<
       "): " << name << " [ns] = " <<
@@ -450,46 +461,49 @@ class UnifiedTracer {
     std::cerr << stream.str();
   }
 
+  const char* GetTraceFileName() {
+    return CheckOption(ONETRACE_BINARY_TRACE) ?
+      kBinaryTraceFileName : kChromeTraceFileName;
+  }
+
   void OpenTraceFile() {
-    chrome_trace_.open(kChromeTraceFileName);
-    PTI_ASSERT(chrome_trace_.is_open());
-    chrome_trace_ << "[" << std::endl;
-    chrome_trace_ <<
-      "{\"ph\":\"M\", \"name\":\"process_name\", \"pid\":" <<
-      utils::GetPid() << ", \"tid\":0, \"args\":{\"name\":\"" <<
-      utils::GetExecutableName() << "\"}}," << std::endl;
+    chrome_trace_ = new TraceWriter(
+        GetTraceFileName(),
+        CheckOption(ONETRACE_BINARY_TRACE) ?
+          TRACE_FORMAT_BINARY : TRACE_FORMAT_JSON);
+    PTI_ASSERT(chrome_trace_ != nullptr);
   }
 
   void CloseTraceFile() {
-    PTI_ASSERT(chrome_trace_.is_open());
-    chrome_trace_.close();
+    PTI_ASSERT(chrome_trace_ != nullptr);
+    uint64_t dropped_count = chrome_trace_->GetDroppedCount();
+    delete chrome_trace_;
+    chrome_trace_ = nullptr;
+
+    if (dropped_count > 0) {
+      std::cerr << "[WARNING] " << dropped_count <<
+        " timeline records were dropped" << std::endl;
+    }
     std::cerr << "Timeline was stored to " <<
-      kChromeTraceFileName << std::endl;
+      GetTraceFileName() << std::endl;
   }
 
   static void ChromeTimelineCallback(
-      void* data, void* queue, const std::string& name,
+      void* data, void* queue, uint32_t name_id,
       uint64_t queued, uint64_t submitted,
       uint64_t started, uint64_t ended) {
     UnifiedTracer* tracer = reinterpret_cast<UnifiedTracer*>(data);
     PTI_ASSERT(tracer != nullptr);
-
-    std::stringstream stream;
-    stream << "{\"ph\":\"X\", \"pid\":" << utils::GetPid() <<
-      ", \"tid\":" << reinterpret_cast<uint64_t>(queue) <<
-      ", \"name\":\"" << name <<
-      "\", \"ts\": " << started / NSEC_IN_USEC <<
-      ", \"dur\":" << (ended - started) / NSEC_IN_USEC <<
-      "}," << std::endl;
-    tracer->chrome_trace_ << stream.str();
+    PTI_ASSERT(tracer->chrome_trace_ != nullptr);
+    tracer->chrome_trace_->AddDeviceRecord(name_id, queue, started, ended);
   }
 
   static void DeviceAndChromeTimelineCallback(
-      void* data, void* queue, const std::string& name,
+      void* data, void* queue, uint32_t name_id,
       uint64_t queued, uint64_t submitted,
       uint64_t started, uint64_t ended) {
-    DeviceTimelineCallback(data, queue, name, queued, submitted, started, ended);
-    ChromeTimelineCallback(data, queue, name, queued, submitted, started, ended);
+    DeviceTimelineCallback(data, queue, name_id, queued, submitted, started, ended);
+    ChromeTimelineCallback(data, queue, name_id, queued, submitted, started, ended);
   }
 
   static void ChromeLoggingCallback(
@@ -497,15 +511,8 @@ class UnifiedTracer {
       uint64_t started, uint64_t ended) {
     UnifiedTracer* tracer = reinterpret_cast<UnifiedTracer*>(data);
     PTI_ASSERT(tracer != nullptr);
-
-    std::stringstream stream;
-    stream << "{\"ph\":\"X\", \"pid\":" <<
-      utils::GetPid() << ", \"tid\":" << utils::GetTid() <<
-      ", \"name\":\"" << name <<
-      "\", \"ts\": " << started / NSEC_IN_USEC <<
-      ", \"dur\":" << (ended - started) / NSEC_IN_USEC <<
-      "}," << std::endl;
-    tracer->chrome_trace_ << stream.str();
+    PTI_ASSERT(tracer->chrome_trace_ != nullptr);
+    tracer->chrome_trace_->AddHostRecord(name, started, ended);
   }
 
  private:
@@ -522,7 +529,7 @@ class UnifiedTracer {
   ClKernelCollector* cl_cpu_kernel_collector_ = nullptr;
   ClKernelCollector* cl_gpu_kernel_collector_ = nullptr;
 
-  std::ofstream chrome_trace_;
+  TraceWriter* chrome_trace_ = nullptr;
 };
 
 #endif // PTI_SAMPLES_ONETRACE_UNIFIED_TRACER_H_
\ No newline at end of file